@@ -24,14 +24,35 @@ import PackageDescription
 let package = Package(
   name: "core-cloud-wasm",
   dependencies: [
+    .package(url: "https://github.com/apple/swift-crypto", exact: "4.1.0"),
     .package(url: "https://github.com/apple/swift-numerics", exact: "1.1.1")
   ],
   targets: [
-    .target(name: "CoreCloudWasm"),
+    .target(
+      name: "CoreCloudWasm",
+      linkerSettings: [
+        .linkedLibrary("pthread", .when(platforms: [.linux]))
+      ]
+    ),
+    .executableTarget(
+      name: "CoreCloudWasmBenchmarks",
+      dependencies: [
+        .target(name: "CoreCloudWasm")
+      ]
+    ),
+    .target(
+      name: "CoreCloudWasmTestSupport",
+      dependencies: [
+        .target(name: "CoreCloudWasm")
+      ],
+      path: "Tests/CoreCloudWasmTestSupport"
+    ),
     .testTarget(
       name: "CoreCloudWasmTests",
       dependencies: [
         .target(name: "CoreCloudWasm"),
+        .target(name: "CoreCloudWasmTestSupport"),
+        .product(name: "Crypto", package: "swift-crypto"),
         .product(name: "Numerics", package: "swift-numerics")
       ]
     )
@@ -0,0 +1,476 @@
+//
+//  AudioAnalysis.c
+//  core-cloud-wasm
+//
+//  Created by Fang Ling on 2026/10/17.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#include "AudioAnalysis.h"
+#include "DSPVector.h"
+
+#include <math.h>
+#include <stdlib.h>
+
+/*
+ * The input is cut into segments that never straddle a 100 ms step or a
+ * waveform bucket, and each segment goes through every stage:
+ *
+ *   1. deinterleave into one planar buffer per channel, after the last
+ *      `AudioAnalysisTapCount - 1` samples of the previous segment
+ *   2. K-weight, frame by frame with the channels side by side, and add up
+ *      the squares of the current step
+ *   3. interpolate 4 phases between samples, `VLANES` samples at a time, and
+ *      keep the largest magnitudes
+ *   4. keep the smallest and largest samples of the current bucket
+ */
+
+/* The largest number of frames in a segment */
+#define AudioAnalysisSegmentCount 512
+/* The taps of each phase of the true-peak interpolator */
+#define AudioAnalysisTapCount 12
+#define AudioAnalysisPhaseCount 4
+/* Block loudness bins of 0.1 LU between -70 and +5 LUFS */
+#define AudioAnalysisBinCount 750
+#define AudioAnalysisAbsoluteGate -70.0
+#define AudioAnalysisRelativeGate -10.0
+#define AudioAnalysisReplayGainReference -18.0
+
+struct AudioAnalysis {
+  Int32 channelCount;
+
+  /* 2. K-weighting: a shelf then a high-pass, b0 b1 b2 a1 a2 each */
+  double coefficients[2][5];
+  double state[2][2][AudioAnalysisMaximumChannelCount];
+  double weights[AudioAnalysisMaximumChannelCount];
+
+  /* The current 100 ms step, and the weighted energies of the last four */
+  Int32 stepCount;
+  Int32 stepRemaining;
+  double sums[AudioAnalysisMaximumChannelCount];
+  double steps[4];
+  Int64 stepTotal;
+
+  /* The gating blocks louder than the absolute gate */
+  Int64 counts[AudioAnalysisBinCount];
+  double energies[AudioAnalysisBinCount];
+
+  /* 3. Peaks */
+  Float32 planar[AudioAnalysisMaximumChannelCount][
+    AudioAnalysisTapCount - 1 + AudioAnalysisSegmentCount
+  ];
+  Float32 samplePeak;
+  Float32 truePeak;
+
+  /* 4. Waveform: `count` pairs of minimum and maximum, then the open one */
+  Float32* buckets;
+  Int32 capacity;
+  Int32 count;
+  Int64 bucketFrames;
+  Int64 filled;
+  Float32 minimum;
+  Float32 maximum;
+};
+
+/*
+ * The 48-tap interpolator of ITU-R BS.1770-4, annex 2, one row per phase.
+ * The last two phases mirror the first two.
+ */
+static const Float32 AudioAnalysisInterpolator[4][12] = {
+  {
+     0.0017089843750,  0.0109863281250, -0.0196533203125,  0.0332031250000,
+    -0.0594482421875,  0.1373291015625,  0.9721679687500, -0.1022949218750,
+     0.0476074218750, -0.0266113281250,  0.0148925781250, -0.0083007812500
+  },
+  {
+    -0.0291748046875,  0.0292968750000, -0.0517578125000,  0.0891113281250,
+    -0.1665039062500,  0.4650878906250,  0.7797851562500, -0.2003173828125,
+     0.1015625000000, -0.0582275390625,  0.0330810546875, -0.0189208984375
+  },
+  {
+    -0.0189208984375,  0.0330810546875, -0.0582275390625,  0.1015625000000,
+    -0.2003173828125,  0.7797851562500,  0.4650878906250, -0.1665039062500,
+     0.0891113281250, -0.0517578125000,  0.0292968750000, -0.0291748046875
+  },
+  {
+    -0.0083007812500,  0.0148925781250, -0.0266113281250,  0.0476074218750,
+    -0.1022949218750,  0.9721679687500,  0.1373291015625, -0.0594482421875,
+     0.0332031250000, -0.0196533203125,  0.0109863281250,  0.0017089843750
+  }
+};
+
+/* MARK: - Loudness */
+/* Converts a mean square to LUFS. */
+static inline double AudioAnalysisLoudness(double energy) {
+  return -0.691 + 10 * log10(energy);
+}
+
+/* Closes the current step, and the gating block it completes. */
+static void AudioAnalysisFinishStep(struct AudioAnalysis* analysis) {
+  double energy = 0;
+  for (Int32 c = 0; c < analysis->channelCount; c += 1) {
+    energy += analysis->weights[c] * analysis->sums[c];
+    analysis->sums[c] = 0;
+  }
+  analysis->steps[analysis->stepTotal % 4] = energy;
+  analysis->stepTotal += 1;
+  analysis->stepRemaining = analysis->stepCount;
+
+  if (analysis->stepTotal < 4) {
+    return;
+  }
+  energy = analysis->steps[0] + analysis->steps[1] +
+    analysis->steps[2] + analysis->steps[3];
+  energy /= 4.0 * analysis->stepCount;
+
+  double loudness = AudioAnalysisLoudness(energy);
+  if (!(loudness > AudioAnalysisAbsoluteGate)) {
+    return;
+  }
+  Int32 bin = (Int32)((loudness - AudioAnalysisAbsoluteGate) * 10);
+  if (bin >= AudioAnalysisBinCount) {
+    bin = AudioAnalysisBinCount - 1;
+  }
+  analysis->counts[bin] += 1;
+  analysis->energies[bin] += energy;
+}
+
+/* K-weights the segment and adds up its squares. */
+static void AudioAnalysisWeight(struct AudioAnalysis* analysis, Int32 count) {
+  const Int32 channelCount = analysis->channelCount;
+  const double* shelf = analysis->coefficients[0];
+  const double* pass = analysis->coefficients[1];
+  double (*s)[AudioAnalysisMaximumChannelCount] = analysis->state[0];
+  double (*t)[AudioAnalysisMaximumChannelCount] = analysis->state[1];
+
+  for (Int32 i = 0; i < count; i += 1) {
+    for (Int32 c = 0; c < channelCount; c += 1) {
+      double x = analysis->planar[c][AudioAnalysisTapCount - 1 + i];
+      double y = shelf[0] * x + s[0][c];
+      s[0][c] = shelf[1] * x - shelf[3] * y + s[1][c];
+      s[1][c] = shelf[2] * x - shelf[4] * y;
+      x = y;
+      y = pass[0] * x + t[0][c];
+      t[0][c] = pass[1] * x - pass[3] * y + t[1][c];
+      t[1][c] = pass[2] * x - pass[4] * y;
+      analysis->sums[c] += y * y;
+    }
+  }
+}
+
+/* MARK: - Peaks */
+/* Updates the sample and true peaks with the segment of one channel. */
+static void AudioAnalysisPeak(struct AudioAnalysis* analysis,
+                              const Float32* x,
+                              Int32 count) {
+  const Int32 past = AudioAnalysisTapCount - 1;
+  Vector zero = VSPLAT(0);
+  Vector samplePeak = zero;
+  Vector truePeak = zero;
+  Int32 i = 0;
+
+  /* 1. `VLANES` samples at a time */
+  for (; i + VLANES <= count; i += VLANES) {
+    Vector sample = VLOAD(x + past + i);
+    samplePeak = VMAX(samplePeak, VMAX(sample, VSUB(zero, sample)));
+    for (Int32 p = 0; p < AudioAnalysisPhaseCount; p += 1) {
+      const Float32* h = AudioAnalysisInterpolator[p];
+      Vector y = VMUL(VSPLAT(h[0]), VLOAD(x + past + i));
+      for (Int32 t = 1; t < AudioAnalysisTapCount; t += 1) {
+        y = VMADD(VSPLAT(h[t]), VLOAD(x + past + i - t), y);
+      }
+      truePeak = VMAX(truePeak, VMAX(y, VSUB(zero, y)));
+    }
+  }
+
+  Float32 lanes[2][VLANES];
+  VSTORE(lanes[0], samplePeak);
+  VSTORE(lanes[1], truePeak);
+  for (Int32 lane = 0; lane < VLANES; lane += 1) {
+    analysis->samplePeak = fmaxf(analysis->samplePeak, lanes[0][lane]);
+    analysis->truePeak = fmaxf(analysis->truePeak, lanes[1][lane]);
+  }
+
+  /* 2. The rest, one at a time */
+  for (; i < count; i += 1) {
+    analysis->samplePeak = fmaxf(analysis->samplePeak, fabsf(x[past + i]));
+    for (Int32 p = 0; p < AudioAnalysisPhaseCount; p += 1) {
+      const Float32* h = AudioAnalysisInterpolator[p];
+      Float32 y = 0;
+      for (Int32 t = 0; t < AudioAnalysisTapCount; t += 1) {
+        y += h[t] * x[past + i - t];
+      }
+      analysis->truePeak = fmaxf(analysis->truePeak, fabsf(y));
+    }
+  }
+}
+
+/* Widens the open bucket to the segment of one channel. */
+static void AudioAnalysisExtend(struct AudioAnalysis* analysis,
+                                const Float32* x,
+                                Int32 count) {
+  Int32 i = 0;
+
+  if (count >= VLANES) {
+    Vector minimum = VLOAD(x);
+    Vector maximum = minimum;
+    for (i = VLANES; i + VLANES <= count; i += VLANES) {
+      Vector sample = VLOAD(x + i);
+      minimum = VMIN(minimum, sample);
+      maximum = VMAX(maximum, sample);
+    }
+
+    Float32 lanes[2][VLANES];
+    VSTORE(lanes[0], minimum);
+    VSTORE(lanes[1], maximum);
+    for (Int32 lane = 0; lane < VLANES; lane += 1) {
+      analysis->minimum = fminf(analysis->minimum, lanes[0][lane]);
+      analysis->maximum = fmaxf(analysis->maximum, lanes[1][lane]);
+    }
+  }
+
+  for (; i < count; i += 1) {
+    analysis->minimum = fminf(analysis->minimum, x[i]);
+    analysis->maximum = fmaxf(analysis->maximum, x[i]);
+  }
+}
+
+/* Closes the open bucket, halving the resolution when the buckets run out. */
+static void AudioAnalysisFinishBucket(struct AudioAnalysis* analysis) {
+  Float32* buckets = analysis->buckets;
+
+  buckets[analysis->count * 2] = analysis->minimum;
+  buckets[analysis->count * 2 + 1] = analysis->maximum;
+  analysis->count += 1;
+  analysis->filled = 0;
+  analysis->minimum = INFINITY;
+  analysis->maximum = -INFINITY;
+
+  if (analysis->count == analysis->capacity) {
+    for (Int32 i = 0; i < analysis->capacity / 2; i += 1) {
+      buckets[i * 2] = fminf(buckets[i * 4], buckets[i * 4 + 2]);
+      buckets[i * 2 + 1] = fmaxf(buckets[i * 4 + 1], buckets[i * 4 + 3]);
+    }
+    analysis->count = analysis->capacity / 2;
+    analysis->bucketFrames *= 2;
+  }
+}
+
+/* MARK: - Analysis */
+struct AudioAnalysis* AudioAnalysisCreate(Int32 sampleRate,
+                                          Int32 channelCount,
+                                          Int32 bucketCount) {
+  if (sampleRate < AudioAnalysisMinimumSampleRate ||
+      sampleRate > AudioAnalysisMaximumSampleRate ||
+      channelCount < 1 ||
+      channelCount > AudioAnalysisMaximumChannelCount ||
+      bucketCount < 2 ||
+      bucketCount % 2 != 0) {
+    return NULL;
+  }
+
+  struct AudioAnalysis* analysis = malloc(sizeof(*analysis));
+  if (analysis == NULL) {
+    return NULL;
+  }
+  memset(analysis, 0, sizeof(*analysis));
+  analysis->buckets = malloc(bucketCount * 2 * sizeof(Float32));
+  if (analysis->buckets == NULL) {
+    AudioAnalysisDestroy(analysis);
+    return NULL;
+  }
+  analysis->channelCount = channelCount;
+  analysis->capacity = bucketCount;
+  analysis->bucketFrames = 1;
+  analysis->minimum = INFINITY;
+  analysis->maximum = -INFINITY;
+  analysis->stepCount = (sampleRate + 5) / 10;
+  analysis->stepRemaining = analysis->stepCount;
+
+  /* 1. The K-weighting filters of BS.1770-4, at any rate */
+  double k = tan(M_PI * 1681.974450955533 / sampleRate);
+  double q = 0.7071752369554196;
+  double high = pow(10, 3.999843853973347 / 20);
+  double band = pow(high, 0.4996667741545416);
+  double norm = 1 / (1 + k / q + k * k);
+  double* c = analysis->coefficients[0];
+  c[0] = (high + band * k / q + k * k) * norm;
+  c[1] = 2 * (k * k - high) * norm;
+  c[2] = (high - band * k / q + k * k) * norm;
+  c[3] = 2 * (k * k - 1) * norm;
+  c[4] = (1 - k / q + k * k) * norm;
+
+  k = tan(M_PI * 38.13547087602444 / sampleRate);
+  q = 0.5003270373238773;
+  norm = 1 / (1 + k / q + k * k);
+  c = analysis->coefficients[1];
+  c[0] = 1;
+  c[1] = -2;
+  c[2] = 1;
+  c[3] = 2 * (k * k - 1) * norm;
+  c[4] = (1 - k / q + k * k) * norm;
+
+  /* 2. Channel weights: surround channels +1.5 dB, LFE not counted */
+  for (Int32 i = 0; i < channelCount; i += 1) {
+    analysis->weights[i] = 1;
+  }
+  if (channelCount == 5) {
+    analysis->weights[3] = 1.41;
+    analysis->weights[4] = 1.41;
+  } else if (channelCount == 6) {
+    analysis->weights[3] = 0;
+    analysis->weights[4] = 1.41;
+    analysis->weights[5] = 1.41;
+  }
+
+  return analysis;
+}
+
+void AudioAnalysisUpdate(struct AudioAnalysis* analysis,
+                         const Float32* samples,
+                         Int64 count) {
+  const Int32 channelCount = analysis->channelCount;
+  const Int32 past = AudioAnalysisTapCount - 1;
+
+  while (count > 0) {
+    /* 1. The longest segment within the step and the bucket */
+    Int64 n = count < AudioAnalysisSegmentCount
+      ? count
+      : AudioAnalysisSegmentCount;
+    if (n > analysis->stepRemaining) {
+      n = analysis->stepRemaining;
+    }
+    if (n > analysis->bucketFrames - analysis->filled) {
+      n = analysis->bucketFrames - analysis->filled;
+    }
+    Int32 segment = (Int32)n;
+
+    for (Int32 c = 0; c < channelCount; c += 1) {
+      Float32* x = analysis->planar[c] + past;
+      for (Int32 i = 0; i < segment; i += 1) {
+        x[i] = samples[i * channelCount + c];
+      }
+    }
+
+    /* 2. Loudness */
+    AudioAnalysisWeight(analysis, segment);
+    analysis->stepRemaining -= segment;
+    if (analysis->stepRemaining == 0) {
+      AudioAnalysisFinishStep(analysis);
+    }
+
+    /* 3. Peaks, 4. waveform */
+    for (Int32 c = 0; c < channelCount; c += 1) {
+      Float32* x = analysis->planar[c];
+      AudioAnalysisPeak(analysis, x, segment);
+      AudioAnalysisExtend(analysis, x + past, segment);
+      memmove(x, x + segment, past * sizeof(Float32));
+    }
+    analysis->filled += segment;
+    if (analysis->filled == analysis->bucketFrames) {
+      AudioAnalysisFinishBucket(analysis);
+    }
+
+    samples += n * channelCount;
+    count -= n;
+  }
+}
+
+void AudioAnalysisGetLoudness(const struct AudioAnalysis* analysis,
+                              struct AudioLoudness* loudness) {
+  /* 1. The relative gate, from the blocks above the absolute gate */
+  Int64 count = 0;
+  double energy = 0;
+  for (Int32 bin = 0; bin < AudioAnalysisBinCount; bin += 1) {
+    count += analysis->counts[bin];
+    energy += analysis->energies[bin];
+  }
+
+  loudness->integratedLoudness = -INFINITY;
+  loudness->replayGain = 0;
+  if (count > 0) {
+    double gate = AudioAnalysisLoudness(energy / count) +
+      AudioAnalysisRelativeGate;
+
+    /* 2. The blocks above both gates, bin by bin */
+    count = 0;
+    energy = 0;
+    for (Int32 bin = 0; bin < AudioAnalysisBinCount; bin += 1) {
+      if (AudioAnalysisAbsoluteGate + (bin + 0.5) / 10 > gate) {
+        count += analysis->counts[bin];
+        energy += analysis->energies[bin];
+      }
+    }
+    if (count > 0) {
+      double integrated = AudioAnalysisLoudness(energy / count);
+      loudness->integratedLoudness = (Float32)integrated;
+      loudness->replayGain = (Float32)(
+        AudioAnalysisReplayGainReference - integrated
+      );
+    }
+  }
+
+  loudness->samplePeak = analysis->samplePeak;
+  loudness->truePeak = analysis->truePeak;
+}
+
+Int32 AudioAnalysisGetPeaks(const struct AudioAnalysis* analysis,
+                            Int32 level,
+                            Int8* peaks,
+                            Int64* frameCount) {
+  if (level < 0) {
+    if (frameCount != NULL) {
+      *frameCount = 0;
+    }
+    return 0;
+  }
+
+  Int32 count = analysis->count + (analysis->filled > 0 ? 1 : 0);
+  Int32 width = level < 30 ? 1 << level : 1 << 30;
+  Int32 output = 0;
+
+  for (Int32 start = 0; start < count; start += width) {
+    Float32 minimum = INFINITY;
+    Float32 maximum = -INFINITY;
+    for (Int32 i = start; i < start + width && i < count; i += 1) {
+      Bool open = i == analysis->count;
+      minimum = fminf(
+        minimum,
+        open ? analysis->minimum : analysis->buckets[i * 2]
+      );
+      maximum = fmaxf(
+        maximum,
+        open ? analysis->maximum : analysis->buckets[i * 2 + 1]
+      );
+    }
+    minimum = fminf(fmaxf(minimum * 127, -127), 127);
+    maximum = fminf(fmaxf(maximum * 127, -127), 127);
+    peaks[output * 2] = (Int8)lrintf(minimum);
+    peaks[output * 2 + 1] = (Int8)lrintf(maximum);
+    output += 1;
+  }
+
+  if (frameCount != NULL) {
+    *frameCount = analysis->bucketFrames * width;
+  }
+  return output;
+}
+
+void AudioAnalysisDestroy(struct AudioAnalysis* analysis) {
+  if (analysis == NULL) {
+    return;
+  }
+  free(analysis->buckets);
+  free(analysis);
+}
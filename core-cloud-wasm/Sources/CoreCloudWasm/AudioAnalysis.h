@@ -0,0 +1,165 @@
+//
+//  AudioAnalysis.h
+//  core-cloud-wasm
+//
+//  Created by Fang Ling on 2026/10/17.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#ifndef AudioAnalysis_h
+#define AudioAnalysis_h
+
+#include "Base.h"
+
+/**
+ * The smallest sample rate an audio analysis accepts, in hertz.
+ */
+#define AudioAnalysisMinimumSampleRate 8000
+
+/**
+ * The largest sample rate an audio analysis accepts, in hertz.
+ */
+#define AudioAnalysisMaximumSampleRate 384000
+
+/**
+ * The largest number of interleaved channels an audio analysis accepts.
+ */
+#define AudioAnalysisMaximumChannelCount 8
+
+/**
+ * The loudness and peaks of a recording.
+ */
+struct AudioLoudness {
+  /**
+   * The gated integrated loudness of ITU-R BS.1770-4 and EBU R 128, in LUFS,
+   * or `-INFINITY` if no 400 ms block is louder than -70 LUFS.
+   */
+  Float32 integratedLoudness;
+  /**
+   * The ReplayGain 2.0 track gain, in dB: the change that brings the
+   * integrated loudness to -18 LUFS, or 0 for silence.
+   */
+  Float32 replayGain;
+  /**
+   * The largest absolute sample value.
+   */
+  Float32 samplePeak;
+  /**
+   * The largest absolute value of the signal oversampled 4 times, as
+   * specified by ITU-R BS.1770-4, annex 2. Take `20 * log10(truePeak)` for
+   * dBTP.
+   */
+  Float32 truePeak;
+};
+
+/**
+ * A streaming analysis of the loudness and waveform of a recording.
+ *
+ * Every channel is K-weighted by two biquads, and the mean squares of 100 ms
+ * steps are combined into the overlapping 400 ms gating blocks of
+ * BS.1770-4. The block loudnesses are kept in a histogram of 0.1 LU bins with
+ * their exact energies, so that gating needs no memory that grows with the
+ * length of the recording. Channels are weighted as BS.1770-4 specifies for
+ * 5-channel (L, R, C, Ls, Rs) and 6-channel (L, R, C, LFE, Ls, Rs) audio, and
+ * equally otherwise.
+ *
+ * Meanwhile, the waveform is reduced to at most `bucketCount` buckets of the
+ * smallest and largest sample values of all channels. A bucket covers a
+ * power of two of frames, which doubles whenever the buckets run out, so any
+ * recording fits while long ones keep a resolution of at least
+ * `bucketCount / 2` buckets.
+ *
+ * Do not use the same audio analysis from more than one thread at a time.
+ */
+struct AudioAnalysis;
+
+/**
+ * Creates an audio analysis.
+ *
+ * - Parameters:
+ *   - sampleRate: The sample rate of the audio, between
+ *                 ``AudioAnalysisMinimumSampleRate`` and
+ *                 ``AudioAnalysisMaximumSampleRate`` hertz.
+ *   - channelCount: The number of interleaved channels, between 1 and
+ *                   ``AudioAnalysisMaximumChannelCount``.
+ *   - bucketCount: The largest number of waveform buckets, an even number of
+ *                  at least 2, such as the width of the widest waveform view.
+ *
+ * - Returns: A new audio analysis, or `NULL` if a parameter is out of range
+ *   or the memory could not be allocated. Release it with
+ *   ``AudioAnalysisDestroy()``.
+ */
+struct AudioAnalysis* AudioAnalysisCreate(Int32 sampleRate,
+                                          Int32 channelCount,
+                                          Int32 bucketCount);
+
+/**
+ * Incrementally analyzes the next chunk of audio.
+ *
+ * Call this method one or more times to provide the audio in chunks of any
+ * length, such as the buffers of a decoder that reads the file as it is
+ * uploaded and hashed.
+ *
+ * - Parameters:
+ *   - analysis: An audio analysis.
+ *   - samples: The next `count` frames of interleaved samples, nominally
+ *              between -1 and 1.
+ *   - count: The number of frames, each of `channelCount` samples.
+ */
+void AudioAnalysisUpdate(struct AudioAnalysis* analysis,
+                         const Float32* samples,
+                         Int64 count);
+
+/**
+ * Returns the loudness and peaks of the audio analyzed so far.
+ *
+ * - Parameters:
+ *   - analysis: An audio analysis.
+ *   - loudness: On return, the loudness and peaks.
+ */
+void AudioAnalysisGetLoudness(const struct AudioAnalysis* analysis,
+                              struct AudioLoudness* loudness);
+
+/**
+ * Returns a level of the waveform pyramid of the audio analyzed so far.
+ *
+ * Level 0 holds the buckets as analyzed, and every further level merges the
+ * buckets of the previous one in pairs. Each bucket is a pair of bytes, the
+ * smallest then the largest sample value scaled by 127 and clamped to
+ * [-127, 127], which is compact enough to store with the recording.
+ *
+ * - Parameters:
+ *   - analysis: An audio analysis.
+ *   - level: The zoom level, from 0 for the finest; levels above 30 are the
+ *            same as 30.
+ *   - peaks: A buffer of `2 * bucketCount` bytes to store the buckets.
+ *   - frameCount: On return, the number of frames each bucket covers; the
+ *                 last one may cover fewer. May be `NULL`.
+ *
+ * - Returns: The number of buckets stored in `peaks`, or 0 if `level` is
+ *   negative.
+ */
+Int32 AudioAnalysisGetPeaks(const struct AudioAnalysis* analysis,
+                            Int32 level,
+                            Int8* peaks,
+                            Int64* frameCount);
+
+/**
+ * Destroys an audio analysis.
+ *
+ * - Parameter analysis: An audio analysis, or `NULL`.
+ */
+void AudioAnalysisDestroy(struct AudioAnalysis* analysis);
+
+#endif /* AudioAnalysis_h */
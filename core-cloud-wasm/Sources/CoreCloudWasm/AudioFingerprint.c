@@ -0,0 +1,410 @@
+//
+//  AudioFingerprint.c
+//  core-cloud-wasm
+//
+//  Created by Fang Ling on 2026/10/17.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#include "AudioFingerprint.h"
+#include "DSPDCT.h"
+#include "DSPDCTSetup.h"
+
+#include <math.h>
+#include <stdlib.h>
+
+/*
+ * The analysis runs at 11025 / 2 Hz, whatever the input rate:
+ *
+ *   1. mix down, then low-pass below the new Nyquist frequency with a
+ *      fourth-order Butterworth filter
+ *   2. average the samples between two output instants, which are spaced by
+ *      a Bresenham-style integer phase
+ *   3. every `AudioFingerprintHopCount` samples, take the power spectrum of
+ *      the last `AudioFingerprintFrameCount` samples as the sum of the squares
+ *      of their DCT-IV and DST-IV (the MCLT), both from one DCT-IV setup
+ *   4. sum it into bands, then DSPDCT32 the logarithms
+ */
+
+#define AudioFingerprintRate 11025
+#define AudioFingerprintFrameCount 2048
+#define AudioFingerprintHopCount 64
+#define AudioFingerprintBandCount 32
+#define AudioFingerprintLowestFrequency 300.0
+#define AudioFingerprintHighestFrequency 2000.0
+#define AudioFingerprintCutoffFrequency 2300.0
+
+/* The shortest overlap ``AudioFingerprintMatch()`` considers */
+#define AudioFingerprintMinimumOverlap 64
+/* The number of voted alignments that are compared bit by bit */
+#define AudioFingerprintCandidateCount 8
+/* Keys shared by more sub-fingerprints than this do not vote */
+#define AudioFingerprintMaximumBucketCount 64
+
+struct AudioFingerprint {
+  Int32 sampleRate;
+  Int32 channelCount;
+
+  /* 1. Low-pass: two biquads, b0 b1 b2 a1 a2 each, in transposed form II */
+  double coefficients[2][5];
+  double state[2][2];
+
+  /* 2. Decimation */
+  Int64 phase;
+  double sum;
+  Int32 sumCount;
+
+  /* 3. The last `AudioFingerprintFrameCount` samples, oldest at `position` */
+  Float32 history[AudioFingerprintFrameCount];
+  Int32 position;
+  Int32 filled;
+  Int32 pending;
+
+  /* 4. Analysis */
+  struct DSPDCTSetup* setup;
+  Float32 window[AudioFingerprintFrameCount];
+  Float32 cosines[AudioFingerprintFrameCount];
+  Float32 sines[AudioFingerprintFrameCount];
+  Int32 edges[AudioFingerprintBandCount + 1];
+  Float32 previous[AudioFingerprintBandCount];
+  Bool hasPrevious;
+
+  UInt32* subfingerprints;
+  Int32 count;
+  Int32 capacity;
+};
+
+/* MARK: - Analysis */
+/* Derives the next sub-fingerprint from the current window. */
+static void AudioFingerprintAnalyze(struct AudioFingerprint* fingerprint) {
+  const Int32 n = AudioFingerprintFrameCount;
+
+  /* 1. Windowed frame, and its reverse for the DST-IV */
+  for (Int32 j = 0; j < n; j += 1) {
+    Float32 x = fingerprint->history[(fingerprint->position + j) & (n - 1)];
+    x *= fingerprint->window[j];
+    fingerprint->cosines[j] = x;
+    fingerprint->sines[n - 1 - j] = x;
+  }
+
+  /* 2. DST-IV[k] = (-1)^k DCT-IV of the reverse, the sign squares away */
+  DSPDCTExecute(fingerprint->setup, fingerprint->cosines, fingerprint->cosines);
+  DSPDCTExecute(fingerprint->setup, fingerprint->sines, fingerprint->sines);
+
+  /* 3. Band energies */
+  Float32 energies[AudioFingerprintBandCount];
+  for (Int32 b = 0; b < AudioFingerprintBandCount; b += 1) {
+    Float32 energy = 0;
+    Int32 end = fingerprint->edges[b + 1];
+    for (Int32 k = fingerprint->edges[b]; k < end; k += 1) {
+      Float32 c = fingerprint->cosines[k];
+      Float32 s = fingerprint->sines[k];
+      energy += c * c + s * s;
+    }
+    energies[b] = logf(energy + 1e-10f);
+  }
+
+  /* 4. Compaction, and one bit per rising coefficient */
+  Float32 coefficients[AudioFingerprintBandCount];
+  DSPDCT32Execute(energies, coefficients);
+
+  if (fingerprint->hasPrevious) {
+    UInt32 subfingerprint = 0;
+    for (Int32 k = 0; k < AudioFingerprintBandCount; k += 1) {
+      if (coefficients[k] > fingerprint->previous[k]) {
+        subfingerprint |= (UInt32)1 << k;
+      }
+    }
+    fingerprint->subfingerprints[fingerprint->count] = subfingerprint;
+    fingerprint->count += 1;
+  }
+  memcpy(fingerprint->previous, coefficients, sizeof(coefficients));
+  fingerprint->hasPrevious = true;
+}
+
+/* Appends a sample at the analysis rate. */
+static void AudioFingerprintPush(struct AudioFingerprint* fingerprint,
+                                 Float32 sample) {
+  const Int32 n = AudioFingerprintFrameCount;
+
+  fingerprint->history[fingerprint->position] = sample;
+  fingerprint->position = (fingerprint->position + 1) & (n - 1);
+  if (fingerprint->filled < n) {
+    fingerprint->filled += 1;
+  }
+  fingerprint->pending += 1;
+
+  if (fingerprint->filled == n &&
+      fingerprint->pending >= AudioFingerprintHopCount) {
+    fingerprint->pending = 0;
+    AudioFingerprintAnalyze(fingerprint);
+  }
+}
+
+/* MARK: - Fingerprint */
+struct AudioFingerprint* AudioFingerprintCreate(Int32 sampleRate,
+                                                Int32 channelCount,
+                                                Int32 capacity) {
+  if (sampleRate < AudioFingerprintMinimumSampleRate ||
+      sampleRate > AudioFingerprintMaximumSampleRate ||
+      channelCount < 1 ||
+      channelCount > AudioFingerprintMaximumChannelCount ||
+      capacity < 0) {
+    return NULL;
+  }
+
+  struct AudioFingerprint* fingerprint = malloc(sizeof(*fingerprint));
+  if (fingerprint == NULL) {
+    return NULL;
+  }
+  memset(fingerprint, 0, sizeof(*fingerprint));
+  fingerprint->sampleRate = sampleRate;
+  fingerprint->channelCount = channelCount;
+  fingerprint->capacity = capacity;
+  fingerprint->setup = DSPDCTCreateSetup(
+    AudioFingerprintFrameCount,
+    DSPDCTTypeIV
+  );
+  fingerprint->subfingerprints = malloc(
+    (capacity > 0 ? capacity : 1) * sizeof(UInt32)
+  );
+  if (fingerprint->setup == NULL || fingerprint->subfingerprints == NULL) {
+    AudioFingerprintDestroy(fingerprint);
+    return NULL;
+  }
+
+  /* 1. Butterworth poles at 3pi/8 and pi/8 from the imaginary axis */
+  double k = tan(M_PI * AudioFingerprintCutoffFrequency / sampleRate);
+  for (Int32 i = 0; i < 2; i += 1) {
+    double q = 1 / (2 * cos(M_PI * (2 * i + 1) / 8));
+    double norm = 1 / (1 + k / q + k * k);
+    double* c = fingerprint->coefficients[i];
+    c[0] = k * k * norm;
+    c[1] = 2 * c[0];
+    c[2] = c[0];
+    c[3] = 2 * (k * k - 1) * norm;
+    c[4] = (1 - k / q + k * k) * norm;
+  }
+
+  /* 2. Hann window */
+  for (Int32 j = 0; j < AudioFingerprintFrameCount; j += 1) {
+    double angle = 2 * M_PI * (j + 0.5) / AudioFingerprintFrameCount;
+    fingerprint->window[j] = (Float32)(0.5 - 0.5 * cos(angle));
+  }
+
+  /* 3. Logarithmic band edges; bin k is centered at (k + 1/2) 11025/4N Hz */
+  double resolution = AudioFingerprintRate / 4.0 / AudioFingerprintFrameCount;
+  for (Int32 b = 0; b <= AudioFingerprintBandCount; b += 1) {
+    double frequency = AudioFingerprintLowestFrequency * pow(
+      AudioFingerprintHighestFrequency / AudioFingerprintLowestFrequency,
+      (double)b / AudioFingerprintBandCount
+    );
+    fingerprint->edges[b] = (Int32)lround(frequency / resolution - 0.5);
+  }
+
+  return fingerprint;
+}
+
+Bool AudioFingerprintUpdate(struct AudioFingerprint* fingerprint,
+                            const Float32* samples,
+                            Int64 count) {
+  const Int32 channelCount = fingerprint->channelCount;
+  const Int64 period = 2 * (Int64)fingerprint->sampleRate;
+  const double* c0 = fingerprint->coefficients[0];
+  const double* c1 = fingerprint->coefficients[1];
+  double* s0 = fingerprint->state[0];
+  double* s1 = fingerprint->state[1];
+
+  for (Int64 i = 0; i < count; i += 1) {
+    if (fingerprint->count == fingerprint->capacity) {
+      return false;
+    }
+
+    /* 1. Mix down */
+    double x = 0;
+    for (Int32 channel = 0; channel < channelCount; channel += 1) {
+      x += samples[i * channelCount + channel];
+    }
+    x /= channelCount;
+
+    /* 2. Low-pass */
+    double y = c0[0] * x + s0[0];
+    s0[0] = c0[1] * x - c0[3] * y + s0[1];
+    s0[1] = c0[2] * x - c0[4] * y;
+    x = y;
+    y = c1[0] * x + s1[0];
+    s1[0] = c1[1] * x - c1[3] * y + s1[1];
+    s1[1] = c1[2] * x - c1[4] * y;
+
+    /* 3. Decimate */
+    fingerprint->sum += y;
+    fingerprint->sumCount += 1;
+    fingerprint->phase += AudioFingerprintRate;
+    if (fingerprint->phase >= period) {
+      fingerprint->phase -= period;
+      AudioFingerprintPush(
+        fingerprint,
+        (Float32)(fingerprint->sum / fingerprint->sumCount)
+      );
+      fingerprint->sum = 0;
+      fingerprint->sumCount = 0;
+    }
+  }
+  return fingerprint->count < fingerprint->capacity;
+}
+
+const UInt32* AudioFingerprintGetSubfingerprints(
+  const struct AudioFingerprint* fingerprint,
+  Int32* count
+) {
+  *count = fingerprint->count;
+  return fingerprint->subfingerprints;
+}
+
+void AudioFingerprintDestroy(struct AudioFingerprint* fingerprint) {
+  if (fingerprint == NULL) {
+    return;
+  }
+  DSPDCTDestroySetup(fingerprint->setup);
+  free(fingerprint->subfingerprints);
+  free(fingerprint);
+}
+
+/* MARK: - Matching */
+/* Counts the differing bits of a[i] and b[i - offset] where both exist. */
+static Int64 AudioFingerprintErrors(const UInt32* a,
+                                    Int32 aCount,
+                                    const UInt32* b,
+                                    Int32 bCount,
+                                    Int32 offset,
+                                    Int32* overlap) {
+  Int32 start = offset > 0 ? offset : 0;
+  Int32 end = bCount + offset < aCount ? bCount + offset : aCount;
+  Int64 errors = 0;
+
+  for (Int32 i = start; i < end; i += 1) {
+    errors += __builtin_popcount(a[i] ^ b[i - offset]);
+  }
+  *overlap = end - start;
+  return errors;
+}
+
+Float32 AudioFingerprintMatch(const UInt32* a,
+                              Int32 aCount,
+                              const UInt32* b,
+                              Int32 bCount,
+                              Int32* offset) {
+  const Int32 keyCount = 1 << 16;
+  /* Offsets from `lowest` to `highest` overlap by enough */
+  const Int32 lowest = AudioFingerprintMinimumOverlap - bCount;
+  const Int32 highest = aCount - AudioFingerprintMinimumOverlap;
+  Float32 best = 1;
+
+  if (offset != NULL) {
+    *offset = 0;
+  }
+  /* Every alignment of a shorter fingerprint overlaps by too little */
+  if (
+    aCount < AudioFingerprintMinimumOverlap ||
+    bCount < AudioFingerprintMinimumOverlap
+  ) {
+    return best;
+  }
+
+  Int32* buckets = malloc(
+    ((Int64)keyCount + 1 + bCount + (highest - lowest + 1)) * sizeof(Int32)
+  );
+  if (buckets == NULL) {
+    return best;
+  }
+  Int32* order = buckets + keyCount + 1;
+  Int32* votes = order + bCount;
+
+  /* 1. Sort `b` by the low half of its sub-fingerprints */
+  memset(buckets, 0, (keyCount + 1) * sizeof(Int32));
+  for (Int32 j = 0; j < bCount; j += 1) {
+    buckets[(b[j] & 0xFFFF) + 1] += 1;
+  }
+  for (Int32 key = 0; key < keyCount; key += 1) {
+    buckets[key + 1] += buckets[key];
+  }
+  for (Int32 j = 0; j < bCount; j += 1) {
+    Int32 key = b[j] & 0xFFFF;
+    order[buckets[key]] = j;
+    buckets[key] += 1;
+  }
+  /* The bucket of key k now ends at buckets[k] and starts at buckets[k-1] */
+
+  /* 2. Every pair that shares a key votes for its alignment */
+  memset(votes, 0, (highest - lowest + 1) * sizeof(Int32));
+  for (Int32 i = 0; i < aCount; i += 1) {
+    Int32 key = a[i] & 0xFFFF;
+    Int32 start = key > 0 ? buckets[key - 1] : 0;
+    Int32 end = buckets[key];
+    if (end - start > AudioFingerprintMaximumBucketCount) {
+      continue;
+    }
+    for (Int32 p = start; p < end; p += 1) {
+      Int32 candidate = i - order[p];
+      if (candidate >= lowest && candidate <= highest) {
+        votes[candidate - lowest] += 1;
+      }
+    }
+  }
+
+  /* 3. Keep the most voted alignments, or all of them if nothing voted */
+  Int32 candidates[AudioFingerprintCandidateCount];
+  Int32 candidateCount = 0;
+  for (Int32 o = lowest; o <= highest; o += 1) {
+    Int32 v = votes[o - lowest];
+    if (v == 0) {
+      continue;
+    }
+    Int32 p = candidateCount < AudioFingerprintCandidateCount
+      ? candidateCount
+      : AudioFingerprintCandidateCount - 1;
+    if (candidateCount == AudioFingerprintCandidateCount &&
+        votes[candidates[p] - lowest] >= v) {
+      continue;
+    }
+    while (p > 0 && votes[candidates[p - 1] - lowest] < v) {
+      candidates[p] = candidates[p - 1];
+      p -= 1;
+    }
+    candidates[p] = o;
+    if (candidateCount < AudioFingerprintCandidateCount) {
+      candidateCount += 1;
+    }
+  }
+
+  /* 4. Compare them bit by bit */
+  for (Int32 c = 0; c < (candidateCount > 0 ? candidateCount : 1); c += 1) {
+    Int32 from = candidateCount > 0 ? candidates[c] : lowest;
+    Int32 to = candidateCount > 0 ? candidates[c] : highest;
+    for (Int32 o = from; o <= to; o += 1) {
+      Int32 overlap;
+      Int64 errors = AudioFingerprintErrors(a, aCount, b, bCount, o, &overlap);
+      Float32 rate = (Float32)((double)errors / (32.0 * overlap));
+      if (rate < best) {
+        best = rate;
+        if (offset != NULL) {
+          *offset = o;
+        }
+      }
+    }
+  }
+
+  free(buckets);
+  return best;
+}
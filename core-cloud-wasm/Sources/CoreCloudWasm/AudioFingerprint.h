@@ -0,0 +1,153 @@
+//
+//  AudioFingerprint.h
+//  core-cloud-wasm
+//
+//  Created by Fang Ling on 2026/10/17.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#ifndef AudioFingerprint_h
+#define AudioFingerprint_h
+
+#include "Base.h"
+
+/**
+ * The smallest sample rate an audio fingerprint accepts, in hertz.
+ */
+#define AudioFingerprintMinimumSampleRate 8000
+
+/**
+ * The largest sample rate an audio fingerprint accepts, in hertz.
+ */
+#define AudioFingerprintMaximumSampleRate 384000
+
+/**
+ * The largest number of interleaved channels an audio fingerprint accepts.
+ */
+#define AudioFingerprintMaximumChannelCount 8
+
+/**
+ * An acoustic fingerprint of a recording, computed in the style of
+ * Chromaprint and Haitsma-Kalker.
+ *
+ * The audio is mixed down to mono and resampled to 5512.5 Hz. Every 64
+ * samples, about 86 times a second, a 2048-sample Hann window is analyzed:
+ * the energies of 32 logarithmically spaced bands between 300 and 2000 Hz
+ * are compacted by a 32-point DCT of their logarithms, and the signs of the
+ * changes of the 32 coefficients since the previous window make a 32-bit
+ * sub-fingerprint. Gain and equalization change the logarithms by amounts
+ * that vary slowly in time, which the differences cancel, so encodings of
+ * the same recording at other bitrates, sample rates or levels give
+ * sub-fingerprints that differ in few bits.
+ *
+ * An audio fingerprint uses a fixed amount of memory besides the
+ * sub-fingerprints it keeps. Do not use the same audio fingerprint from more
+ * than one thread at a time.
+ */
+struct AudioFingerprint;
+
+/**
+ * Creates an audio fingerprint.
+ *
+ * - Parameters:
+ *   - sampleRate: The sample rate of the audio, between
+ *                 ``AudioFingerprintMinimumSampleRate`` and
+ *                 ``AudioFingerprintMaximumSampleRate`` hertz.
+ *   - channelCount: The number of interleaved channels, between 1 and
+ *                   ``AudioFingerprintMaximumChannelCount``.
+ *   - capacity: The largest number of sub-fingerprints to compute, such as
+ *               86 per second of audio to keep. The audio after the last of
+ *               them is ignored.
+ *
+ * - Returns: A new audio fingerprint, or `NULL` if a parameter is out of
+ *   range or the memory could not be allocated. Release it with
+ *   ``AudioFingerprintDestroy()``.
+ */
+struct AudioFingerprint* AudioFingerprintCreate(Int32 sampleRate,
+                                                Int32 channelCount,
+                                                Int32 capacity);
+
+/**
+ * Incrementally analyzes the next chunk of audio.
+ *
+ * Call this method one or more times to provide the audio in chunks of any
+ * length, such as the buffers of a streaming decoder.
+ *
+ * - Parameters:
+ *   - fingerprint: An audio fingerprint.
+ *   - samples: The next `count` frames of interleaved samples, nominally
+ *              between -1 and 1.
+ *   - count: The number of frames, each of `channelCount` samples.
+ *
+ * - Returns: `false` once the fingerprint holds `capacity` sub-fingerprints
+ *   and needs no more audio; `true` otherwise.
+ */
+Bool AudioFingerprintUpdate(struct AudioFingerprint* fingerprint,
+                            const Float32* samples,
+                            Int64 count);
+
+/**
+ * Returns the sub-fingerprints computed so far.
+ *
+ * - Parameters:
+ *   - fingerprint: An audio fingerprint.
+ *   - count: On return, the number of sub-fingerprints.
+ *
+ * - Returns: The sub-fingerprints, in the order of the audio. The pointer is
+ *   valid until the next call to ``AudioFingerprintUpdate()`` or
+ *   ``AudioFingerprintDestroy()``.
+ */
+const UInt32* AudioFingerprintGetSubfingerprints(
+  const struct AudioFingerprint* fingerprint,
+  Int32* count
+);
+
+/**
+ * Destroys an audio fingerprint.
+ *
+ * - Parameter fingerprint: An audio fingerprint, or `NULL`.
+ */
+void AudioFingerprintDestroy(struct AudioFingerprint* fingerprint);
+
+/**
+ * Finds the alignment of two fingerprints with the lowest bit error rate.
+ *
+ * Candidate alignments are voted for by pairs of sub-fingerprints that agree
+ * on their 16 lowest bits, and the best of them are then compared bit by bit
+ * over their whole overlap. Alignments that overlap by fewer than 64
+ * sub-fingerprints, about 0.75 seconds, are not considered.
+ *
+ * Fingerprints of the same recording typically match with a bit error rate
+ * below 0.2, while unrelated recordings match at around 0.5.
+ *
+ * - Parameters:
+ *   - a: The sub-fingerprints of the first recording.
+ *   - aCount: The number of sub-fingerprints in `a`.
+ *   - b: The sub-fingerprints of the second recording.
+ *   - bCount: The number of sub-fingerprints in `b`.
+ *   - offset: On return, the number of sub-fingerprints by which `b` lags
+ *             behind `a` at the best alignment, such that `a[i]` is aligned
+ *             with `b[i - offset]`. May be `NULL`.
+ *
+ * - Returns: The fraction of differing bits at the best alignment, or 1 if
+ *   either fingerprint is shorter than 64 sub-fingerprints or the memory
+ *   could not be allocated.
+ */
+Float32 AudioFingerprintMatch(const UInt32* a,
+                              Int32 aCount,
+                              const UInt32* b,
+                              Int32 bCount,
+                              Int32* offset);
+
+#endif /* AudioFingerprint_h */
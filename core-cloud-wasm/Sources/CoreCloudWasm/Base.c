@@ -19,9 +19,20 @@
 
 #include "Base.h"
 
+#include <stdatomic.h>
+#include <stdlib.h>
+
 /* MARK: - Working with Byte Order */
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define BASE_LITTLE_ENDIAN 1
+#endif
+
 /* Encode a 64-bit integer to byte strings in big-endian format. */
 void UInt64_BigEndianBytes(const UInt64 source, UInt8* destination) {
+#if defined(BASE_LITTLE_ENDIAN)
+  UInt64 x = __builtin_bswap64(source);
+  memcpy(destination, &x, 8);
+#else
   destination[0] = (source >> 56) & 0xFF;
   destination[1] = (source >> 48) & 0xFF;
   destination[2] = (source >> 40) & 0xFF;
@@ -30,10 +41,16 @@ void UInt64_BigEndianBytes(const UInt64 source, UInt8* destination) {
   destination[5] = (source >> 16) & 0xFF;
   destination[6] = (source >> 8) & 0xFF;
   destination[7] = source & 0xFF;
+#endif
 }
 
 /* Decode a 64-bit integer from byte strings in big-endian format. */
 void UInt64_InitBigEndianBytes(const UInt8* source, UInt64* destination) {
+#if defined(BASE_LITTLE_ENDIAN)
+  UInt64 x;
+  memcpy(&x, source, 8);
+  *destination = __builtin_bswap64(x);
+#else
   *destination = ((UInt64)source[0] << 56) |
                  ((UInt64)source[1] << 48) |
                  ((UInt64)source[2] << 40) |
@@ -42,4 +59,310 @@ void UInt64_InitBigEndianBytes(const UInt8* source, UInt64* destination) {
                  ((UInt64)source[5] << 16) |
                  ((UInt64)source[6] << 8) |
                  ((UInt64)source[7]);
+#endif
+}
+
+/* Decode `count` 64-bit integers, two at a time. */
+void UInt64_BigEndianLoadArray(const UInt8* source,
+                               UInt64* destination,
+                               Int64 count) {
+  Int64 i = 0;
+
+  for (; i + 2 <= count; i += 2) {
+    UInt64x2_Store(destination + i, UInt64x2_LoadBigEndian(source + i * 8));
+  }
+  if (i < count) {
+    UInt64_InitBigEndianBytes(source + i * 8, destination + i);
+  }
+}
+
+/* Encode `count` 64-bit integers, two at a time. */
+void UInt64_BigEndianStoreArray(const UInt64* source,
+                                UInt8* destination,
+                                Int64 count) {
+  Int64 i = 0;
+
+  for (; i + 2 <= count; i += 2) {
+    UInt64x2_StoreBigEndian(destination + i * 8, UInt64x2_Load(source + i));
+  }
+  if (i < count) {
+    UInt64_BigEndianBytes(source[i], destination + i * 8);
+  }
+}
+
+/* MARK: - Memory */
+/* The size and alignment of a slab, one page of WebAssembly memory */
+#define MemorySlabSize 65536
+/* The size classes of the slabs, 64 << i bytes */
+#define MemorySlabClassCount 5
+/* The smallest arena block */
+#define MemoryArenaBlockSize (1024 * 1024)
+/* The space in front of the buffers of an arena block */
+#define MemoryArenaHeaderSize 64
+
+/*
+ * A slab begins with its header, which takes the place of its first few
+ * objects; those are marked as allocated for good.  Bit `i % 64` of
+ * `occupancy[i / 64]` is set while object `i` is allocated.
+ */
+struct MemorySlab {
+  struct MemorySlab* next;
+  Int64 size;
+  _Atomic UInt64 occupancy[MemorySlabSize / 64 / 64];
+};
+
+/* A block of the arena; `count` bytes after the header are in use. */
+struct MemoryArenaBlock {
+  struct MemoryArenaBlock* next;
+  Int64 capacity;
+  Int64 count;
+};
+
+/* The blocks of an arena, newest first */
+struct Memory_Arena {
+  struct MemoryArenaBlock* blocks;
+};
+
+/* The slabs of each size class, newest first.  Slabs are never removed. */
+static struct MemorySlab* _Atomic SLABS[MemorySlabClassCount];
+
+/* The blocks no arena holds, guarded by `ARENA_LOCK` */
+static struct MemoryArenaBlock* FREE_BLOCKS = NULL;
+static atomic_flag ARENA_LOCK = ATOMIC_FLAG_INIT;
+
+static _Atomic Int64 SLAB_SIZE = 0;
+static _Atomic Int64 SLAB_OBJECT_COUNT = 0;
+static _Atomic Int64 ARENA_SIZE = 0;
+static _Atomic Int64 ARENA_USED_SIZE = 0;
+static _Atomic Int64 HIGH_WATER_MARK = 0;
+static _Atomic Int64 GROW_COUNT = 0;
+
+/* Takes `count` bytes from the system and adds them to `size`. */
+static void* MemoryGrow(Int64 alignment, Int64 count, _Atomic Int64* size) {
+  void* memory = aligned_alloc((size_t)alignment, (size_t)count);
+  if (memory == NULL) {
+    return NULL;
+  }
+
+  atomic_fetch_add(size, count);
+  atomic_fetch_add(&GROW_COUNT, 1);
+
+  Int64 total = atomic_load(&SLAB_SIZE) + atomic_load(&ARENA_SIZE);
+  Int64 highWaterMark = atomic_load(&HIGH_WATER_MARK);
+  while (
+    highWaterMark < total &&
+    !atomic_compare_exchange_weak(&HIGH_WATER_MARK, &highWaterMark, total)
+  ) {}
+  return memory;
+}
+
+/* MARK: Slabs */
+/* Claims the first free object of `slab`, or returns `NULL` if it is full. */
+static void* MemorySlabClaim(struct MemorySlab* slab) {
+  Int64 wordCount = MemorySlabSize / slab->size / 64;
+
+  for (Int64 i = 0; i < wordCount; i += 1) {
+    UInt64 occupancy = atomic_load(&slab->occupancy[i]);
+
+    while (occupancy != UINT64_MAX) {
+      Int32 bit = __builtin_ctzll(~occupancy);
+      if (
+        atomic_compare_exchange_weak(
+          &slab->occupancy[i],
+          &occupancy,
+          occupancy | (1ULL << bit)
+        )
+      ) {
+        return (UInt8*)slab + (i * 64 + bit) * slab->size;
+      }
+    }
+  }
+  return NULL;
+}
+
+void* Memory_SlabAllocate(Int64 count) {
+  Int32 sizeClass = 0;
+
+  if (count < 1 || count > Memory_SlabMaximumSize) {
+    return NULL;
+  }
+  while ((64 << sizeClass) < count) {
+    sizeClass += 1;
+  }
+
+  void* object = NULL;
+  struct MemorySlab* slab = atomic_load(&SLABS[sizeClass]);
+  for (; slab != NULL && object == NULL; slab = slab->next) {
+    object = MemorySlabClaim(slab);
+  }
+
+  if (object == NULL) {
+    /* Every slab is full: add one, with its first free object taken. */
+    slab = MemoryGrow(MemorySlabSize, MemorySlabSize, &SLAB_SIZE);
+    if (slab == NULL) {
+      return NULL;
+    }
+
+    slab->size = 64 << sizeClass;
+    Int64 headerCount = (sizeof(struct MemorySlab) + slab->size - 1) /
+                        slab->size;
+    for (Int32 i = 0; i < MemorySlabSize / 64 / 64; i += 1) {
+      atomic_init(&slab->occupancy[i], 0);
+    }
+    atomic_init(&slab->occupancy[0], (1ULL << (headerCount + 1)) - 1);
+    object = (UInt8*)slab + headerCount * slab->size;
+
+    slab->next = atomic_load(&SLABS[sizeClass]);
+    while (
+      !atomic_compare_exchange_weak(&SLABS[sizeClass], &slab->next, slab)
+    ) {}
+  }
+
+  atomic_fetch_add(&SLAB_OBJECT_COUNT, 1);
+  return object;
+}
+
+void Memory_SlabFree(void* object) {
+  if (object == NULL) {
+    return;
+  }
+
+  struct MemorySlab* slab = (struct MemorySlab*)(
+    (uintptr_t)object & ~(uintptr_t)(MemorySlabSize - 1)
+  );
+  Int64 i = ((UInt8*)object - (UInt8*)slab) / slab->size;
+
+  atomic_fetch_and(&slab->occupancy[i / 64], ~(1ULL << (i % 64)));
+  atomic_fetch_sub(&SLAB_OBJECT_COUNT, 1);
+}
+
+/* MARK: Arena */
+/*
+ * Takes the smallest free block with room for `count` bytes.  If there is
+ * none, the free blocks are all too small: they go back to the system, and a
+ * new block takes their place.
+ */
+static struct MemoryArenaBlock* MemoryArenaClaim(Int64 count) {
+  while (atomic_flag_test_and_set(&ARENA_LOCK)) {}
+
+  struct MemoryArenaBlock** best = NULL;
+  struct MemoryArenaBlock** link = &FREE_BLOCKS;
+  for (; *link != NULL; link = &(*link)->next) {
+    if (
+      (*link)->capacity >= count &&
+      (best == NULL || (*link)->capacity < (*best)->capacity)
+    ) {
+      best = link;
+    }
+  }
+
+  struct MemoryArenaBlock* block = NULL;
+  struct MemoryArenaBlock* smallBlocks = NULL;
+  if (best != NULL) {
+    block = *best;
+    *best = block->next;
+  } else {
+    smallBlocks = FREE_BLOCKS;
+    FREE_BLOCKS = NULL;
+  }
+
+  atomic_flag_clear(&ARENA_LOCK);
+
+  while (smallBlocks != NULL) {
+    struct MemoryArenaBlock* next = smallBlocks->next;
+    atomic_fetch_sub(
+      &ARENA_SIZE,
+      MemoryArenaHeaderSize + smallBlocks->capacity
+    );
+    free(smallBlocks);
+    smallBlocks = next;
+  }
+
+  if (block == NULL) {
+    Int64 capacity = MemoryArenaBlockSize;
+    if (capacity < count) {
+      capacity = (count + MemorySlabSize - 1) / MemorySlabSize * MemorySlabSize;
+    }
+
+    block = MemoryGrow(64, MemoryArenaHeaderSize + capacity, &ARENA_SIZE);
+    if (block == NULL) {
+      return NULL;
+    }
+    block->capacity = capacity;
+    block->count = 0;
+  }
+  return block;
+}
+
+struct Memory_Arena* Memory_ArenaCreate(void) {
+  struct Memory_Arena* arena = Memory_SlabAllocate(sizeof(struct Memory_Arena));
+  if (arena == NULL) {
+    return NULL;
+  }
+
+  arena->blocks = NULL;
+  return arena;
+}
+
+void* Memory_ArenaAllocate(struct Memory_Arena* arena, Int64 count) {
+  if (count < 1 || (UInt64)count > SIZE_MAX / 2) {
+    return NULL;
+  }
+  count = (count + 63) / 64 * 64;
+
+  struct MemoryArenaBlock* block = arena->blocks;
+  if (block == NULL || block->capacity - block->count < count) {
+    block = MemoryArenaClaim(count);
+    if (block == NULL) {
+      return NULL;
+    }
+    block->next = arena->blocks;
+    arena->blocks = block;
+  }
+
+  void* buffer = (UInt8*)block + MemoryArenaHeaderSize + block->count;
+  block->count += count;
+  atomic_fetch_add(&ARENA_USED_SIZE, count);
+  return buffer;
+}
+
+void Memory_ArenaReset(struct Memory_Arena* arena) {
+  struct MemoryArenaBlock* last = arena->blocks;
+  if (last == NULL) {
+    return;
+  }
+
+  Int64 count = last->count;
+  last->count = 0;
+  while (last->next != NULL) {
+    last = last->next;
+    count += last->count;
+    last->count = 0;
+  }
+  atomic_fetch_sub(&ARENA_USED_SIZE, count);
+
+  while (atomic_flag_test_and_set(&ARENA_LOCK)) {}
+  last->next = FREE_BLOCKS;
+  FREE_BLOCKS = arena->blocks;
+  atomic_flag_clear(&ARENA_LOCK);
+
+  arena->blocks = NULL;
+}
+
+void Memory_ArenaDestroy(struct Memory_Arena* arena) {
+  if (arena == NULL) {
+    return;
+  }
+
+  Memory_ArenaReset(arena);
+  Memory_SlabFree(arena);
+}
+
+void Memory_GetStatistics(struct Memory_Statistics* statistics) {
+  statistics->slabSize = atomic_load(&SLAB_SIZE);
+  statistics->slabObjectCount = atomic_load(&SLAB_OBJECT_COUNT);
+  statistics->arenaSize = atomic_load(&ARENA_SIZE);
+  statistics->arenaUsedSize = atomic_load(&ARENA_USED_SIZE);
+  statistics->highWaterMark = atomic_load(&HIGH_WATER_MARK);
+  statistics->growCount = atomic_load(&GROW_COUNT);
 }
@@ -20,6 +20,7 @@
 #ifndef Base_h
 #define Base_h
 
+#include <stdbool.h>
 #include <stdint.h>
 #include <string.h>
 
@@ -28,6 +29,10 @@
  * An 8-bit unsigned integer value type.
  */
 typedef uint8_t UInt8;
+/**
+ * A 16-bit unsigned integer value type.
+ */
+typedef uint16_t UInt16;
 /**
  * A 32-bit unsigned integer value type.
  */
@@ -38,6 +43,14 @@ typedef uint32_t UInt32;
 typedef uint64_t UInt64;
 
 /* MARK: - Signed Integers */
+/**
+ * An 8-bit signed integer value type.
+ */
+typedef int8_t Int8;
+/**
+ * A 16-bit signed integer value type.
+ */
+typedef int16_t Int16;
 /**
  * A 32-bit signed integer value type.
  */
@@ -47,6 +60,12 @@ typedef int32_t Int32;
  */
 typedef int64_t Int64;
 
+/* MARK: - Boolean Values */
+/**
+ * A value type whose instances are either `true` or `false`.
+ */
+typedef bool Bool;
+
 /* MARK: - Floating-Point Values */
 /**
  * A 32-bit floating point type.
@@ -76,4 +95,709 @@ void UInt64_BigEndianBytes(const UInt64 source, UInt8* destination);
  */
 void UInt64_InitBigEndianBytes(const UInt8* source, UInt64* destination);
 
+/**
+ * Creates integer values from a byte buffer in big-endian format.
+ *
+ * - Parameters:
+ *   - source: A byte buffer of `8 * count` bytes in big-endian format.
+ *   - destination: A buffer to store the `count` integers.
+ *   - count: The number of integers to convert.
+ */
+void UInt64_BigEndianLoadArray(const UInt8* source,
+                               UInt64* destination,
+                               Int64 count);
+
+/**
+ * Converts integers from the host's native byte order to big-endian format
+ * bytes.
+ *
+ * - Parameters:
+ *   - source: The `count` integers to convert.
+ *   - destination: A byte buffer to store the `8 * count` bytes.
+ *   - count: The number of integers to convert.
+ */
+void UInt64_BigEndianStoreArray(const UInt64* source,
+                                UInt8* destination,
+                                Int64 count);
+
+/* MARK: - Memory */
+/*
+ * Two allocators for the host, such as the JavaScript side of the
+ * WebAssembly module, that keep the heap from fragmenting over a long
+ * session:
+ *
+ * - Slabs hold small objects of fixed size, such as hash functions, keys
+ *   and digests. Each slab is a 64 KiB block of objects of one size class,
+ *   from 64 to ``Memory_SlabMaximumSize`` bytes. A freed object goes back to
+ *   its slab and is reused, so the slabs only grow to the largest number of
+ *   objects alive at once.
+ * - Arenas hold large transient buffers, such as a staging area. Each
+ *   operation, such as an upload, creates its own arena; allocating is a
+ *   bump of a pointer, and ``Memory_ArenaDestroy()`` releases everything at
+ *   once when the operation is over. The blocks of the arenas go back to a
+ *   shared free list and are reused, so operations of the same size running
+ *   one after another allocate nothing. Free blocks are given back to the
+ *   system only when they are all too small for a new buffer.
+ *
+ * Slabs are never given back. Both return 64-byte aligned memory and are
+ * safe to use from several threads, but one arena must only be used by one
+ * thread at a time.
+ */
+
+/**
+ * The size of the largest object the slabs hold.
+ */
+#define Memory_SlabMaximumSize 1024
+
+/**
+ * Memory usage of the slabs and the arenas.
+ */
+struct Memory_Statistics {
+  /**
+   * The number of bytes of the slabs.
+   */
+  Int64 slabSize;
+  /**
+   * The number of objects allocated from the slabs and not yet freed.
+   */
+  Int64 slabObjectCount;
+  /**
+   * The number of bytes of the arena blocks, in use or free.
+   */
+  Int64 arenaSize;
+  /**
+   * The number of bytes allocated from the arenas and not yet released.
+   */
+  Int64 arenaUsedSize;
+  /**
+   * The largest number of bytes that the slabs and the arenas held together.
+   */
+  Int64 highWaterMark;
+  /**
+   * The number of times the slabs or the arenas took memory from the system.
+   */
+  Int64 growCount;
+};
+
+/**
+ * Allocates an object from the slabs.
+ *
+ * - Parameter count: The size of the object in bytes, between 1 and
+ *   ``Memory_SlabMaximumSize``.
+ *
+ * - Returns: A 64-byte aligned object, or `NULL` if `count` is out of range
+ *   or the memory could not be allocated. Release it with
+ *   ``Memory_SlabFree()``.
+ */
+void* Memory_SlabAllocate(Int64 count);
+
+/**
+ * Returns an object to its slab.
+ *
+ * - Parameter object: An object allocated by ``Memory_SlabAllocate()``, or
+ *   `NULL`.
+ */
+void Memory_SlabFree(void* object);
+
+/**
+ * An arena of large transient buffers.
+ */
+struct Memory_Arena;
+
+/**
+ * Creates an arena.
+ *
+ * - Returns: A new, empty arena, or `NULL` if the memory could not be
+ *   allocated. Release it with ``Memory_ArenaDestroy()``.
+ */
+struct Memory_Arena* Memory_ArenaCreate(void);
+
+/**
+ * Allocates a buffer from an arena.
+ *
+ * - Parameters:
+ *   - arena: An arena.
+ *   - count: The size of the buffer in bytes, at least 1.
+ *
+ * - Returns: A 64-byte aligned buffer that stays valid until `arena` is reset
+ *   or destroyed, or `NULL` if `count` is out of range or the memory could
+ *   not be allocated.
+ */
+void* Memory_ArenaAllocate(struct Memory_Arena* arena, Int64 count);
+
+/**
+ * Releases every buffer allocated from an arena, for the next operation.
+ *
+ * - Parameter arena: An arena.
+ */
+void Memory_ArenaReset(struct Memory_Arena* arena);
+
+/**
+ * Releases every buffer allocated from an arena and destroys it.
+ *
+ * - Parameter arena: An arena, or `NULL`.
+ */
+void Memory_ArenaDestroy(struct Memory_Arena* arena);
+
+/**
+ * Returns the memory usage of the slabs and the arenas.
+ *
+ * - Parameter statistics: A structure to store the memory usage.
+ */
+void Memory_GetStatistics(struct Memory_Statistics* statistics);
+
+/* MARK: - SIMD Vectors */
+/*
+ * 128-bit vectors shared by the kernels: `Float32x4`, `UInt64x2` and
+ * `UInt8x16`.  Every backend below provides the same lane-wise operations,
+ * selected at compile time from the target's instruction set: WebAssembly
+ * SIMD128, SSE2 (with SSSE3 and FMA when enabled), NEON, or plain C structs.
+ * Define `SIMD_SCALAR` to build the plain C reference instead; it is also
+ * defined when the target has none of them.
+ *
+ * The vectors are for C kernels only and are hidden from Swift.
+ */
+#if !defined(__swift__)
+#if defined(__wasm_simd128__) && !defined(SIMD_SCALAR)
+#include <wasm_simd128.h>
+
+#define SIMD_WASM 1
+
+typedef v128_t Float32x4;
+typedef v128_t UInt64x2;
+typedef v128_t UInt8x16;
+#elif defined(__SSE2__) && !defined(SIMD_SCALAR)
+#include <emmintrin.h>
+#if defined(__SSSE3__)
+#include <tmmintrin.h>
+#endif
+#if defined(__FMA__)
+#include <immintrin.h>
+#endif
+
+#define SIMD_SSE 1
+
+typedef __m128 Float32x4;
+typedef __m128i UInt64x2;
+typedef __m128i UInt8x16;
+#elif defined(__ARM_NEON) && !defined(SIMD_SCALAR)
+#include <arm_neon.h>
+
+#define SIMD_NEON 1
+
+typedef float32x4_t Float32x4;
+typedef uint64x2_t UInt64x2;
+typedef uint8x16_t UInt8x16;
+#else
+#if !defined(SIMD_SCALAR)
+#define SIMD_SCALAR 1
+#endif
+
+/**
+ * Four single-precision lanes.
+ */
+typedef struct {
+  Float32 lane[4];
+} Float32x4;
+
+/**
+ * Two 64-bit unsigned integer lanes.
+ */
+typedef struct {
+  UInt64 lane[2];
+} UInt64x2;
+
+/**
+ * Sixteen 8-bit unsigned integer lanes.
+ */
+typedef struct {
+  UInt8 lane[16];
+} UInt8x16;
+#endif
+
+/* MARK: Float32x4 */
+
+/* Loads four values from `source`, which need not be aligned. */
+static inline Float32x4 Float32x4_Load(const Float32* source) {
+#if defined(SIMD_WASM)
+  return wasm_v128_load(source);
+#elif defined(SIMD_SSE)
+  return _mm_loadu_ps(source);
+#elif defined(SIMD_NEON)
+  return vld1q_f32(source);
+#else
+  Float32x4 result;
+  memcpy(result.lane, source, sizeof(result.lane));
+  return result;
+#endif
+}
+
+/* Stores the four lanes of `x` to `destination`. */
+static inline void Float32x4_Store(Float32* destination, Float32x4 x) {
+#if defined(SIMD_WASM)
+  wasm_v128_store(destination, x);
+#elif defined(SIMD_SSE)
+  _mm_storeu_ps(destination, x);
+#elif defined(SIMD_NEON)
+  vst1q_f32(destination, x);
+#else
+  memcpy(destination, x.lane, sizeof(x.lane));
+#endif
+}
+
+/* Returns `x` in every lane. */
+static inline Float32x4 Float32x4_Splat(Float32 x) {
+#if defined(SIMD_WASM)
+  return wasm_f32x4_splat(x);
+#elif defined(SIMD_SSE)
+  return _mm_set1_ps(x);
+#elif defined(SIMD_NEON)
+  return vdupq_n_f32(x);
+#else
+  Float32x4 result = { { x, x, x, x } };
+  return result;
+#endif
+}
+
+static inline Float32x4 Float32x4_Add(Float32x4 a, Float32x4 b) {
+#if defined(SIMD_WASM)
+  return wasm_f32x4_add(a, b);
+#elif defined(SIMD_SSE)
+  return _mm_add_ps(a, b);
+#elif defined(SIMD_NEON)
+  return vaddq_f32(a, b);
+#else
+  for (Int32 i = 0; i < 4; i += 1) {
+    a.lane[i] += b.lane[i];
+  }
+  return a;
+#endif
+}
+
+static inline Float32x4 Float32x4_Subtract(Float32x4 a, Float32x4 b) {
+#if defined(SIMD_WASM)
+  return wasm_f32x4_sub(a, b);
+#elif defined(SIMD_SSE)
+  return _mm_sub_ps(a, b);
+#elif defined(SIMD_NEON)
+  return vsubq_f32(a, b);
+#else
+  for (Int32 i = 0; i < 4; i += 1) {
+    a.lane[i] -= b.lane[i];
+  }
+  return a;
+#endif
+}
+
+static inline Float32x4 Float32x4_Multiply(Float32x4 a, Float32x4 b) {
+#if defined(SIMD_WASM)
+  return wasm_f32x4_mul(a, b);
+#elif defined(SIMD_SSE)
+  return _mm_mul_ps(a, b);
+#elif defined(SIMD_NEON)
+  return vmulq_f32(a, b);
+#else
+  for (Int32 i = 0; i < 4; i += 1) {
+    a.lane[i] *= b.lane[i];
+  }
+  return a;
+#endif
+}
+
+/*
+ * Returns `a * b + c`, with a single rounding where the target has fused
+ * multiply-add (FMA3, NEON on ARMv8, relaxed SIMD), so the last bit of the
+ * result may differ between targets.
+ */
+static inline Float32x4 Float32x4_MultiplyAdd(Float32x4 a,
+                                              Float32x4 b,
+                                              Float32x4 c) {
+#if defined(SIMD_WASM) && defined(__wasm_relaxed_simd__)
+  return wasm_f32x4_relaxed_madd(a, b, c);
+#elif defined(SIMD_WASM)
+  return wasm_f32x4_add(wasm_f32x4_mul(a, b), c);
+#elif defined(SIMD_SSE) && defined(__FMA__)
+  return _mm_fmadd_ps(a, b, c);
+#elif defined(SIMD_SSE)
+  return _mm_add_ps(_mm_mul_ps(a, b), c);
+#elif defined(SIMD_NEON) && defined(__ARM_FEATURE_FMA)
+  return vfmaq_f32(c, a, b);
+#elif defined(SIMD_NEON)
+  return vmlaq_f32(c, a, b);
+#else
+  for (Int32 i = 0; i < 4; i += 1) {
+    c.lane[i] += a.lane[i] * b.lane[i];
+  }
+  return c;
+#endif
+}
+
+static inline Float32x4 Float32x4_Minimum(Float32x4 a, Float32x4 b) {
+#if defined(SIMD_WASM)
+  return wasm_f32x4_min(a, b);
+#elif defined(SIMD_SSE)
+  return _mm_min_ps(a, b);
+#elif defined(SIMD_NEON)
+  return vminq_f32(a, b);
+#else
+  for (Int32 i = 0; i < 4; i += 1) {
+    a.lane[i] = a.lane[i] < b.lane[i] ? a.lane[i] : b.lane[i];
+  }
+  return a;
+#endif
+}
+
+static inline Float32x4 Float32x4_Maximum(Float32x4 a, Float32x4 b) {
+#if defined(SIMD_WASM)
+  return wasm_f32x4_max(a, b);
+#elif defined(SIMD_SSE)
+  return _mm_max_ps(a, b);
+#elif defined(SIMD_NEON)
+  return vmaxq_f32(a, b);
+#else
+  for (Int32 i = 0; i < 4; i += 1) {
+    a.lane[i] = a.lane[i] > b.lane[i] ? a.lane[i] : b.lane[i];
+  }
+  return a;
+#endif
+}
+
+/* Transposes the 4x4 matrix whose rows are `r[0]` to `r[3]`. */
+static inline void Float32x4_Transpose4x4(Float32x4 r[4]) {
+#if defined(SIMD_WASM)
+  v128_t t0 = wasm_i32x4_shuffle(r[0], r[1], 0, 4, 1, 5);
+  v128_t t1 = wasm_i32x4_shuffle(r[0], r[1], 2, 6, 3, 7);
+  v128_t t2 = wasm_i32x4_shuffle(r[2], r[3], 0, 4, 1, 5);
+  v128_t t3 = wasm_i32x4_shuffle(r[2], r[3], 2, 6, 3, 7);
+  r[0] = wasm_i32x4_shuffle(t0, t2, 0, 1, 4, 5);
+  r[1] = wasm_i32x4_shuffle(t0, t2, 2, 3, 6, 7);
+  r[2] = wasm_i32x4_shuffle(t1, t3, 0, 1, 4, 5);
+  r[3] = wasm_i32x4_shuffle(t1, t3, 2, 3, 6, 7);
+#elif defined(SIMD_SSE)
+  _MM_TRANSPOSE4_PS(r[0], r[1], r[2], r[3]);
+#elif defined(SIMD_NEON)
+  float32x4x2_t t01 = vtrnq_f32(r[0], r[1]);
+  float32x4x2_t t23 = vtrnq_f32(r[2], r[3]);
+  r[0] = vcombine_f32(vget_low_f32(t01.val[0]), vget_low_f32(t23.val[0]));
+  r[1] = vcombine_f32(vget_low_f32(t01.val[1]), vget_low_f32(t23.val[1]));
+  r[2] = vcombine_f32(vget_high_f32(t01.val[0]), vget_high_f32(t23.val[0]));
+  r[3] = vcombine_f32(vget_high_f32(t01.val[1]), vget_high_f32(t23.val[1]));
+#else
+  for (Int32 i = 0; i < 4; i += 1) {
+    for (Int32 j = i + 1; j < 4; j += 1) {
+      Float32 x = r[i].lane[j];
+      r[i].lane[j] = r[j].lane[i];
+      r[j].lane[i] = x;
+    }
+  }
+#endif
+}
+
+/* MARK: UInt8x16 */
+
+/* Loads sixteen bytes from `source`, which need not be aligned. */
+static inline UInt8x16 UInt8x16_Load(const UInt8* source) {
+#if defined(SIMD_WASM)
+  return wasm_v128_load(source);
+#elif defined(SIMD_SSE)
+  return _mm_loadu_si128((const __m128i*)source);
+#elif defined(SIMD_NEON)
+  return vld1q_u8(source);
+#else
+  UInt8x16 result;
+  memcpy(result.lane, source, sizeof(result.lane));
+  return result;
+#endif
+}
+
+/* Stores the sixteen lanes of `x` to `destination`. */
+static inline void UInt8x16_Store(UInt8* destination, UInt8x16 x) {
+#if defined(SIMD_WASM)
+  wasm_v128_store(destination, x);
+#elif defined(SIMD_SSE)
+  _mm_storeu_si128((__m128i*)destination, x);
+#elif defined(SIMD_NEON)
+  vst1q_u8(destination, x);
+#else
+  memcpy(destination, x.lane, sizeof(x.lane));
+#endif
+}
+
+/*
+ * Returns the lanes of `x` picked by `indices`: lane `i` of the result is
+ * lane `indices[i]` of `x`, for indices between 0 and 15.
+ */
+static inline UInt8x16 UInt8x16_Shuffle(UInt8x16 x, UInt8x16 indices) {
+#if defined(SIMD_WASM)
+  return wasm_i8x16_swizzle(x, indices);
+#elif defined(SIMD_SSE) && defined(__SSSE3__)
+  return _mm_shuffle_epi8(x, indices);
+#elif defined(SIMD_NEON) && defined(__aarch64__)
+  return vqtbl1q_u8(x, indices);
+#elif defined(SIMD_NEON)
+  uint8x8x2_t table = { { vget_low_u8(x), vget_high_u8(x) } };
+  return vcombine_u8(vtbl2_u8(table, vget_low_u8(indices)),
+                     vtbl2_u8(table, vget_high_u8(indices)));
+#else
+  UInt8 lanes[16];
+  UInt8 picks[16];
+  UInt8 result[16];
+
+  UInt8x16_Store(lanes, x);
+  UInt8x16_Store(picks, indices);
+  for (Int32 i = 0; i < 16; i += 1) {
+    result[i] = lanes[picks[i] & 15];
+  }
+  return UInt8x16_Load(result);
+#endif
+}
+
+/* MARK: UInt64x2 */
+
+/* Loads two values from `source`, which need not be aligned. */
+static inline UInt64x2 UInt64x2_Load(const UInt64* source) {
+#if defined(SIMD_WASM)
+  return wasm_v128_load(source);
+#elif defined(SIMD_SSE)
+  return _mm_loadu_si128((const __m128i*)source);
+#elif defined(SIMD_NEON)
+  return vld1q_u64(source);
+#else
+  UInt64x2 result;
+  memcpy(result.lane, source, sizeof(result.lane));
+  return result;
+#endif
+}
+
+/* Stores the two lanes of `x` to `destination`. */
+static inline void UInt64x2_Store(UInt64* destination, UInt64x2 x) {
+#if defined(SIMD_WASM)
+  wasm_v128_store(destination, x);
+#elif defined(SIMD_SSE)
+  _mm_storeu_si128((__m128i*)destination, x);
+#elif defined(SIMD_NEON)
+  vst1q_u64(destination, x);
+#else
+  memcpy(destination, x.lane, sizeof(x.lane));
+#endif
+}
+
+/* Returns a vector of `x` in lane 0 and `y` in lane 1. */
+static inline UInt64x2 UInt64x2_Make(UInt64 x, UInt64 y) {
+#if defined(SIMD_WASM)
+  return wasm_i64x2_make((Int64)x, (Int64)y);
+#elif defined(SIMD_SSE)
+  return _mm_set_epi64x((long long)y, (long long)x);
+#elif defined(SIMD_NEON)
+  return vcombine_u64(vcreate_u64(x), vcreate_u64(y));
+#else
+  UInt64x2 result = { { x, y } };
+  return result;
+#endif
+}
+
+/* Returns `x` in both lanes. */
+static inline UInt64x2 UInt64x2_Splat(UInt64 x) {
+#if defined(SIMD_WASM)
+  return wasm_i64x2_splat((Int64)x);
+#elif defined(SIMD_SSE)
+  return _mm_set1_epi64x((long long)x);
+#elif defined(SIMD_NEON)
+  return vdupq_n_u64(x);
+#else
+  return UInt64x2_Make(x, x);
+#endif
+}
+
+/* Reinterprets the bytes of `x` as two 64-bit lanes. */
+static inline UInt64x2 UInt64x2_FromUInt8x16(UInt8x16 x) {
+#if defined(SIMD_NEON)
+  return vreinterpretq_u64_u8(x);
+#elif defined(SIMD_SCALAR)
+  UInt64x2 result;
+  memcpy(result.lane, x.lane, sizeof(result.lane));
+  return result;
+#else
+  return x;
+#endif
+}
+
+/* Reinterprets the two 64-bit lanes of `x` as bytes. */
+static inline UInt8x16 UInt8x16_FromUInt64x2(UInt64x2 x) {
+#if defined(SIMD_NEON)
+  return vreinterpretq_u8_u64(x);
+#elif defined(SIMD_SCALAR)
+  UInt8x16 result;
+  memcpy(result.lane, x.lane, sizeof(result.lane));
+  return result;
+#else
+  return x;
+#endif
+}
+
+static inline UInt64x2 UInt64x2_Add(UInt64x2 a, UInt64x2 b) {
+#if defined(SIMD_WASM)
+  return wasm_i64x2_add(a, b);
+#elif defined(SIMD_SSE)
+  return _mm_add_epi64(a, b);
+#elif defined(SIMD_NEON)
+  return vaddq_u64(a, b);
+#else
+  return UInt64x2_Make(a.lane[0] + b.lane[0], a.lane[1] + b.lane[1]);
+#endif
+}
+
+static inline UInt64x2 UInt64x2_And(UInt64x2 a, UInt64x2 b) {
+#if defined(SIMD_WASM)
+  return wasm_v128_and(a, b);
+#elif defined(SIMD_SSE)
+  return _mm_and_si128(a, b);
+#elif defined(SIMD_NEON)
+  return vandq_u64(a, b);
+#else
+  return UInt64x2_Make(a.lane[0] & b.lane[0], a.lane[1] & b.lane[1]);
+#endif
+}
+
+static inline UInt64x2 UInt64x2_Or(UInt64x2 a, UInt64x2 b) {
+#if defined(SIMD_WASM)
+  return wasm_v128_or(a, b);
+#elif defined(SIMD_SSE)
+  return _mm_or_si128(a, b);
+#elif defined(SIMD_NEON)
+  return vorrq_u64(a, b);
+#else
+  return UInt64x2_Make(a.lane[0] | b.lane[0], a.lane[1] | b.lane[1]);
+#endif
+}
+
+static inline UInt64x2 UInt64x2_Xor(UInt64x2 a, UInt64x2 b) {
+#if defined(SIMD_WASM)
+  return wasm_v128_xor(a, b);
+#elif defined(SIMD_SSE)
+  return _mm_xor_si128(a, b);
+#elif defined(SIMD_NEON)
+  return veorq_u64(a, b);
+#else
+  return UInt64x2_Make(a.lane[0] ^ b.lane[0], a.lane[1] ^ b.lane[1]);
+#endif
+}
+
+/*
+ * Shifts both lanes of `x` by `n` bits, which must be a constant between 1
+ * and 63 since NEON encodes it in the instruction.
+ */
+#if defined(SIMD_WASM)
+#define UInt64x2_ShiftLeft(x, n)  wasm_i64x2_shl(x, n)
+#define UInt64x2_ShiftRight(x, n) wasm_u64x2_shr(x, n)
+#elif defined(SIMD_SSE)
+#define UInt64x2_ShiftLeft(x, n)  _mm_slli_epi64(x, n)
+#define UInt64x2_ShiftRight(x, n) _mm_srli_epi64(x, n)
+#elif defined(SIMD_NEON)
+#define UInt64x2_ShiftLeft(x, n)  vshlq_n_u64(x, n)
+#define UInt64x2_ShiftRight(x, n) vshrq_n_u64(x, n)
+#else
+#define UInt64x2_ShiftLeft(x, n)  \
+  UInt64x2_Make((x).lane[0] << (n), (x).lane[1] << (n))
+#define UInt64x2_ShiftRight(x, n) \
+  UInt64x2_Make((x).lane[0] >> (n), (x).lane[1] >> (n))
+#endif
+
+/*
+ * Returns the pair straddling `a` and `b`: lane 1 of `a` in lane 0, and lane
+ * 0 of `b` in lane 1.
+ */
+static inline UInt64x2 UInt64x2_Span(UInt64x2 a, UInt64x2 b) {
+#if defined(SIMD_WASM)
+  return wasm_i64x2_shuffle(a, b, 1, 2);
+#elif defined(SIMD_SSE) && defined(__SSSE3__)
+  return _mm_alignr_epi8(b, a, 8);
+#elif defined(SIMD_SSE)
+  return _mm_or_si128(_mm_srli_si128(a, 8), _mm_slli_si128(b, 8));
+#elif defined(SIMD_NEON)
+  return vextq_u64(a, b, 1);
+#else
+  return UInt64x2_Make(a.lane[1], b.lane[0]);
+#endif
+}
+
+/* Returns lane 0 of `a` in lane 0, and lane 0 of `b` in lane 1. */
+static inline UInt64x2 UInt64x2_InterleaveLow(UInt64x2 a, UInt64x2 b) {
+#if defined(SIMD_WASM)
+  return wasm_i64x2_shuffle(a, b, 0, 2);
+#elif defined(SIMD_SSE)
+  return _mm_unpacklo_epi64(a, b);
+#elif defined(SIMD_NEON)
+  return vcombine_u64(vget_low_u64(a), vget_low_u64(b));
+#else
+  return UInt64x2_Make(a.lane[0], b.lane[0]);
+#endif
+}
+
+/* Returns lane 1 of `a` in lane 0, and lane 1 of `b` in lane 1. */
+static inline UInt64x2 UInt64x2_InterleaveHigh(UInt64x2 a, UInt64x2 b) {
+#if defined(SIMD_WASM)
+  return wasm_i64x2_shuffle(a, b, 1, 3);
+#elif defined(SIMD_SSE)
+  return _mm_unpackhi_epi64(a, b);
+#elif defined(SIMD_NEON)
+  return vcombine_u64(vget_high_u64(a), vget_high_u64(b));
+#else
+  return UInt64x2_Make(a.lane[1], b.lane[1]);
+#endif
+}
+
+/* Reverses the bytes of both lanes of `x`. */
+static inline UInt64x2 UInt64x2_ByteSwap(UInt64x2 x) {
+#if defined(SIMD_WASM)
+  return wasm_i8x16_shuffle(x, x,
+                            7, 6, 5, 4, 3, 2, 1, 0,
+                            15, 14, 13, 12, 11, 10, 9, 8);
+#elif defined(SIMD_SSE) && defined(__SSSE3__)
+  return _mm_shuffle_epi8(
+    x,
+    _mm_set_epi8(8, 9, 10, 11, 12, 13, 14, 15, 0, 1, 2, 3, 4, 5, 6, 7)
+  );
+#elif defined(SIMD_SSE)
+  /* Swap the bytes of each 16-bit word, then reverse the words. */
+  x = _mm_or_si128(_mm_slli_epi16(x, 8), _mm_srli_epi16(x, 8));
+  x = _mm_shufflelo_epi16(x, 0x1B);
+  return _mm_shufflehi_epi16(x, 0x1B);
+#elif defined(SIMD_NEON)
+  return vreinterpretq_u64_u8(vrev64q_u8(vreinterpretq_u8_u64(x)));
+#else
+  for (Int32 i = 0; i < 2; i += 1) {
+    UInt64 y = x.lane[i];
+    y = ((y & 0x00FF00FF00FF00FFULL) << 8) | ((y >> 8) & 0x00FF00FF00FF00FFULL);
+    y = ((y & 0x0000FFFF0000FFFFULL) << 16) |
+        ((y >> 16) & 0x0000FFFF0000FFFFULL);
+    x.lane[i] = (y << 32) | (y >> 32);
+  }
+  return x;
+#endif
+}
+
+/* Loads two values from a 16-byte buffer in big-endian format. */
+static inline UInt64x2 UInt64x2_LoadBigEndian(const UInt8* source) {
+#if defined(SIMD_SCALAR)
+  UInt64x2 result;
+  UInt64_InitBigEndianBytes(source, &result.lane[0]);
+  UInt64_InitBigEndianBytes(source + 8, &result.lane[1]);
+  return result;
+#else
+  return UInt64x2_ByteSwap(UInt64x2_FromUInt8x16(UInt8x16_Load(source)));
+#endif
+}
+
+/* Stores the two lanes of `x` to a 16-byte buffer in big-endian format. */
+static inline void UInt64x2_StoreBigEndian(UInt8* destination, UInt64x2 x) {
+#if defined(SIMD_SCALAR)
+  UInt64_BigEndianBytes(x.lane[0], destination);
+  UInt64_BigEndianBytes(x.lane[1], destination + 8);
+#else
+  UInt8x16_Store(destination, UInt8x16_FromUInt64x2(UInt64x2_ByteSwap(x)));
+#endif
+}
+#endif /* !defined(__swift__) */
+
 #endif /* Base_h */
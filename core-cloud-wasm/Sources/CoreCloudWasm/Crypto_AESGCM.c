@@ -0,0 +1,782 @@
+//
+//  Crypto_AESGCM.c
+//  core-cloud-wasm
+//
+//  Created by Fang Ling on 2026/10/17.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#include "Crypto_AESGCM.h"
+
+/*
+ * AES-NI and PCLMULQDQ are used when the target has them.  Everywhere else,
+ * including WebAssembly, AES is bitsliced and GHASH uses integer
+ * multiplications; both run in constant time without lookup tables.
+ */
+#if defined(__AES__) && defined(__SSE2__)
+#include <wmmintrin.h>
+
+#define CRYPTO_AES_NI 1
+#endif
+
+#if defined(__PCLMUL__) && defined(__SSSE3__)
+#include <tmmintrin.h>
+#include <wmmintrin.h>
+
+#define CRYPTO_GHASH_PCLMUL 1
+#endif
+
+/* MARK: - Byte Order */
+static UInt32 Crypto_AESGCM_LoadBigEndian32(const UInt8* source) {
+  return ((UInt32)source[0] << 24) |
+         ((UInt32)source[1] << 16) |
+         ((UInt32)source[2] << 8) |
+         ((UInt32)source[3]);
+}
+
+static void Crypto_AESGCM_StoreBigEndian32(UInt32 source, UInt8* destination) {
+  destination[0] = (source >> 24) & 0xFF;
+  destination[1] = (source >> 16) & 0xFF;
+  destination[2] = (source >> 8) & 0xFF;
+  destination[3] = source & 0xFF;
+}
+
+/* MARK: - Bitsliced AES */
+/*
+ * Four blocks are processed at once.  `q[i]` holds bit `i` of all 64 bytes:
+ * bit `16 * b + p` of `q[i]` is bit `i` of byte `p` of block `b`.  Every step
+ * is a fixed sequence of logical operations, so neither the key nor the data
+ * can influence timing or memory access patterns.
+ */
+
+/* Spread a 16-bit mask over the four blocks. */
+#define LANES(x) ((UInt64)(x) * 0x0001000100010001ULL)
+
+/*
+ * Transpose the 8x8 bit matrix whose row `r` is byte `r` (little-endian) of
+ * `x`, so that byte `c` of the result gathers bit `c` of every row.
+ */
+static UInt64 Crypto_AES_Transpose8x8(UInt64 x) {
+  UInt64 t;
+
+  t = (x ^ (x >> 7)) & 0x00AA00AA00AA00AAULL;
+  x ^= t ^ (t << 7);
+  t = (x ^ (x >> 14)) & 0x0000CCCC0000CCCCULL;
+  x ^= t ^ (t << 14);
+  t = (x ^ (x >> 28)) & 0x00000000F0F0F0F0ULL;
+  x ^= t ^ (t << 28);
+  return x;
+}
+
+/* Convert 64 bytes to their bit planes. */
+static void Crypto_AES_Pack(const UInt8 blocks[64], UInt64 q[8]) {
+  for (Int32 i = 0; i < 8; i += 1) {
+    q[i] = 0;
+  }
+
+  for (Int32 w = 0; w < 8; w += 1) {
+    UInt64 x = 0;
+    for (Int32 j = 0; j < 8; j += 1) {
+      x |= (UInt64)blocks[8 * w + j] << (8 * j);
+    }
+    x = Crypto_AES_Transpose8x8(x);
+    for (Int32 i = 0; i < 8; i += 1) {
+      q[i] |= ((x >> (8 * i)) & 0xFF) << (8 * w);
+    }
+  }
+}
+
+/* Convert bit planes back to 64 bytes. */
+static void Crypto_AES_Unpack(const UInt64 q[8], UInt8 blocks[64]) {
+  for (Int32 w = 0; w < 8; w += 1) {
+    UInt64 x = 0;
+    for (Int32 i = 0; i < 8; i += 1) {
+      x |= ((q[i] >> (8 * w)) & 0xFF) << (8 * i);
+    }
+    x = Crypto_AES_Transpose8x8(x);
+    for (Int32 j = 0; j < 8; j += 1) {
+      blocks[8 * w + j] = (x >> (8 * j)) & 0xFF;
+    }
+  }
+}
+
+/*
+ * The S-box as the 113-gate circuit of Boyar and Peralta ("A depth-16 circuit
+ * for the AES S-box", 2011): the multiplicative inverse in GF(2^8) computed
+ * through a tower of subfields, between two linear layers that also fold in
+ * the change of basis and the affine transformation.
+ */
+static void Crypto_AES_SubBytes(UInt64 q[8]) {
+  UInt64 x0 = q[7], x1 = q[6], x2 = q[5], x3 = q[4];
+  UInt64 x4 = q[3], x5 = q[2], x6 = q[1], x7 = q[0];
+  UInt64 y1, y2, y3, y4, y5, y6, y7, y8, y9, y10, y11, y12, y13, y14, y15, y16,
+         y17, y18, y19, y20, y21;
+  UInt64 t0, t1, t2, t3, t4, t5, t6, t7, t8, t9, t10, t11, t12, t13, t14, t15,
+         t16, t17, t18, t19, t20, t21, t22, t23, t24, t25, t26, t27, t28, t29,
+         t30, t31, t32, t33, t34, t35, t36, t37, t38, t39, t40, t41, t42, t43,
+         t44, t45, t46, t47, t48, t49, t50, t51, t52, t53, t54, t55, t56, t57,
+         t58, t59, t60, t61, t62, t63, t64, t65, t66, t67;
+  UInt64 z0, z1, z2, z3, z4, z5, z6, z7, z8, z9, z10, z11, z12, z13, z14, z15,
+         z16, z17;
+  UInt64 s0, s1, s2, s3, s4, s5, s6, s7;
+
+  /* 1. Top linear transformation */
+  y14 = x3 ^ x5;
+  y13 = x0 ^ x6;
+  y9 = x0 ^ x3;
+  y8 = x0 ^ x5;
+  t0 = x1 ^ x2;
+  y1 = t0 ^ x7;
+  y4 = y1 ^ x3;
+  y12 = y13 ^ y14;
+  y2 = y1 ^ x0;
+  y5 = y1 ^ x6;
+  y3 = y5 ^ y8;
+  t1 = x4 ^ y12;
+  y15 = t1 ^ x5;
+  y20 = t1 ^ x1;
+  y6 = y15 ^ x7;
+  y10 = y15 ^ t0;
+  y11 = y20 ^ y9;
+  y7 = x7 ^ y11;
+  y17 = y10 ^ y11;
+  y19 = y10 ^ y8;
+  y16 = t0 ^ y11;
+  y21 = y13 ^ y16;
+  y18 = x0 ^ y16;
+
+  /* 2. Shared non-linear core: inversion in GF(2^4) and the products */
+  t2 = y12 & y15;
+  t3 = y3 & y6;
+  t4 = t3 ^ t2;
+  t5 = y4 & x7;
+  t6 = t5 ^ t2;
+  t7 = y13 & y16;
+  t8 = y5 & y1;
+  t9 = t8 ^ t7;
+  t10 = y2 & y7;
+  t11 = t10 ^ t7;
+  t12 = y9 & y11;
+  t13 = y14 & y17;
+  t14 = t13 ^ t12;
+  t15 = y8 & y10;
+  t16 = t15 ^ t12;
+  t17 = t4 ^ t14;
+  t18 = t6 ^ t16;
+  t19 = t9 ^ t14;
+  t20 = t11 ^ t16;
+  t21 = t17 ^ y20;
+  t22 = t18 ^ y19;
+  t23 = t19 ^ y21;
+  t24 = t20 ^ y18;
+  t25 = t21 ^ t22;
+  t26 = t21 & t23;
+  t27 = t24 ^ t26;
+  t28 = t25 & t27;
+  t29 = t28 ^ t22;
+  t30 = t23 ^ t24;
+  t31 = t22 ^ t26;
+  t32 = t31 & t30;
+  t33 = t32 ^ t24;
+  t34 = t23 ^ t33;
+  t35 = t27 ^ t33;
+  t36 = t24 & t35;
+  t37 = t36 ^ t34;
+  t38 = t27 ^ t36;
+  t39 = t29 & t38;
+  t40 = t25 ^ t39;
+  t41 = t40 ^ t37;
+  t42 = t29 ^ t33;
+  t43 = t29 ^ t40;
+  t44 = t33 ^ t37;
+  t45 = t42 ^ t41;
+  z0 = t44 & y15;
+  z1 = t37 & y6;
+  z2 = t33 & x7;
+  z3 = t43 & y16;
+  z4 = t40 & y1;
+  z5 = t29 & y7;
+  z6 = t42 & y11;
+  z7 = t45 & y17;
+  z8 = t41 & y10;
+  z9 = t44 & y12;
+  z10 = t37 & y3;
+  z11 = t33 & y4;
+  z12 = t43 & y13;
+  z13 = t40 & y5;
+  z14 = t29 & y2;
+  z15 = t42 & y9;
+  z16 = t45 & y14;
+  z17 = t41 & y8;
+
+  /* 3. Bottom linear transformation */
+  t46 = z15 ^ z16;
+  t47 = z10 ^ z11;
+  t48 = z5 ^ z13;
+  t49 = z9 ^ z10;
+  t50 = z2 ^ z12;
+  t51 = z2 ^ z5;
+  t52 = z7 ^ z8;
+  t53 = z0 ^ z3;
+  t54 = z6 ^ z7;
+  t55 = z16 ^ z17;
+  t56 = z12 ^ t48;
+  t57 = t50 ^ t53;
+  t58 = z4 ^ t46;
+  t59 = z3 ^ t54;
+  t60 = t46 ^ t57;
+  t61 = z14 ^ t57;
+  t62 = t52 ^ t58;
+  t63 = t49 ^ t58;
+  t64 = z4 ^ t59;
+  t65 = t61 ^ t62;
+  t66 = z1 ^ t63;
+  s0 = t59 ^ t63;
+  s6 = t56 ^ ~t62;
+  s7 = t48 ^ ~t60;
+  t67 = t64 ^ t65;
+  s3 = t53 ^ t66;
+  s4 = t51 ^ t66;
+  s5 = t47 ^ t65;
+  s1 = t64 ^ ~s3;
+  s2 = t55 ^ ~t67;
+
+  q[7] = s0;
+  q[6] = s1;
+  q[5] = s2;
+  q[4] = s3;
+  q[3] = s4;
+  q[2] = s5;
+  q[1] = s6;
+  q[0] = s7;
+}
+
+#if !defined(CRYPTO_AES_NI)
+/*
+ * Byte `p = 4c + r` of a block sits in row `r` and column `c`; row `r` is
+ * rotated left by `r` columns, i.e. by `4r` bit positions within each block.
+ */
+static void Crypto_AES_ShiftRows(UInt64 q[8]) {
+  for (Int32 i = 0; i < 8; i += 1) {
+    UInt64 x = q[i];
+    q[i] = (x & LANES(0x1111)) |
+           ((x >> 4) & LANES(0x0222)) | ((x << 12) & LANES(0x2000)) |
+           ((x >> 8) & LANES(0x0044)) | ((x << 8) & LANES(0x4400)) |
+           ((x >> 12) & LANES(0x0008)) | ((x << 4) & LANES(0x8880));
+  }
+}
+
+/* Rotate the rows of every column up by one and by two. */
+#define ROT1(x) (((x) >> 1 & LANES(0x7777)) | ((x) << 3 & LANES(0x8888)))
+#define ROT2(x) (((x) >> 2 & LANES(0x3333)) | ((x) << 2 & LANES(0xCCCC)))
+
+/*
+ * b[r] = 2a[r] + 3a[r + 1] + a[r + 2] + a[r + 3]
+ *      = 2t[r] + a[r + 1] + t[r + 2], where t[r] = a[r] + a[r + 1]
+ */
+static void Crypto_AES_MixColumns(UInt64 q[8]) {
+  UInt64 a1[8];
+  UInt64 t[8];
+
+  for (Int32 i = 0; i < 8; i += 1) {
+    a1[i] = ROT1(q[i]);
+    t[i] = q[i] ^ a1[i];
+  }
+
+  /* Multiplication of t by x (0x02), reducing the carry with 0x1B */
+  q[0] = t[7];
+  q[1] = t[0] ^ t[7];
+  q[2] = t[1];
+  q[3] = t[2] ^ t[7];
+  q[4] = t[3] ^ t[7];
+  q[5] = t[4];
+  q[6] = t[5];
+  q[7] = t[6];
+
+  for (Int32 i = 0; i < 8; i += 1) {
+    q[i] ^= a1[i] ^ ROT2(t[i]);
+  }
+}
+
+static void Crypto_AES_AddRoundKey(UInt64 q[8], const UInt64 key[8]) {
+  for (Int32 i = 0; i < 8; i += 1) {
+    q[i] ^= key[i];
+  }
+}
+
+#endif
+
+/* Apply the S-box to the four bytes of a word of the key schedule. */
+static void Crypto_AES_SubWord(UInt8 word[4]) {
+  UInt8 blocks[64] = { 0 };
+  UInt64 q[8];
+
+  memcpy(blocks, word, 4);
+  Crypto_AES_Pack(blocks, q);
+  Crypto_AES_SubBytes(q);
+  Crypto_AES_Unpack(q, blocks);
+  memcpy(word, blocks, 4);
+}
+
+/* MARK: - AES-256 */
+/* Expanded AES-256 key. */
+struct Crypto_AES_Key {
+  /* 15 round keys of 16 bytes */
+  UInt8 bytes[240];
+#if !defined(CRYPTO_AES_NI)
+  /* The same round keys as bit planes, repeated for each of the four blocks */
+  UInt64 planes[15][8];
+#endif
+};
+
+/* AES-256 key expansion (FIPS 197, section 5.2). */
+static void Crypto_AES_Init(struct Crypto_AES_Key* key,
+                            const UInt8 bytes[static 32]) {
+  static const UInt8 RCON[8] = {
+    0x00, 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40
+  };
+
+  memcpy(key->bytes, bytes, 32);
+  for (Int32 i = 8; i < 60; i += 1) {
+    UInt8 word[4];
+    memcpy(word, key->bytes + (i - 1) * 4, 4);
+
+    if (i % 8 == 0) {
+      UInt8 first = word[0];
+      word[0] = word[1];
+      word[1] = word[2];
+      word[2] = word[3];
+      word[3] = first;
+      Crypto_AES_SubWord(word);
+      word[0] ^= RCON[i / 8];
+    } else if (i % 8 == 4) {
+      Crypto_AES_SubWord(word);
+    }
+
+    for (Int32 j = 0; j < 4; j += 1) {
+      key->bytes[i * 4 + j] = key->bytes[(i - 8) * 4 + j] ^ word[j];
+    }
+  }
+
+#if !defined(CRYPTO_AES_NI)
+  for (Int32 r = 0; r < 15; r += 1) {
+    UInt8 blocks[64];
+    for (Int32 b = 0; b < 4; b += 1) {
+      memcpy(blocks + b * 16, key->bytes + r * 16, 16);
+    }
+    Crypto_AES_Pack(blocks, key->planes[r]);
+  }
+#endif
+}
+
+/* Encrypt four consecutive blocks. */
+static void Crypto_AES_Encrypt4(const struct Crypto_AES_Key* key,
+                                const UInt8 input[64],
+                                UInt8 output[64]) {
+#if defined(CRYPTO_AES_NI)
+  __m128i k = _mm_loadu_si128((const __m128i*)key->bytes);
+  __m128i b0 = _mm_xor_si128(_mm_loadu_si128((const __m128i*)input), k);
+  __m128i b1 = _mm_xor_si128(_mm_loadu_si128((const __m128i*)input + 1), k);
+  __m128i b2 = _mm_xor_si128(_mm_loadu_si128((const __m128i*)input + 2), k);
+  __m128i b3 = _mm_xor_si128(_mm_loadu_si128((const __m128i*)input + 3), k);
+
+  for (Int32 r = 1; r < 14; r += 1) {
+    k = _mm_loadu_si128((const __m128i*)(key->bytes + r * 16));
+    b0 = _mm_aesenc_si128(b0, k);
+    b1 = _mm_aesenc_si128(b1, k);
+    b2 = _mm_aesenc_si128(b2, k);
+    b3 = _mm_aesenc_si128(b3, k);
+  }
+
+  k = _mm_loadu_si128((const __m128i*)(key->bytes + 14 * 16));
+  _mm_storeu_si128((__m128i*)output, _mm_aesenclast_si128(b0, k));
+  _mm_storeu_si128((__m128i*)output + 1, _mm_aesenclast_si128(b1, k));
+  _mm_storeu_si128((__m128i*)output + 2, _mm_aesenclast_si128(b2, k));
+  _mm_storeu_si128((__m128i*)output + 3, _mm_aesenclast_si128(b3, k));
+#else
+  UInt64 q[8];
+
+  Crypto_AES_Pack(input, q);
+  Crypto_AES_AddRoundKey(q, key->planes[0]);
+  for (Int32 r = 1; r < 14; r += 1) {
+    Crypto_AES_SubBytes(q);
+    Crypto_AES_ShiftRows(q);
+    Crypto_AES_MixColumns(q);
+    Crypto_AES_AddRoundKey(q, key->planes[r]);
+  }
+  Crypto_AES_SubBytes(q);
+  Crypto_AES_ShiftRows(q);
+  Crypto_AES_AddRoundKey(q, key->planes[14]);
+  Crypto_AES_Unpack(q, output);
+#endif
+}
+
+/* MARK: - GHASH */
+/* GHASH over GF(2^128), keeping blocks as big-endian 64-bit halves. */
+struct Crypto_GHASH {
+  /* The hash key H */
+  UInt64 h[2];
+  /* The running value Y */
+  UInt64 y[2];
+};
+
+#if defined(CRYPTO_GHASH_PCLMUL)
+/* Reverse the bytes of a block, GHASH's bit order maps onto PCLMULQDQ's. */
+#define BSWAP128(x) _mm_shuffle_epi8( \
+  x, \
+  _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15) \
+)
+
+/*
+ * Carry-less multiplication and reduction of byte-reversed blocks, as in
+ * Intel's "Carry-Less Multiplication Instruction and its Usage for Computing
+ * the GCM Mode" white paper.
+ */
+static __m128i Crypto_GHASH_Multiply(__m128i a, __m128i b) {
+  __m128i t2;
+  __m128i t3 = _mm_clmulepi64_si128(a, b, 0x00);
+  __m128i t4 = _mm_clmulepi64_si128(a, b, 0x10);
+  __m128i t5 = _mm_clmulepi64_si128(a, b, 0x01);
+  __m128i t6 = _mm_clmulepi64_si128(a, b, 0x11);
+  __m128i t7;
+  __m128i t8;
+  __m128i t9;
+
+  /* 1. 256-bit product t6:t3 */
+  t4 = _mm_xor_si128(t4, t5);
+  t5 = _mm_slli_si128(t4, 8);
+  t4 = _mm_srli_si128(t4, 8);
+  t3 = _mm_xor_si128(t3, t5);
+  t6 = _mm_xor_si128(t6, t4);
+
+  /* 2. Shift the product left by one bit for the reflected bit order */
+  t7 = _mm_srli_epi32(t3, 31);
+  t8 = _mm_srli_epi32(t6, 31);
+  t3 = _mm_slli_epi32(t3, 1);
+  t6 = _mm_slli_epi32(t6, 1);
+  t9 = _mm_srli_si128(t7, 12);
+  t8 = _mm_slli_si128(t8, 4);
+  t7 = _mm_slli_si128(t7, 4);
+  t3 = _mm_or_si128(t3, t7);
+  t6 = _mm_or_si128(t6, t8);
+  t6 = _mm_or_si128(t6, t9);
+
+  /* 3. Reduce modulo x^128 + x^7 + x^2 + x + 1 */
+  t7 = _mm_slli_epi32(t3, 31);
+  t8 = _mm_slli_epi32(t3, 30);
+  t9 = _mm_slli_epi32(t3, 25);
+  t7 = _mm_xor_si128(t7, t8);
+  t7 = _mm_xor_si128(t7, t9);
+  t8 = _mm_srli_si128(t7, 4);
+  t7 = _mm_slli_si128(t7, 12);
+  t3 = _mm_xor_si128(t3, t7);
+
+  t2 = _mm_srli_epi32(t3, 1);
+  t4 = _mm_srli_epi32(t3, 2);
+  t5 = _mm_srli_epi32(t3, 7);
+  t2 = _mm_xor_si128(t2, t4);
+  t2 = _mm_xor_si128(t2, t5);
+  t2 = _mm_xor_si128(t2, t8);
+  t3 = _mm_xor_si128(t3, t2);
+  return _mm_xor_si128(t6, t3);
+}
+#else
+/*
+ * Carry-less 64x64 multiplication, low half.  Only every fourth bit of each
+ * operand takes part in an integer multiplication, which leaves enough room
+ * between the bits that carries never reach a bit that is kept.
+ */
+static UInt64 Crypto_GHASH_MultiplyLow(UInt64 x, UInt64 y) {
+  const UInt64 m0 = 0x1111111111111111ULL;
+  const UInt64 m1 = 0x2222222222222222ULL;
+  const UInt64 m2 = 0x4444444444444444ULL;
+  const UInt64 m3 = 0x8888888888888888ULL;
+
+  UInt64 x0 = x & m0;
+  UInt64 x1 = x & m1;
+  UInt64 x2 = x & m2;
+  UInt64 x3 = x & m3;
+  UInt64 y0 = y & m0;
+  UInt64 y1 = y & m1;
+  UInt64 y2 = y & m2;
+  UInt64 y3 = y & m3;
+
+  UInt64 z0 = (x0 * y0) ^ (x1 * y3) ^ (x2 * y2) ^ (x3 * y1);
+  UInt64 z1 = (x0 * y1) ^ (x1 * y0) ^ (x2 * y3) ^ (x3 * y2);
+  UInt64 z2 = (x0 * y2) ^ (x1 * y1) ^ (x2 * y0) ^ (x3 * y3);
+  UInt64 z3 = (x0 * y3) ^ (x1 * y2) ^ (x2 * y1) ^ (x3 * y0);
+
+  return (z0 & m0) | (z1 & m1) | (z2 & m2) | (z3 & m3);
+}
+
+/* Reverse the bits of a 64-bit integer. */
+static UInt64 Crypto_GHASH_Reverse(UInt64 x) {
+  x = ((x & 0x5555555555555555ULL) << 1) | ((x >> 1) & 0x5555555555555555ULL);
+  x = ((x & 0x3333333333333333ULL) << 2) | ((x >> 2) & 0x3333333333333333ULL);
+  x = ((x & 0x0F0F0F0F0F0F0F0FULL) << 4) | ((x >> 4) & 0x0F0F0F0F0F0F0F0FULL);
+  x = ((x & 0x00FF00FF00FF00FFULL) << 8) | ((x >> 8) & 0x00FF00FF00FF00FFULL);
+  x = ((x & 0x0000FFFF0000FFFFULL) << 16) |
+      ((x >> 16) & 0x0000FFFF0000FFFFULL);
+  return (x << 32) | (x >> 32);
+}
+
+/*
+ * Y = Y * H in GF(2^128), with Karatsuba over 64-bit halves.  The high half
+ * of each 64x64 product is the bit-reversed low half of the product of the
+ * bit-reversed operands.
+ */
+static void Crypto_GHASH_Multiply(UInt64 y[2], const UInt64 h[2]) {
+  UInt64 y1 = y[0];
+  UInt64 y0 = y[1];
+  UInt64 h1 = h[0];
+  UInt64 h0 = h[1];
+  UInt64 y2 = y0 ^ y1;
+  UInt64 h2 = h0 ^ h1;
+  UInt64 y0r = Crypto_GHASH_Reverse(y0);
+  UInt64 y1r = Crypto_GHASH_Reverse(y1);
+  UInt64 y2r = y0r ^ y1r;
+  UInt64 h0r = Crypto_GHASH_Reverse(h0);
+  UInt64 h1r = Crypto_GHASH_Reverse(h1);
+  UInt64 h2r = h0r ^ h1r;
+
+  /* 1. 256-bit product v3:v2:v1:v0 in the reflected bit order */
+  UInt64 z0 = Crypto_GHASH_MultiplyLow(y0, h0);
+  UInt64 z1 = Crypto_GHASH_MultiplyLow(y1, h1);
+  UInt64 z2 = Crypto_GHASH_MultiplyLow(y2, h2);
+  UInt64 z0h = Crypto_GHASH_MultiplyLow(y0r, h0r);
+  UInt64 z1h = Crypto_GHASH_MultiplyLow(y1r, h1r);
+  UInt64 z2h = Crypto_GHASH_MultiplyLow(y2r, h2r);
+  z2 ^= z0 ^ z1;
+  z2h ^= z0h ^ z1h;
+  z0h = Crypto_GHASH_Reverse(z0h) >> 1;
+  z1h = Crypto_GHASH_Reverse(z1h) >> 1;
+  z2h = Crypto_GHASH_Reverse(z2h) >> 1;
+
+  UInt64 v0 = z0;
+  UInt64 v1 = z0h ^ z2;
+  UInt64 v2 = z1 ^ z2h;
+  UInt64 v3 = z1h;
+
+  /* 2. Shift left by one bit */
+  v3 = (v3 << 1) | (v2 >> 63);
+  v2 = (v2 << 1) | (v1 >> 63);
+  v1 = (v1 << 1) | (v0 >> 63);
+  v0 = (v0 << 1);
+
+  /* 3. Reduce modulo x^128 + x^7 + x^2 + x + 1 */
+  v2 ^= v0 ^ (v0 >> 1) ^ (v0 >> 2) ^ (v0 >> 7);
+  v1 ^= (v0 << 63) ^ (v0 << 62) ^ (v0 << 57);
+  v3 ^= v1 ^ (v1 >> 1) ^ (v1 >> 2) ^ (v1 >> 7);
+  v2 ^= (v1 << 63) ^ (v1 << 62) ^ (v1 << 57);
+
+  y[0] = v3;
+  y[1] = v2;
+}
+#endif
+
+static void Crypto_GHASH_Init(struct Crypto_GHASH* ghash,
+                              const UInt8 h[static 16]) {
+  UInt64_InitBigEndianBytes(h, &ghash->h[0]);
+  UInt64_InitBigEndianBytes(h + 8, &ghash->h[1]);
+  ghash->y[0] = ghash->y[1] = 0;
+}
+
+/* Absorb `count` bytes, padding the last partial block with zeroes. */
+static void Crypto_GHASH_Update(struct Crypto_GHASH* ghash,
+                                const UInt8* buffer,
+                                Int64 count) {
+  UInt8 block[16];
+
+#if defined(CRYPTO_GHASH_PCLMUL)
+  __m128i h = _mm_set_epi64x((long long)ghash->h[0], (long long)ghash->h[1]);
+  __m128i y = _mm_set_epi64x((long long)ghash->y[0], (long long)ghash->y[1]);
+
+  for (Int64 offset = 0; offset < count; offset += 16) {
+    if (count - offset < 16) {
+      memset(block, 0, 16);
+      memcpy(block, buffer + offset, count - offset);
+    } else {
+      memcpy(block, buffer + offset, 16);
+    }
+    __m128i x = BSWAP128(_mm_loadu_si128((const __m128i*)block));
+    y = Crypto_GHASH_Multiply(_mm_xor_si128(y, x), h);
+  }
+
+  ghash->y[0] = (UInt64)_mm_cvtsi128_si64(_mm_srli_si128(y, 8));
+  ghash->y[1] = (UInt64)_mm_cvtsi128_si64(y);
+#else
+  for (Int64 offset = 0; offset < count; offset += 16) {
+    UInt64 x[2];
+    if (count - offset < 16) {
+      memset(block, 0, 16);
+      memcpy(block, buffer + offset, count - offset);
+    } else {
+      memcpy(block, buffer + offset, 16);
+    }
+    UInt64_InitBigEndianBytes(block, &x[0]);
+    UInt64_InitBigEndianBytes(block + 8, &x[1]);
+    ghash->y[0] ^= x[0];
+    ghash->y[1] ^= x[1];
+    Crypto_GHASH_Multiply(ghash->y, ghash->h);
+  }
+#endif
+}
+
+/* MARK: - GCM */
+/*
+ * Shared state of a GCM operation with a 96-bit nonce: the expanded key, the
+ * pre-counter block J0 = nonce || 0^31 || 1, and GHASH keyed with
+ * H = AES(K, 0^128).
+ */
+struct Crypto_AESGCM {
+  struct Crypto_AES_Key key;
+  UInt8 counter[16];
+  struct Crypto_GHASH ghash;
+};
+
+static void Crypto_AESGCM_Init(struct Crypto_AESGCM* gcm,
+                               const UInt8 key[static 32],
+                               const UInt8 nonce[static 12]) {
+  UInt8 blocks[64] = { 0 };
+
+  Crypto_AES_Init(&gcm->key, key);
+  Crypto_AES_Encrypt4(&gcm->key, blocks, blocks);
+  Crypto_GHASH_Init(&gcm->ghash, blocks);
+
+  memcpy(gcm->counter, nonce, 12);
+  Crypto_AESGCM_StoreBigEndian32(1, gcm->counter + 12);
+}
+
+/* Encrypt or decrypt with the counters that follow J0. */
+static void Crypto_AESGCM_CTR(const struct Crypto_AESGCM* gcm,
+                              const UInt8* input,
+                              Int64 count,
+                              UInt8* output) {
+  UInt8 counters[64];
+  UInt8 stream[64];
+  UInt32 counter = Crypto_AESGCM_LoadBigEndian32(gcm->counter + 12);
+
+  for (Int32 b = 0; b < 4; b += 1) {
+    memcpy(counters + b * 16, gcm->counter, 12);
+  }
+
+  for (Int64 offset = 0; offset < count; offset += 64) {
+    for (Int32 b = 0; b < 4; b += 1) {
+      counter += 1;
+      Crypto_AESGCM_StoreBigEndian32(counter, counters + b * 16 + 12);
+    }
+    Crypto_AES_Encrypt4(&gcm->key, counters, stream);
+
+    Int64 n = count - offset < 64 ? count - offset : 64;
+    for (Int64 i = 0; i < n; i += 1) {
+      output[offset + i] = input[offset + i] ^ stream[i];
+    }
+  }
+}
+
+/* Authenticate the additional data and the ciphertext. */
+static void Crypto_AESGCM_Tag(struct Crypto_AESGCM* gcm,
+                              const UInt8* authenticatedData,
+                              Int64 authenticatedDataCount,
+                              const UInt8* ciphertext,
+                              Int64 count,
+                              UInt8 tag[static 16]) {
+  UInt8 lengths[16];
+  UInt8 blocks[64] = { 0 };
+
+  /* 1. S = GHASH(A || 0^v || C || 0^u || [len(A)]64 || [len(C)]64) */
+  Crypto_GHASH_Update(&gcm->ghash, authenticatedData, authenticatedDataCount);
+  Crypto_GHASH_Update(&gcm->ghash, ciphertext, count);
+  UInt64_BigEndianBytes((UInt64)authenticatedDataCount * 8, lengths);
+  UInt64_BigEndianBytes((UInt64)count * 8, lengths + 8);
+  Crypto_GHASH_Update(&gcm->ghash, lengths, 16);
+
+  /* 2. T = AES(K, J0) ^ S */
+  memcpy(blocks, gcm->counter, 16);
+  Crypto_AES_Encrypt4(&gcm->key, blocks, blocks);
+  UInt64_BigEndianBytes(gcm->ghash.y[0], tag);
+  UInt64_BigEndianBytes(gcm->ghash.y[1], tag + 8);
+  for (Int32 i = 0; i < 16; i += 1) {
+    tag[i] ^= blocks[i];
+  }
+}
+
+void Crypto_AESGCM_Seal(const UInt8 key[static 32],
+                        const UInt8 nonce[static Crypto_AESGCM_NonceSize],
+                        const UInt8* plaintext,
+                        Int64 count,
+                        const UInt8* authenticatedData,
+                        Int64 authenticatedDataCount,
+                        UInt8* combined) {
+  struct Crypto_AESGCM gcm;
+  UInt8* ciphertext = combined + Crypto_AESGCM_NonceSize;
+
+  Crypto_AESGCM_Init(&gcm, key, nonce);
+
+  memcpy(combined, nonce, Crypto_AESGCM_NonceSize);
+  Crypto_AESGCM_CTR(&gcm, plaintext, count, ciphertext);
+  Crypto_AESGCM_Tag(
+    &gcm,
+    authenticatedData,
+    authenticatedDataCount,
+    ciphertext,
+    count,
+    ciphertext + count
+  );
+
+  /* Clear the key schedule */
+  memset(&gcm, 0, sizeof(gcm));
+}
+
+Bool Crypto_AESGCM_Open(const UInt8 key[static 32],
+                        const UInt8* combined,
+                        Int64 count,
+                        const UInt8* authenticatedData,
+                        Int64 authenticatedDataCount,
+                        UInt8* plaintext) {
+  struct Crypto_AESGCM gcm;
+  UInt8 tag[Crypto_AESGCM_TagSize];
+  UInt8 difference = 0;
+
+  if (count < Crypto_AESGCM_NonceSize + Crypto_AESGCM_TagSize) {
+    return false;
+  }
+
+  const UInt8* ciphertext = combined + Crypto_AESGCM_NonceSize;
+  count -= Crypto_AESGCM_NonceSize + Crypto_AESGCM_TagSize;
+
+  Crypto_AESGCM_Init(&gcm, key, combined);
+
+  /* Verify the tag before releasing any plaintext */
+  Crypto_AESGCM_Tag(
+    &gcm,
+    authenticatedData,
+    authenticatedDataCount,
+    ciphertext,
+    count,
+    tag
+  );
+  for (Int32 i = 0; i < Crypto_AESGCM_TagSize; i += 1) {
+    difference |= tag[i] ^ ciphertext[count + i];
+  }
+
+  if (difference == 0) {
+    Crypto_AESGCM_CTR(&gcm, ciphertext, count, plaintext);
+  }
+
+  /* Clear the key schedule */
+  memset(&gcm, 0, sizeof(gcm));
+
+  return difference == 0;
+}
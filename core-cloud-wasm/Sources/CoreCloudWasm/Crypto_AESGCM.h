@@ -0,0 +1,90 @@
+//
+//  Crypto_AESGCM.h
+//  core-cloud-wasm
+//
+//  Created by Fang Ling on 2026/10/17.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#ifndef Crypto_AESGCM_h
+#define Crypto_AESGCM_h
+
+#include "Base.h"
+
+/**
+ * The number of bytes in an AES-GCM nonce.
+ */
+#define Crypto_AESGCM_NonceSize 12
+
+/**
+ * The number of bytes in an AES-GCM authentication tag.
+ */
+#define Crypto_AESGCM_TagSize 16
+
+/**
+ * Secures a message with AES-256 in Galois/Counter Mode (GCM).
+ *
+ * The output uses the combined representation of a sealed box: the nonce,
+ * followed by the ciphertext, followed by the tag. It is byte-for-byte the
+ * same as the `combined` property of `AES.GCM.SealedBox` in CryptoKit and
+ * swift-crypto, and therefore as the chunks of a `.sealedbox` file.
+ *
+ * The nonce must never be reused with the same key. This library has no
+ * source of randomness; generate the nonce with a cryptographically secure
+ * random number generator, such as `crypto.getRandomValues()`.
+ *
+ * - Parameters:
+ *   - key: A 256-bit key.
+ *   - nonce: A 96-bit nonce.
+ *   - plaintext: The data to seal.
+ *   - count: The number of bytes in the plaintext.
+ *   - authenticatedData: Additional data to authenticate without sealing, or
+ *                        `NULL` if there is none.
+ *   - authenticatedDataCount: The number of bytes of additional data.
+ *   - combined: A buffer of `count + 28` bytes to store the sealed box.
+ */
+void Crypto_AESGCM_Seal(const UInt8 key[static 32],
+                        const UInt8 nonce[static Crypto_AESGCM_NonceSize],
+                        const UInt8* plaintext,
+                        Int64 count,
+                        const UInt8* authenticatedData,
+                        Int64 authenticatedDataCount,
+                        UInt8* combined);
+
+/**
+ * Decrypts the message and verifies the authenticity of a sealed box.
+ *
+ * The tag is checked in constant time before any plaintext is produced. When
+ * the check fails, the plaintext buffer is left untouched.
+ *
+ * - Parameters:
+ *   - key: The 256-bit key that was used to seal the message.
+ *   - combined: The combined representation of the sealed box.
+ *   - count: The number of bytes in the sealed box, at least 28.
+ *   - authenticatedData: The additional data that was authenticated when
+ *                        sealing, or `NULL` if there is none.
+ *   - authenticatedDataCount: The number of bytes of additional data.
+ *   - plaintext: A buffer of `count - 28` bytes to store the decrypted data.
+ *
+ * - Returns: `true` if the sealed box is authentic and was decrypted;
+ *   otherwise, `false`.
+ */
+Bool Crypto_AESGCM_Open(const UInt8 key[static 32],
+                        const UInt8* combined,
+                        Int64 count,
+                        const UInt8* authenticatedData,
+                        Int64 authenticatedDataCount,
+                        UInt8* plaintext);
+
+#endif /* Crypto_AESGCM_h */
@@ -0,0 +1,336 @@
+//
+//  Crypto_HMAC.c
+//  core-cloud-wasm
+//
+//  Created by Fang Ling on 2026/10/17.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#include "Crypto_HMAC.h"
+#include "Crypto_SHA512_Private.h"
+#include "TaskPool_Private.h"
+
+/* MARK: - HMAC */
+/* SHA512 states after H(K ^ ipad) and H(K ^ opad) have absorbed one block */
+struct Crypto_HMAC_SHA512_Key {
+  struct Crypto_SHA512_Context inner;
+  struct Crypto_SHA512_Context outer;
+};
+
+static void Crypto_HMAC_SHA512_InitKey(struct Crypto_HMAC_SHA512_Key* key,
+                                       const UInt8* bytes,
+                                       Int64 count) {
+  UInt8 block[128] = { 0 };
+
+  /* 1. K0: the key, or its digest if it is longer than a block, padded */
+  if (count > 128) {
+    Crypto_SHA512_Hash(bytes, count, block);
+  } else if (count > 0) {
+    memcpy(block, bytes, count);
+  }
+
+  /* 2. Absorb K0 ^ ipad */
+  for (Int32 i = 0; i < 128; i += 1) {
+    block[i] ^= 0x36;
+  }
+  Crypto_SHA512_Init(&key->inner);
+  Crypto_SHA512_Update(&key->inner, block, 128);
+
+  /* 3. Absorb K0 ^ opad */
+  for (Int32 i = 0; i < 128; i += 1) {
+    block[i] ^= 0x36 ^ 0x5C;
+  }
+  Crypto_SHA512_Init(&key->outer);
+  Crypto_SHA512_Update(&key->outer, block, 128);
+
+  memset(block, 0, sizeof(block));
+}
+
+/* H(K0 ^ opad || H(K0 ^ ipad || text)), given the inner hash of the text */
+static void Crypto_HMAC_SHA512_Finalize(
+  const struct Crypto_HMAC_SHA512_Key* key,
+  struct Crypto_SHA512_Context* inner,
+  UInt8 code[static 64]
+) {
+  struct Crypto_SHA512_Context outer = key->outer;
+  UInt8 digest[64];
+
+  Crypto_SHA512_Finalize(inner, digest);
+  Crypto_SHA512_Update(&outer, digest, 64);
+  Crypto_SHA512_Finalize(&outer, code);
+
+  memset(digest, 0, sizeof(digest));
+}
+
+struct Crypto_HMAC_SHA512_Key* Crypto_HMAC_SHA512_CreateKey(const UInt8* key,
+                                                            Int64 count) {
+  struct Crypto_HMAC_SHA512_Key* result = Memory_SlabAllocate(
+    sizeof(struct Crypto_HMAC_SHA512_Key)
+  );
+  if (result == NULL) {
+    return NULL;
+  }
+
+  Crypto_HMAC_SHA512_InitKey(result, key, count);
+  return result;
+}
+
+void Crypto_HMAC_SHA512_DestroyKey(struct Crypto_HMAC_SHA512_Key* key) {
+  if (key == NULL) {
+    return;
+  }
+
+  memset(key, 0, sizeof(*key));
+  Memory_SlabFree(key);
+}
+
+void Crypto_HMAC_SHA512_Authenticate(const struct Crypto_HMAC_SHA512_Key* key,
+                                     const UInt8* message,
+                                     Int64 count,
+                                     UInt8 code[static 64]) {
+  struct Crypto_SHA512_Context inner = key->inner;
+
+  Crypto_SHA512_Update(&inner, message, count);
+  Crypto_HMAC_SHA512_Finalize(key, &inner, code);
+}
+
+Bool Crypto_HMAC_SHA512_Verify(const struct Crypto_HMAC_SHA512_Key* key,
+                               const UInt8* message,
+                               Int64 count,
+                               const UInt8 code[static 64]) {
+  UInt8 expected[64];
+  UInt8 difference = 0;
+
+  Crypto_HMAC_SHA512_Authenticate(key, message, count, expected);
+  for (Int32 i = 0; i < 64; i += 1) {
+    difference |= expected[i] ^ code[i];
+  }
+  return difference == 0;
+}
+
+void Crypto_HMAC_SHA512(const UInt8* key,
+                        Int64 keyCount,
+                        const UInt8* message,
+                        Int64 count,
+                        UInt8 code[static 64]) {
+  struct Crypto_HMAC_SHA512_Key hmac;
+
+  Crypto_HMAC_SHA512_InitKey(&hmac, key, keyCount);
+  Crypto_HMAC_SHA512_Authenticate(&hmac, message, count, code);
+  memset(&hmac, 0, sizeof(hmac));
+}
+
+/* MARK: - HKDF */
+/* PRK = HMAC-Hash(salt, IKM) */
+void Crypto_HKDF_SHA512_Extract(const UInt8* salt,
+                                Int64 saltCount,
+                                const UInt8* inputKeyMaterial,
+                                Int64 count,
+                                UInt8 pseudoRandomKey[static 64]) {
+  /* An empty salt pads to the same block as HashLen zero bytes. */
+  Crypto_HMAC_SHA512(salt, saltCount, inputKeyMaterial, count, pseudoRandomKey);
+}
+
+/* T(i) = HMAC-Hash(PRK, T(i - 1) || info || i), OKM = T(1) || T(2) || ... */
+Bool Crypto_HKDF_SHA512_Expand(
+  const struct Crypto_HMAC_SHA512_Key* pseudoRandomKey,
+  const UInt8* info,
+  Int64 infoCount,
+  UInt8* outputKeyMaterial,
+  Int64 count
+) {
+  UInt8 block[64];
+
+  if (count < 0 || count > Crypto_HKDF_SHA512_MaximumCount) {
+    return false;
+  }
+
+  for (Int64 offset = 0; offset < count; offset += 64) {
+    struct Crypto_SHA512_Context inner = pseudoRandomKey->inner;
+    UInt8 i = offset / 64 + 1;
+
+    if (offset > 0) {
+      Crypto_SHA512_Update(&inner, block, 64);
+    }
+    if (infoCount > 0) {
+      Crypto_SHA512_Update(&inner, info, infoCount);
+    }
+    Crypto_SHA512_Update(&inner, &i, 1);
+    Crypto_HMAC_SHA512_Finalize(pseudoRandomKey, &inner, block);
+
+    Int64 n = count - offset < 64 ? count - offset : 64;
+    memcpy(outputKeyMaterial + offset, block, n);
+  }
+
+  memset(block, 0, sizeof(block));
+  return true;
+}
+
+Bool Crypto_HKDF_SHA512(const UInt8* salt,
+                        Int64 saltCount,
+                        const UInt8* inputKeyMaterial,
+                        Int64 inputKeyMaterialCount,
+                        const UInt8* info,
+                        Int64 infoCount,
+                        UInt8* outputKeyMaterial,
+                        Int64 count) {
+  struct Crypto_HMAC_SHA512_Key key;
+  UInt8 pseudoRandomKey[64];
+  Bool result;
+
+  Crypto_HKDF_SHA512_Extract(
+    salt,
+    saltCount,
+    inputKeyMaterial,
+    inputKeyMaterialCount,
+    pseudoRandomKey
+  );
+  Crypto_HMAC_SHA512_InitKey(&key, pseudoRandomKey, 64);
+  result = Crypto_HKDF_SHA512_Expand(
+    &key,
+    info,
+    infoCount,
+    outputKeyMaterial,
+    count
+  );
+
+  memset(pseudoRandomKey, 0, sizeof(pseudoRandomKey));
+  memset(&key, 0, sizeof(key));
+  return result;
+}
+
+/* MARK: - PBKDF2 */
+/*
+ * Runs the iterations 2 through `iterations` of up to four output blocks at
+ * once.  Each U_j = HMAC(P, U_{j - 1}) is exactly two fixed-length
+ * compressions, starting from the cached pad states.
+ */
+static void Crypto_PBKDF2_SHA512_Iterate(
+  const struct Crypto_HMAC_SHA512_Key* key,
+  UInt64 U[4][8],
+  UInt64 T[4][8],
+  Int32 lanes,
+  Int64 iterations
+) {
+  UInt64 inner[4][8];
+  UInt64 outer[4][8];
+  UInt64* innerStates[4] = { inner[0], inner[1], inner[2], inner[3] };
+  UInt64* outerStates[4] = { outer[0], outer[1], outer[2], outer[3] };
+  const UInt64* innerMessages[4] = { U[0], U[1], U[2], U[3] };
+  const UInt64* outerMessages[4] = { inner[0], inner[1], inner[2], inner[3] };
+
+  for (Int64 iteration = 1; iteration < iterations; iteration += 1) {
+    for (Int32 j = 0; j < 4; j += 1) {
+      memcpy(inner[j], key->inner.state, 64);
+      memcpy(outer[j], key->outer.state, 64);
+    }
+
+    if (lanes == 1) {
+      Crypto_SHA512_Transform64(inner[0], U[0]);
+      Crypto_SHA512_Transform64(outer[0], inner[0]);
+    } else {
+      Crypto_SHA512_Transform64x4(innerStates, innerMessages);
+      Crypto_SHA512_Transform64x4(outerStates, outerMessages);
+    }
+
+    for (Int32 j = 0; j < lanes; j += 1) {
+      for (Int32 i = 0; i < 8; i += 1) {
+        U[j][i] = outer[j][i];
+        T[j][i] ^= outer[j][i];
+      }
+    }
+  }
+
+  memset(inner, 0, sizeof(inner));
+  memset(outer, 0, sizeof(outer));
+}
+
+/* The arguments of `Crypto_PBKDF2_SHA512()` */
+struct Crypto_PBKDF2_SHA512_Task {
+  const struct Crypto_HMAC_SHA512_Key* key;
+  const UInt8* salt;
+  Int64 saltCount;
+  Int64 iterations;
+  UInt8* derivedKey;
+  Int64 count;
+};
+
+/* Derives the four output blocks from `4 * index` on, or as many as remain. */
+static void Crypto_PBKDF2_SHA512_Derive(void* context, Int64 index) {
+  const struct Crypto_PBKDF2_SHA512_Task* task = context;
+  const struct Crypto_HMAC_SHA512_Key* key = task->key;
+  UInt64 U[4][8] = { { 0 } };
+  UInt64 T[4][8];
+  UInt8 block[64];
+
+  const Int64 first = index * 4;
+  Int64 remaining = (task->count - first * 64 + 63) / 64;
+  Int32 lanes = remaining < 4 ? (Int32)remaining : 4;
+
+  /* 1. U_1 = HMAC(P, S || INT(i)) */
+  for (Int32 j = 0; j < lanes; j += 1) {
+    struct Crypto_SHA512_Context inner = key->inner;
+    UInt32 i = (UInt32)(first + j + 1);
+    UInt8 counter[4] = { i >> 24, (i >> 16) & 0xFF, (i >> 8) & 0xFF, i & 0xFF };
+
+    if (task->saltCount > 0) {
+      Crypto_SHA512_Update(&inner, task->salt, task->saltCount);
+    }
+    Crypto_SHA512_Update(&inner, counter, 4);
+    Crypto_HMAC_SHA512_Finalize(key, &inner, block);
+
+    UInt64_BigEndianLoadArray(block, U[j], 8);
+    memcpy(T[j], U[j], 64);
+  }
+
+  /* 2. T_i = U_1 ^ U_2 ^ ... ^ U_c */
+  Crypto_PBKDF2_SHA512_Iterate(key, U, T, lanes, task->iterations);
+
+  for (Int32 j = 0; j < lanes; j += 1) {
+    Int64 offset = (first + j) * 64;
+    Int64 n = task->count - offset < 64 ? task->count - offset : 64;
+
+    UInt64_BigEndianStoreArray(T[j], block, 8);
+    memcpy(task->derivedKey + offset, block, n);
+  }
+
+  memset(U, 0, sizeof(U));
+  memset(T, 0, sizeof(T));
+  memset(block, 0, sizeof(block));
+}
+
+Bool Crypto_PBKDF2_SHA512(const UInt8* password,
+                          Int64 passwordCount,
+                          const UInt8* salt,
+                          Int64 saltCount,
+                          Int64 iterations,
+                          UInt8* derivedKey,
+                          Int64 count) {
+  struct Crypto_HMAC_SHA512_Key key;
+
+  if (iterations < 1 || count < 0) {
+    return false;
+  }
+
+  Crypto_HMAC_SHA512_InitKey(&key, password, passwordCount);
+
+  /* Output blocks are independent; derive up to four of them per task. */
+  struct Crypto_PBKDF2_SHA512_Task task = {
+    &key, salt, saltCount, iterations, derivedKey, count
+  };
+  TaskPoolApply((count + 255) / 256, &task, Crypto_PBKDF2_SHA512_Derive);
+
+  memset(&key, 0, sizeof(key));
+  return true;
+}
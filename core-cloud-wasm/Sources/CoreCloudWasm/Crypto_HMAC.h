@@ -0,0 +1,212 @@
+//
+//  Crypto_HMAC.h
+//  core-cloud-wasm
+//
+//  Created by Fang Ling on 2026/10/17.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#ifndef Crypto_HMAC_h
+#define Crypto_HMAC_h
+
+#include "Base.h"
+
+/* MARK: - HMAC */
+/**
+ * A key for HMAC-SHA512 message authentication (RFC 2104).
+ *
+ * The key holds the SHA512 states after absorbing the inner and outer padded
+ * key blocks. Every message authenticated with it therefore skips the two
+ * compressions that a one-shot HMAC spends on the key.
+ */
+struct Crypto_HMAC_SHA512_Key;
+
+/**
+ * Creates an HMAC-SHA512 key.
+ *
+ * - Parameters:
+ *   - key: The secret key. Keys longer than 128 bytes are hashed first.
+ *   - count: The number of bytes in the key.
+ *
+ * - Returns: A new HMAC-SHA512 key, or `NULL` if the memory could not be
+ *   allocated. Release it with ``Crypto_HMAC_SHA512_DestroyKey()``.
+ */
+struct Crypto_HMAC_SHA512_Key* Crypto_HMAC_SHA512_CreateKey(const UInt8* key,
+                                                            Int64 count);
+
+/**
+ * Destroys an HMAC-SHA512 key and clears its state.
+ *
+ * - Parameter key: An HMAC-SHA512 key, or `NULL`.
+ */
+void Crypto_HMAC_SHA512_DestroyKey(struct Crypto_HMAC_SHA512_Key* key);
+
+/**
+ * Computes the message authentication code of a message.
+ *
+ * - Parameters:
+ *   - key: An HMAC-SHA512 key.
+ *   - message: The message to authenticate.
+ *   - count: The number of bytes in the message.
+ *   - code: A buffer to store the 64-byte authentication code.
+ */
+void Crypto_HMAC_SHA512_Authenticate(const struct Crypto_HMAC_SHA512_Key* key,
+                                     const UInt8* message,
+                                     Int64 count,
+                                     UInt8 code[static 64]);
+
+/**
+ * Checks the message authentication code of a message in constant time.
+ *
+ * - Parameters:
+ *   - key: An HMAC-SHA512 key.
+ *   - message: The authenticated message.
+ *   - count: The number of bytes in the message.
+ *   - code: The 64-byte authentication code to check.
+ *
+ * - Returns: `true` if the code is valid for the message; otherwise, `false`.
+ */
+Bool Crypto_HMAC_SHA512_Verify(const struct Crypto_HMAC_SHA512_Key* key,
+                               const UInt8* message,
+                               Int64 count,
+                               const UInt8 code[static 64]);
+
+/**
+ * Computes the HMAC-SHA512 authentication code of a message in one call.
+ *
+ * Prefer ``Crypto_HMAC_SHA512_CreateKey()`` when the same key authenticates
+ * more than one message.
+ *
+ * - Parameters:
+ *   - key: The secret key.
+ *   - keyCount: The number of bytes in the key.
+ *   - message: The message to authenticate.
+ *   - count: The number of bytes in the message.
+ *   - code: A buffer to store the 64-byte authentication code.
+ */
+void Crypto_HMAC_SHA512(const UInt8* key,
+                        Int64 keyCount,
+                        const UInt8* message,
+                        Int64 count,
+                        UInt8 code[static 64]);
+
+/* MARK: - HKDF */
+/**
+ * The largest number of bytes HKDF-SHA512 can derive from one key, 255 * 64.
+ */
+#define Crypto_HKDF_SHA512_MaximumCount 16320
+
+/**
+ * Extracts a pseudorandom key from input keying material (RFC 5869, 2.2).
+ *
+ * - Parameters:
+ *   - salt: An optional salt, or `NULL`.
+ *   - saltCount: The number of bytes in the salt. An empty salt is the same
+ *                as 64 zero bytes.
+ *   - inputKeyMaterial: The input keying material.
+ *   - count: The number of bytes of input keying material.
+ *   - pseudoRandomKey: A buffer to store the 64-byte pseudorandom key.
+ */
+void Crypto_HKDF_SHA512_Extract(const UInt8* salt,
+                                Int64 saltCount,
+                                const UInt8* inputKeyMaterial,
+                                Int64 count,
+                                UInt8 pseudoRandomKey[static 64]);
+
+/**
+ * Expands a pseudorandom key into output keying material (RFC 5869, 2.3).
+ *
+ * To derive many keys from the same pseudorandom key, such as one key per
+ * file, create an HMAC-SHA512 key from it once and call this method with a
+ * different `info` for each derived key.
+ *
+ * - Parameters:
+ *   - pseudoRandomKey: An HMAC-SHA512 key created from the pseudorandom key.
+ *   - info: Optional context and application specific information, or
+ *           `NULL`.
+ *   - infoCount: The number of bytes of information.
+ *   - outputKeyMaterial: A buffer to store the output keying material.
+ *   - count: The number of bytes to derive, at most
+ *            ``Crypto_HKDF_SHA512_MaximumCount``.
+ *
+ * - Returns: `true` if the key material was derived; `false` if `count` is
+ *   out of range.
+ */
+Bool Crypto_HKDF_SHA512_Expand(
+  const struct Crypto_HMAC_SHA512_Key* pseudoRandomKey,
+  const UInt8* info,
+  Int64 infoCount,
+  UInt8* outputKeyMaterial,
+  Int64 count
+);
+
+/**
+ * Derives a key with HKDF-SHA512, extracting and expanding in one call.
+ *
+ * - Parameters:
+ *   - salt: An optional salt, or `NULL`.
+ *   - saltCount: The number of bytes in the salt.
+ *   - inputKeyMaterial: The input keying material.
+ *   - inputKeyMaterialCount: The number of bytes of input keying material.
+ *   - info: Optional context and application specific information, or
+ *           `NULL`.
+ *   - infoCount: The number of bytes of information.
+ *   - outputKeyMaterial: A buffer to store the output keying material.
+ *   - count: The number of bytes to derive, at most
+ *            ``Crypto_HKDF_SHA512_MaximumCount``.
+ *
+ * - Returns: `true` if the key material was derived; `false` if `count` is
+ *   out of range.
+ */
+Bool Crypto_HKDF_SHA512(const UInt8* salt,
+                        Int64 saltCount,
+                        const UInt8* inputKeyMaterial,
+                        Int64 inputKeyMaterialCount,
+                        const UInt8* info,
+                        Int64 infoCount,
+                        UInt8* outputKeyMaterial,
+                        Int64 count);
+
+/* MARK: - PBKDF2 */
+/**
+ * Derives a key from a password with PBKDF2-HMAC-SHA512 (RFC 8018, 5.2).
+ *
+ * The padded password blocks are absorbed once, and every iteration then
+ * costs exactly two SHA512 compressions with precomputed padding. Output
+ * blocks are independent, so keys longer than 64 bytes derive up to four
+ * blocks at the same time in the vector lanes, and keys longer than 256
+ * bytes on the threads of the task pool once it is started (see
+ * ``TaskPoolStart()``).
+ *
+ * - Parameters:
+ *   - password: The password.
+ *   - passwordCount: The number of bytes in the password.
+ *   - salt: The salt, or `NULL`.
+ *   - saltCount: The number of bytes in the salt.
+ *   - iterations: The iteration count, at least 1.
+ *   - derivedKey: A buffer to store the derived key.
+ *   - count: The number of bytes to derive.
+ *
+ * - Returns: `true` if the key was derived; `false` if `iterations` or
+ *   `count` is out of range.
+ */
+Bool Crypto_PBKDF2_SHA512(const UInt8* password,
+                          Int64 passwordCount,
+                          const UInt8* salt,
+                          Int64 saltCount,
+                          Int64 iterations,
+                          UInt8* derivedKey,
+                          Int64 count);
+
+#endif /* Crypto_HMAC_h */
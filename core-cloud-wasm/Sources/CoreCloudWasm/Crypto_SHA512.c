@@ -44,13 +44,8 @@
  * SUCH DAMAGE.
  */
 
-#include "Crypto_SHA512.h"
-
-struct Crypto_SHA512_Context {
-  UInt64 state[8];
-  UInt64 count[2];
-  UInt8 buffer[128];
-};
+#include "Crypto_SHA512_Private.h"
+#include "TaskPool_Private.h"
 
 /* SHA512 round constants. */
 static const UInt64 K[80] = {
@@ -127,23 +122,71 @@ static const UInt64 K[80] = {
                    s0(W[i + ii + 1]) +  \
                    W[i + ii]
 
+/* MARK: - Vectors */
 /*
- * SHA512 block compression function.  The 512-bit state is transformed via
- * the 512-bit input block to produce a new state.
+ * A vector holds two 64-bit lanes, on the backend of `UInt64x2`.  Define
+ * `SIMD_SCALAR` to build the plain C reference instead.
  */
-static void Crypto_SHA512_Transform(UInt64* state, const UInt8 block[128]) {
-  UInt64 W[80];
-  UInt64 S[8];
+typedef UInt64x2 Vector;
+
+#define VADD(a, b)   UInt64x2_Add(a, b)
+#define VAND(a, b)   UInt64x2_And(a, b)
+#define VOR(a, b)    UInt64x2_Or(a, b)
+#define VXOR(a, b)   UInt64x2_Xor(a, b)
+#define VSHR(x, n)   UInt64x2_ShiftRight(x, n)
+#define VSHL(x, n)   UInt64x2_ShiftLeft(x, n)
+#define VSPLAT(x)    UInt64x2_Splat(x)
+#define VMAKE(x, y)  UInt64x2_Make(x, y)
+#define VSPAN(a, b)  UInt64x2_Span(a, b)
+#define VSTORE(p, x) UInt64x2_Store(p, x)
+
+/* Elementary functions used by SHA512, two lanes at a time */
+#define VCh(x, y, z)  VXOR(VAND(x, VXOR(y, z)), z)
+#define VMaj(x, y, z) VOR(VAND(x, VOR(y, z)), VAND(y, z))
+#define VROTR(x, n)   VOR(VSHR(x, n), VSHL(x, 64 - n))
+#define VS0(x)        VXOR(VXOR(VROTR(x, 28), VROTR(x, 34)), VROTR(x, 39))
+#define VS1(x)        VXOR(VXOR(VROTR(x, 14), VROTR(x, 18)), VROTR(x, 41))
+#define Vs0(x)        VXOR(VXOR(VROTR(x, 1), VROTR(x, 8)), VSHR(x, 7))
+#define Vs1(x)        VXOR(VXOR(VROTR(x, 19), VROTR(x, 61)), VSHR(x, 6))
+
+#if !defined(SIMD_SCALAR)
+/*
+ * Vectorized message schedule.  `X[j]` holds the words `W[2j]` and
+ * `W[2j + 1]`; the nearest dependency of `W[t]` is `W[t - 2]`, so each pair
+ * only depends on the pairs before it.  `VSPAN(a, b)` is the pair straddling
+ * `a` and `b`, such as `W[t - 15]` and `W[t - 14]`.
+ */
+static inline void Crypto_SHA512_Schedule(UInt64 W[80],
+                                          const UInt8 block[128]) {
+  Vector X[40];
 
-  /* 1. Prepare the first part of the message schedule W. */
-  for (Int32 i = 0; i < 16; i += 1) {
-    UInt64_InitBigEndianBytes(block + i * 8, &W[i]);
+  for (Int32 j = 0; j < 8; j += 1) {
+    X[j] = UInt64x2_LoadBigEndian(block + j * 16);
+  }
+
+  for (Int32 j = 8; j < 40; j += 1) {
+    X[j] = VADD(VADD(Vs1(X[j - 1]), VSPAN(X[j - 4], X[j - 3])),
+                VADD(Vs0(VSPAN(X[j - 8], X[j - 7])), X[j - 8]));
+  }
+
+  for (Int32 j = 0; j < 40; j += 1) {
+    VSTORE(W + j * 2, X[j]);
   }
+}
+#endif
 
-  /* 2. Initialize working variables. */
+/*
+ * The 80 rounds of the compression function over the message schedule `W`.
+ * When `expand` is set, only `W[0 ..< 16]` is prepared and the rest of the
+ * schedule is computed along the way.
+ */
+static inline void Crypto_SHA512_Mix(UInt64* state, UInt64 W[80], Bool expand) {
+  UInt64 S[8];
+
+  /* 1. Initialize working variables. */
   memcpy(S, state, 64);
 
-  /* 3. Mix. */
+  /* 2. Mix. */
   for (Int32 i = 0; i < 80; i += 16) {
     RNDr(S, W, 0, i);
     RNDr(S, W, 1, i);
@@ -162,8 +205,8 @@ static void Crypto_SHA512_Transform(UInt64* state, const UInt8 block[128]) {
     RNDr(S, W, 14, i);
     RNDr(S, W, 15, i);
 
-    if (i == 64) {
-      break;
+    if (i == 64 || !expand) {
+      continue;
     }
     MSCH(W, 0, i);
     MSCH(W, 1, i);
@@ -183,12 +226,213 @@ static void Crypto_SHA512_Transform(UInt64* state, const UInt8 block[128]) {
     MSCH(W, 15, i);
   }
 
-  /* 4. Mix local working variables into global state */
+  /* 3. Mix local working variables into global state */
   for (Int32 i = 0; i < 8; i += 1) {
     state[i] += S[i];
   }
 }
 
+/*
+ * SHA512 block compression function.  The 512-bit state is transformed via
+ * the 512-bit input block to produce a new state.
+ */
+static void Crypto_SHA512_Transform(UInt64* state, const UInt8 block[128]) {
+  UInt64 W[80];
+
+#if !defined(SIMD_SCALAR)
+  /* 1. Prepare the whole message schedule W up front. */
+  Crypto_SHA512_Schedule(W, block);
+  Crypto_SHA512_Mix(state, W, false);
+#else
+  /* 1. Prepare the first part of the message schedule W. */
+  UInt64_BigEndianLoadArray(block, W, 16);
+  Crypto_SHA512_Mix(state, W, true);
+#endif
+}
+
+/*
+ * The last block of a 192-byte message whose final 64 bytes are `message`:
+ * the message words, the terminating bit and the bit count 1536.
+ */
+static inline void Crypto_SHA512_Schedule64(UInt64 W[16],
+                                            const UInt64 message[8]) {
+  memcpy(W, message, 64);
+  W[8] = 0x8000000000000000ULL;
+  for (Int32 i = 9; i < 15; i += 1) {
+    W[i] = 0;
+  }
+  W[15] = 192 * 8;
+}
+
+void Crypto_SHA512_Transform64(UInt64 state[8], const UInt64 message[8]) {
+  UInt64 W[80];
+
+  Crypto_SHA512_Schedule64(W, message);
+  Crypto_SHA512_Mix(state, W, true);
+}
+
+/* MARK: - Multi-Buffer Block Compression */
+/*
+ * The multi-buffer kernel keeps two independent lanes in each vector, and
+ * interleaves two vectors to hash four messages at the same time.
+ */
+
+/* SHA512 round function, two lanes at a time */
+#define VRND(a, b, c, d, e, f, g, h, k)                     \
+  h = VADD(h, VADD(VADD(VS1(e), VCh(e, f, g)), k));         \
+  d = VADD(d, h);                                           \
+  h = VADD(h, VADD(VS0(a), VMaj(a, b, c)));
+
+/* Adjusted round function for rotating state */
+#define VRNDr(S, W, i, ii)                              \
+  VRND(S[(80 - i) % 8], S[(81 - i) % 8],                \
+       S[(82 - i) % 8], S[(83 - i) % 8],                \
+       S[(84 - i) % 8], S[(85 - i) % 8],                \
+       S[(86 - i) % 8], S[(87 - i) % 8],                \
+       VADD(W[i + ii], VSPLAT(K[i + ii])))
+
+/* Message schedule computation, two lanes at a time */
+#define VMSCH(W, ii, i)                                      \
+  W[i + ii + 16] = VADD(VADD(Vs1(W[i + ii + 14]), W[i + ii + 9]), \
+                        VADD(Vs0(W[i + ii + 1]), W[i + ii]))
+
+/*
+ * The 80 rounds of the compression function for two pairs of lanes, over
+ * message schedules whose first 16 words are prepared.
+ */
+static inline void Crypto_SHA512_Mixx4(Vector H[2][8], Vector W[2][80]) {
+  Vector S[2][8];
+
+  /* 1. Initialize working variables. */
+  memcpy(S, H, sizeof(S));
+
+  /* 2. Mix both pairs of lanes round by round. */
+  for (Int32 i = 0; i < 80; i += 16) {
+    for (Int32 p = 0; p < 2; p += 1) {
+      VRNDr(S[p], W[p], 0, i);
+      VRNDr(S[p], W[p], 1, i);
+      VRNDr(S[p], W[p], 2, i);
+      VRNDr(S[p], W[p], 3, i);
+      VRNDr(S[p], W[p], 4, i);
+      VRNDr(S[p], W[p], 5, i);
+      VRNDr(S[p], W[p], 6, i);
+      VRNDr(S[p], W[p], 7, i);
+      VRNDr(S[p], W[p], 8, i);
+      VRNDr(S[p], W[p], 9, i);
+      VRNDr(S[p], W[p], 10, i);
+      VRNDr(S[p], W[p], 11, i);
+      VRNDr(S[p], W[p], 12, i);
+      VRNDr(S[p], W[p], 13, i);
+      VRNDr(S[p], W[p], 14, i);
+      VRNDr(S[p], W[p], 15, i);
+
+      if (i == 64) {
+        continue;
+      }
+      VMSCH(W[p], 0, i);
+      VMSCH(W[p], 1, i);
+      VMSCH(W[p], 2, i);
+      VMSCH(W[p], 3, i);
+      VMSCH(W[p], 4, i);
+      VMSCH(W[p], 5, i);
+      VMSCH(W[p], 6, i);
+      VMSCH(W[p], 7, i);
+      VMSCH(W[p], 8, i);
+      VMSCH(W[p], 9, i);
+      VMSCH(W[p], 10, i);
+      VMSCH(W[p], 11, i);
+      VMSCH(W[p], 12, i);
+      VMSCH(W[p], 13, i);
+      VMSCH(W[p], 14, i);
+      VMSCH(W[p], 15, i);
+    }
+  }
+
+  /* 3. Mix local working variables into the lane states. */
+  for (Int32 p = 0; p < 2; p += 1) {
+    for (Int32 i = 0; i < 8; i += 1) {
+      H[p][i] = VADD(H[p][i], S[p][i]);
+    }
+  }
+}
+
+/* Gather four states into two pairs of lanes. */
+static inline void Crypto_SHA512_Gatherx4(Vector H[2][8], UInt64* states[4]) {
+  for (Int32 p = 0; p < 2; p += 1) {
+    for (Int32 i = 0; i < 8; i += 1) {
+      H[p][i] = VMAKE(states[2 * p][i], states[2 * p + 1][i]);
+    }
+  }
+}
+
+/* Scatter two pairs of lanes back into four states. */
+static inline void Crypto_SHA512_Scatterx4(Vector H[2][8], UInt64* states[4]) {
+  UInt64 lanes[2];
+
+  for (Int32 p = 0; p < 2; p += 1) {
+    for (Int32 i = 0; i < 8; i += 1) {
+      VSTORE(lanes, H[p][i]);
+      states[2 * p][i] = lanes[0];
+      states[2 * p + 1][i] = lanes[1];
+    }
+  }
+}
+
+/*
+ * Four-lane SHA512 block compression function.  Compresses `count`
+ * consecutive 128-byte blocks from each of the four inputs into the
+ * corresponding state.
+ */
+static void Crypto_SHA512_Transformx4(UInt64* states[4],
+                                      const UInt8* sources[4],
+                                      Int64 count) {
+  Vector W[2][80];
+  Vector H[2][8];
+
+  Crypto_SHA512_Gatherx4(H, states);
+
+  for (Int64 block = 0; block < count; block += 1) {
+    const Int64 offset = block * 128;
+
+    /*
+     * Prepare the first part of both message schedules, by loading two words
+     * of each message and interleaving them into two pairs of lanes.
+     */
+    for (Int32 p = 0; p < 2; p += 1) {
+      for (Int32 i = 0; i < 16; i += 2) {
+        Vector x = UInt64x2_LoadBigEndian(sources[2 * p] + offset + i * 8);
+        Vector y = UInt64x2_LoadBigEndian(sources[2 * p + 1] + offset + i * 8);
+        W[p][i] = UInt64x2_InterleaveLow(x, y);
+        W[p][i + 1] = UInt64x2_InterleaveHigh(x, y);
+      }
+    }
+
+    Crypto_SHA512_Mixx4(H, W);
+  }
+
+  Crypto_SHA512_Scatterx4(H, states);
+}
+
+void Crypto_SHA512_Transform64x4(UInt64* states[4],
+                                 const UInt64* messages[4]) {
+  Vector W[2][80];
+  Vector H[2][8];
+  UInt64 lanes[2][16];
+
+  Crypto_SHA512_Gatherx4(H, states);
+
+  for (Int32 p = 0; p < 2; p += 1) {
+    Crypto_SHA512_Schedule64(lanes[0], messages[2 * p]);
+    Crypto_SHA512_Schedule64(lanes[1], messages[2 * p + 1]);
+    for (Int32 i = 0; i < 16; i += 1) {
+      W[p][i] = VMAKE(lanes[0][i], lanes[1][i]);
+    }
+  }
+
+  Crypto_SHA512_Mixx4(H, W);
+  Crypto_SHA512_Scatterx4(H, states);
+}
+
 static UInt8 PAD[128] = {
   0x80, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
   0x00, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
@@ -219,28 +463,63 @@ static void Crypto_SHA512_Pad(struct Crypto_SHA512_Context *context) {
   }
 
   /* Add the terminating bit-count. */
-  for (Int32 i = 0; i < 2; i += 1) {
-    UInt64_BigEndianBytes(context->count[i], &context->buffer[112] + i * 8);
-  }
+  UInt64_BigEndianStoreArray(context->count, &context->buffer[112], 2);
 
   /* Mix in the final block. */
   Crypto_SHA512_Transform(context->state, context->buffer);
 }
 
+/* Add the bit length of `count` bytes to the number of bits processed. */
+static void Crypto_SHA512_Count(struct Crypto_SHA512_Context* context,
+                                Int64 count) {
+  /* Convert the length into a number of bits */
+  UInt64 bitlen[2];
+  bitlen[1] = ((UInt64)count) << 3;
+  bitlen[0] = ((UInt64)count) >> 61;
+
+  if ((context->count[1] += bitlen[1]) < bitlen[1]) {
+    context->count[0] += 1;
+  }
+  context->count[0] += bitlen[0];
+}
+
+/* Compress `count` consecutive full blocks straight from `source`. */
+static void Crypto_SHA512_Blocks(UInt64* state,
+                                 const UInt8* source,
+                                 Int64 count) {
+  for (Int64 i = 0; i < count; i += 1) {
+    Crypto_SHA512_Transform(state, source + i * 128);
+  }
+}
+
+/* Magic initialization constants */
+static const UInt64 IV[8] = {
+  0x6a09e667f3bcc908ULL, 0xbb67ae8584caa73bULL,
+  0x3c6ef372fe94f82bULL, 0xa54ff53a5f1d36f1ULL,
+  0x510e527fade682d1ULL, 0x9b05688c2b3e6c1fULL,
+  0x1f83d9abfb41bd6bULL, 0x5be0cd19137e2179ULL
+};
+
+/*
+ * Pad a message of at most 111 bytes into a single final block: the message,
+ * the terminating bit, zeroes, and the 128-bit bit count.
+ */
+static void Crypto_SHA512_PadShort(const UInt8* buffer,
+                                   Int64 count,
+                                   UInt8 block[128]) {
+  memcpy(block, buffer, count);
+  block[count] = 0x80;
+  memset(block + count + 1, 0, 119 - count);
+  UInt64_BigEndianBytes((UInt64)count << 3, block + 120);
+}
+
 /* SHA-512 initialization.  Begins a SHA-512 operation. */
 void Crypto_SHA512_Init(struct Crypto_SHA512_Context* context) {
   /* Zero bits processed so far */
   context->count[0] = context->count[1] = 0;
 
   /* Magic initialization constants */
-  context->state[0] = 0x6a09e667f3bcc908ULL;
-  context->state[1] = 0xbb67ae8584caa73bULL;
-  context->state[2] = 0x3c6ef372fe94f82bULL;
-  context->state[3] = 0xa54ff53a5f1d36f1ULL;
-  context->state[4] = 0x510e527fade682d1ULL;
-  context->state[5] = 0x9b05688c2b3e6c1fULL;
-  context->state[6] = 0x1f83d9abfb41bd6bULL;
-  context->state[7] = 0x5be0cd19137e2179ULL;
+  memcpy(context->state, IV, sizeof(IV));
 }
 
 /* Add bytes into the hash */
@@ -252,16 +531,8 @@ void Crypto_SHA512_Update(struct Crypto_SHA512_Context* context,
   /* Number of bytes left in the buffer from previous updates */
   UInt64 r = (context->count[1] >> 3) & 0x7f;
 
-  /* Convert the length into a number of bits */
-  UInt64 bitlen[2];
-  bitlen[1] = ((UInt64)count) << 3;
-  bitlen[0] = ((UInt64)count) >> 61;
-
   /* Update number of bits */
-  if ((context->count[1] += bitlen[1]) < bitlen[1]) {
-    context->count[0] += 1;
-  }
-  context->count[0] += bitlen[0];
+  Crypto_SHA512_Count(context, count);
 
   /* Handle the case where we don't need to perform any transforms */
   if (count < 128 - r) {
@@ -269,19 +540,19 @@ void Crypto_SHA512_Update(struct Crypto_SHA512_Context* context,
     return;
   }
 
-  /* Finish the current block */
-  memcpy(&context->buffer[r], source, 128 - r);
-  Crypto_SHA512_Transform(context->state, context->buffer);
-  source += 128 - r;
-  count -= 128 - r;
-
-  /* Perform complete blocks */
-  while (count >= 128) {
-    Crypto_SHA512_Transform(context->state, source);
-    source += 128;
-    count -= 128;
+  /* Finish the current block, if one was started */
+  if (r != 0) {
+    memcpy(&context->buffer[r], source, 128 - r);
+    Crypto_SHA512_Transform(context->state, context->buffer);
+    source += 128 - r;
+    count -= 128 - r;
   }
 
+  /* Perform complete blocks in place */
+  Crypto_SHA512_Blocks(context->state, source, count / 128);
+  source += count / 128 * 128;
+  count %= 128;
+
   /* Copy left over data into buffer */
   memcpy(context->buffer, source, count);
 }
@@ -296,10 +567,383 @@ void Crypto_SHA512_Finalize(struct Crypto_SHA512_Context* context,
   Crypto_SHA512_Pad(context);
 
   /* Write the hash */
-  for (Int32 i = 0; i < 8; i += 1) {
-    UInt64_BigEndianBytes(context->state[i], digest + i * 8);
+  UInt64_BigEndianStoreArray(context->state, digest, 8);
+
+  /* Clear the context state */
+  memset(context, 0, sizeof(*context));
+}
+
+/* One-shot SHA-512. */
+void Crypto_SHA512_Hash(const UInt8* buffer,
+                        Int64 count,
+                        UInt8 digest[static 64]) {
+  UInt64 state[8];
+
+  if (count <= 111) {
+    /* The whole message fits in one block: no context, one transform */
+    UInt8 block[128];
+
+    memcpy(state, IV, sizeof(IV));
+    Crypto_SHA512_PadShort(buffer, count, block);
+    Crypto_SHA512_Transform(state, block);
+    memset(block, 0, sizeof(block));
+  } else {
+    struct Crypto_SHA512_Context context;
+
+    Crypto_SHA512_Init(&context);
+    Crypto_SHA512_Update(&context, buffer, count);
+    Crypto_SHA512_Pad(&context);
+    memcpy(state, context.state, sizeof(state));
+    memset(&context, 0, sizeof(context));
+  }
+
+  UInt64_BigEndianStoreArray(state, digest, 8);
+}
+
+/*
+ * Multi-buffer SHA-512 update.  Lanes are processed in groups of four: each
+ * lane first tops up its partially filled buffer, then the full blocks the
+ * lanes have in common are compressed together, and whatever remains goes
+ * through the single-stream path.
+ */
+void Crypto_SHA512xN_Update(struct Crypto_SHA512_Context* const contexts[],
+                            const UInt8* const buffers[],
+                            const Int64 counts[],
+                            Int32 n) {
+  for (Int32 first = 0; first < n; first += 4) {
+    Int32 lanes = n - first < 4 ? n - first : 4;
+
+    const UInt8* sources[4];
+    Int64 remainders[4];
+    UInt64* states[4];
+    UInt64 scratch[8];
+
+    /* Common number of full blocks across the lanes of this group */
+    Int64 blocks = INT64_MAX;
+
+    for (Int32 i = 0; i < lanes; i += 1) {
+      struct Crypto_SHA512_Context* context = contexts[first + i];
+      Int64 count = counts[first + i];
+
+      /* Finish the partially filled block, if any */
+      UInt64 r = (context->count[1] >> 3) & 0x7f;
+      Int64 head = 0;
+      if (r != 0) {
+        head = count < (Int64)(128 - r) ? count : (Int64)(128 - r);
+        Crypto_SHA512_Update(context, buffers[first + i], head);
+      }
+
+      sources[i] = buffers[first + i] + head;
+      remainders[i] = count - head;
+      states[i] = context->state;
+      if (remainders[i] / 128 < blocks) {
+        blocks = remainders[i] / 128;
+      }
+    }
+
+    if (lanes > 1 && blocks > 0) {
+      /* Idle lanes hash the first lane's data into a scratch state. */
+      memcpy(scratch, states[0], sizeof(scratch));
+      for (Int32 i = lanes; i < 4; i += 1) {
+        sources[i] = sources[0];
+        states[i] = scratch;
+      }
+
+      Crypto_SHA512_Transformx4(states, sources, blocks);
+
+      for (Int32 i = 0; i < lanes; i += 1) {
+        Crypto_SHA512_Count(contexts[first + i], blocks * 128);
+        sources[i] += blocks * 128;
+        remainders[i] -= blocks * 128;
+      }
+    }
+
+    /* Hash the rest of each lane on its own */
+    for (Int32 i = 0; i < lanes; i += 1) {
+      Crypto_SHA512_Update(contexts[first + i], sources[i], remainders[i]);
+    }
+  }
+}
+
+/* Compress up to four padded single-block messages into their digests. */
+static void Crypto_SHA512xN_HashBlocks(UInt8 blocks[4][128],
+                                       const Int32 indices[4],
+                                       Int32 count,
+                                       UInt8* digests) {
+  UInt64 lanes[4][8];
+  const UInt8* sources[4];
+  UInt64* states[4];
+
+  /* Idle lanes repeat the first block. */
+  for (Int32 j = 0; j < 4; j += 1) {
+    memcpy(lanes[j], IV, sizeof(IV));
+    sources[j] = blocks[j < count ? j : 0];
+    states[j] = lanes[j];
+  }
+  Crypto_SHA512_Transformx4(states, sources, 1);
+
+  for (Int32 j = 0; j < count; j += 1) {
+    UInt64_BigEndianStoreArray(lanes[j], digests + indices[j] * 64, 8);
+  }
+}
+
+/* Number of messages in each task of `Crypto_SHA512xN_Hash()` */
+#define Crypto_SHA512xN_TaskCount 256
+
+/*
+ * Multi-buffer one-shot SHA-512.  Messages of at most 111 bytes are padded
+ * into single blocks and compressed four at a time; longer ones are hashed on
+ * their own.
+ */
+static void Crypto_SHA512xN_HashBatch(const UInt8* const buffers[],
+                                      const Int64 counts[],
+                                      Int32 n,
+                                      UInt8* digests) {
+  UInt8 blocks[4][128];
+  Int32 indices[4];
+  Int32 pending = 0;
+
+  for (Int32 i = 0; i < n; i += 1) {
+    if (counts[i] > 111) {
+      Crypto_SHA512_Hash(buffers[i], counts[i], digests + i * 64);
+      continue;
+    }
+
+    Crypto_SHA512_PadShort(buffers[i], counts[i], blocks[pending]);
+    indices[pending] = i;
+    pending += 1;
+
+    if (pending == 4) {
+      Crypto_SHA512xN_HashBlocks(blocks, indices, pending, digests);
+      pending = 0;
+    }
+  }
+
+  if (pending > 0) {
+    Crypto_SHA512xN_HashBlocks(blocks, indices, pending, digests);
+  }
+
+  memset(blocks, 0, sizeof(blocks));
+}
+
+/* The arguments of `Crypto_SHA512xN_Hash()` */
+struct Crypto_SHA512xN_Task {
+  const UInt8* const* buffers;
+  const Int64* counts;
+  Int32 n;
+  UInt8* digests;
+};
+
+/* Hash the messages from `Crypto_SHA512xN_TaskCount * index` on. */
+static void Crypto_SHA512xN_HashTask(void* context, Int64 index) {
+  const struct Crypto_SHA512xN_Task* task = context;
+  Int32 first = (Int32)index * Crypto_SHA512xN_TaskCount;
+  Int32 n = task->n - first < Crypto_SHA512xN_TaskCount
+          ? task->n - first
+          : Crypto_SHA512xN_TaskCount;
+
+  Crypto_SHA512xN_HashBatch(
+    task->buffers + first,
+    task->counts + first,
+    n,
+    task->digests + (Int64)first * 64
+  );
+}
+
+void Crypto_SHA512xN_Hash(const UInt8* const buffers[],
+                          const Int64 counts[],
+                          Int32 n,
+                          UInt8* digests) {
+  struct Crypto_SHA512xN_Task task = { buffers, counts, n, digests };
+
+  TaskPoolApply(
+    (n + Crypto_SHA512xN_TaskCount - 1) / Crypto_SHA512xN_TaskCount,
+    &task,
+    Crypto_SHA512xN_HashTask
+  );
+}
+
+/* MARK: - Allocation */
+Int64 Crypto_SHA512_ContextSize(void) {
+  return sizeof(struct Crypto_SHA512_Context);
+}
+
+Int64 Crypto_SHA512_ContextAlignment(void) {
+  return _Alignof(struct Crypto_SHA512_Context);
+}
+
+struct Crypto_SHA512_Context* Crypto_SHA512_Create(void) {
+  struct Crypto_SHA512_Context* context = Memory_SlabAllocate(
+    sizeof(struct Crypto_SHA512_Context)
+  );
+  if (context == NULL) {
+    return NULL;
+  }
+
+  Crypto_SHA512_Init(context);
+  return context;
+}
+
+void Crypto_SHA512_Destroy(struct Crypto_SHA512_Context* context) {
+  if (context == NULL) {
+    return;
   }
 
   /* Clear the context state */
   memset(context, 0, sizeof(*context));
+  Memory_SlabFree(context);
+}
+
+/* MARK: - Serialization */
+static const UInt8 STATE_MAGIC[8] = { 'S', 'H', 'A', '5', '1', '2', 0, 1 };
+
+void Crypto_SHA512_Export(const struct Crypto_SHA512_Context* context,
+                          UInt8 state[static Crypto_SHA512_StateSize]) {
+  /* Number of bytes in the partial block */
+  UInt64 r = (context->count[1] >> 3) & 0x7f;
+
+  memcpy(state, STATE_MAGIC, 8);
+  UInt64_BigEndianStoreArray(context->state, state + 8, 8);
+  UInt64_BigEndianStoreArray(context->count, state + 72, 2);
+
+  /* Never leak stale bytes past the partial block */
+  memcpy(state + 88, context->buffer, r);
+  memset(state + 88 + r, 0, 128 - r);
+}
+
+Bool Crypto_SHA512_Import(struct Crypto_SHA512_Context* context,
+                          const UInt8* state,
+                          Int64 count) {
+  if (count != Crypto_SHA512_StateSize || memcmp(state, STATE_MAGIC, 8) != 0) {
+    return false;
+  }
+
+  UInt64_BigEndianLoadArray(state + 8, context->state, 8);
+  UInt64_BigEndianLoadArray(state + 72, context->count, 2);
+  memcpy(context->buffer, state + 88, 128);
+  return true;
+}
+
+/* MARK: - Streaming */
+/*
+ * `bytes` holds 128 bytes of carry followed by the staging area.  After each
+ * commit, the partial block left over (`tail` bytes) is moved to the end of
+ * the carry, right in front of the staging area, so the next commit again
+ * sees one contiguous run of data starting `tail` bytes before it.
+ */
+/* `arena` holds the stream itself, if it was created by `Stream_Create`. */
+struct Crypto_SHA512_Stream {
+  struct Crypto_SHA512_Context context;
+  Int64 tail;
+  struct Memory_Arena* arena;
+  _Alignas(64) UInt8 bytes[128 + Crypto_SHA512_StreamCapacity];
+};
+
+struct Crypto_SHA512_Stream* Crypto_SHA512_Stream_Create(void) {
+  struct Memory_Arena* arena = Memory_ArenaCreate();
+  if (arena == NULL) {
+    return NULL;
+  }
+
+  struct Crypto_SHA512_Stream* stream = Memory_ArenaAllocate(
+    arena,
+    sizeof(struct Crypto_SHA512_Stream)
+  );
+  if (stream == NULL) {
+    Memory_ArenaDestroy(arena);
+    return NULL;
+  }
+
+  Crypto_SHA512_Stream_Init(stream);
+  stream->arena = arena;
+  return stream;
+}
+
+void Crypto_SHA512_Stream_Destroy(struct Crypto_SHA512_Stream* stream) {
+  if (stream == NULL) {
+    return;
+  }
+
+  Memory_ArenaDestroy(stream->arena);
+}
+
+Int64 Crypto_SHA512_Stream_Size(void) {
+  return sizeof(struct Crypto_SHA512_Stream);
+}
+
+void Crypto_SHA512_Stream_Init(struct Crypto_SHA512_Stream* stream) {
+  Crypto_SHA512_Init(&stream->context);
+  stream->tail = 0;
+  stream->arena = NULL;
+}
+
+UInt8* Crypto_SHA512_Stream_Buffer(struct Crypto_SHA512_Stream* stream) {
+  return stream->bytes + 128;
+}
+
+Int64 Crypto_SHA512_Stream_Capacity(const struct Crypto_SHA512_Stream* stream) {
+  (void)stream;
+  return Crypto_SHA512_StreamCapacity;
+}
+
+Bool Crypto_SHA512_Stream_Commit(struct Crypto_SHA512_Stream* stream,
+                                 Int64 count) {
+  if (count < 0 || count > Crypto_SHA512_StreamCapacity) {
+    return false;
+  }
+
+  const UInt8* source = stream->bytes + 128 - stream->tail;
+  Int64 available = stream->tail + count;
+  Int64 blocks = available / 128;
+
+  Crypto_SHA512_Count(&stream->context, count);
+  Crypto_SHA512_Blocks(stream->context.state, source, blocks);
+
+  /* Carry the partial block over in front of the staging area */
+  stream->tail = available % 128;
+  memmove(
+    stream->bytes + 128 - stream->tail,
+    source + blocks * 128,
+    stream->tail
+  );
+  return true;
+}
+
+void Crypto_SHA512_Stream_Finalize(struct Crypto_SHA512_Stream* stream,
+                                   UInt8 digest[static 64]) {
+  /* The carry is exactly the partial block the context expects. */
+  memcpy(
+    stream->context.buffer,
+    stream->bytes + 128 - stream->tail,
+    stream->tail
+  );
+  Crypto_SHA512_Finalize(&stream->context, digest);
+
+  Crypto_SHA512_Init(&stream->context);
+  stream->tail = 0;
+}
+
+void Crypto_SHA512_Stream_Export(const struct Crypto_SHA512_Stream* stream,
+                                 UInt8 state[static Crypto_SHA512_StateSize]) {
+  struct Crypto_SHA512_Context context = stream->context;
+
+  memcpy(context.buffer, stream->bytes + 128 - stream->tail, stream->tail);
+  Crypto_SHA512_Export(&context, state);
+}
+
+Bool Crypto_SHA512_Stream_Import(struct Crypto_SHA512_Stream* stream,
+                                 const UInt8* state,
+                                 Int64 count) {
+  if (!Crypto_SHA512_Import(&stream->context, state, count)) {
+    return false;
+  }
+
+  /* Move the partial block in front of the staging area */
+  stream->tail = (stream->context.count[1] >> 3) & 0x7f;
+  memcpy(
+    stream->bytes + 128 - stream->tail,
+    stream->context.buffer,
+    stream->tail
+  );
+  return true;
 }
@@ -101,4 +101,291 @@ void Crypto_SHA512_Update(struct Crypto_SHA512_Context* context,
 void Crypto_SHA512_Finalize(struct Crypto_SHA512_Context* context,
                             UInt8 digest[static 64]);
 
+/**
+ * Computes the SHA512 digest of a buffer in one call.
+ *
+ * This is equivalent to ``Crypto_SHA512_Init()``, ``Crypto_SHA512_Update()``
+ * and ``Crypto_SHA512_Finalize()``, but needs no hash function. Messages of at
+ * most 111 bytes, such as passwords and verification codes, fit in a single
+ * block that is padded on the stack and compressed once.
+ *
+ * - Parameters:
+ *   - buffer: The data to hash.
+ *   - count: The number of bytes in the buffer.
+ *   - digest: A buffer to store the computed digest of the data.
+ */
+void Crypto_SHA512_Hash(const UInt8* buffer,
+                        Int64 count,
+                        UInt8 digest[static 64]);
+
+/**
+ * Incrementally updates several independent hash functions at once.
+ *
+ * Use this method instead of calling ``Crypto_SHA512_Update()`` in a loop when
+ * many messages are hashed side by side, such as the files of a dropped
+ * folder. The hash functions are processed in groups of four whose full
+ * blocks are compressed together, so that the independent computations fill
+ * the vector lanes and execution units of the processor.
+ *
+ * The result of this method is identical to calling
+ * ``Crypto_SHA512_Update(contexts[i], buffers[i], counts[i])`` for every
+ * `i` in `0 ..< n`. The hash functions must be distinct.
+ *
+ * - Parameters:
+ *   - contexts: An array of `n` SHA512 hash functions.
+ *   - buffers: An array of `n` pointers to the next block of data for each
+ *              ongoing digest calculation.
+ *   - counts: An array of `n` byte counts, one for each buffer.
+ *   - n: The number of hash functions to update.
+ */
+void Crypto_SHA512xN_Update(struct Crypto_SHA512_Context* const contexts[],
+                            const UInt8* const buffers[],
+                            const Int64 counts[],
+                            Int32 n);
+
+/**
+ * Computes the SHA512 digests of several buffers in one call.
+ *
+ * Use this method to hash many short messages, such as the entries of a
+ * password vault, with a single call across the WebAssembly boundary.
+ * Messages of at most 111 bytes are compressed four at a time; longer
+ * messages are hashed as by ``Crypto_SHA512_Hash()``. Large batches are
+ * spread over the threads of the task pool once it is started (see
+ * ``TaskPoolStart()``).
+ *
+ * - Parameters:
+ *   - buffers: An array of `n` pointers to the data to hash.
+ *   - counts: An array of `n` byte counts, one for each buffer.
+ *   - n: The number of buffers.
+ *   - digests: A buffer of `64 * n` bytes to store the digests, in the order
+ *              of the buffers.
+ */
+void Crypto_SHA512xN_Hash(const UInt8* const buffers[],
+                          const Int64 counts[],
+                          Int32 n,
+                          UInt8* digests);
+
+/* MARK: - Allocation */
+/**
+ * Returns the number of bytes in a SHA512 hash function.
+ *
+ * Use this instead of assuming a size when allocating a hash function outside
+ * of this library; the layout may grow in future versions.
+ *
+ * - Returns: The size of `struct Crypto_SHA512_Context`.
+ */
+Int64 Crypto_SHA512_ContextSize(void);
+
+/**
+ * Returns the alignment a SHA512 hash function requires.
+ *
+ * - Returns: The alignment of `struct Crypto_SHA512_Context`, in bytes.
+ */
+Int64 Crypto_SHA512_ContextAlignment(void);
+
+/**
+ * Creates and initializes a SHA512 hash function.
+ *
+ * Hash functions are cache-line aligned objects of the slabs of
+ * ``Memory_SlabAllocate()``, so setting up many concurrent hash functions
+ * neither fragments the heap nor makes neighbouring hash functions share a
+ * cache line. This method is safe to call from multiple threads.
+ *
+ * - Returns: A SHA512 hash function ready for ``Crypto_SHA512_Update()``, or
+ *   `NULL` if the memory could not be allocated. Release it with
+ *   ``Crypto_SHA512_Destroy()``.
+ */
+struct Crypto_SHA512_Context* Crypto_SHA512_Create(void);
+
+/**
+ * Destroys a SHA512 hash function created by ``Crypto_SHA512_Create()``.
+ *
+ * - Parameter context: A SHA512 hash function, or `NULL`.
+ */
+void Crypto_SHA512_Destroy(struct Crypto_SHA512_Context* context);
+
+/* MARK: - Serialization */
+/**
+ * The number of bytes in the serialized state of a SHA512 hash function.
+ */
+#define Crypto_SHA512_StateSize 216
+
+/**
+ * Serializes the intermediate state of a hash function.
+ *
+ * The state can be restored with ``Crypto_SHA512_Import()``, in this process
+ * or another one, to resume hashing where it left off, e.g. after an upload
+ * was interrupted. The format is stable and independent of the platform:
+ *
+ * | Offset | Size | Contents                                            |
+ * |--------|------|-----------------------------------------------------|
+ * | 0      | 7    | `"SHA512"` in ASCII, followed by a zero byte        |
+ * | 7      | 1    | Version, `1`                                        |
+ * | 8      | 64   | Hash state H0 to H7, big-endian                     |
+ * | 72     | 16   | Number of bits hashed, 128-bit big-endian           |
+ * | 88     | 128  | Partial block, followed by zeroes                   |
+ *
+ * The hash function is not modified.
+ *
+ * - Parameters:
+ *   - context: A SHA512 hash function that has not been finalized.
+ *   - state: A buffer to store the serialized state.
+ */
+void Crypto_SHA512_Export(const struct Crypto_SHA512_Context* context,
+                          UInt8 state[static Crypto_SHA512_StateSize]);
+
+/**
+ * Restores a hash function from a serialized state.
+ *
+ * - Parameters:
+ *   - context: A SHA512 hash function to overwrite.
+ *   - state: A state serialized by ``Crypto_SHA512_Export()``.
+ *   - count: The number of bytes in the serialized state.
+ *
+ * - Returns: `true` if the state was restored; `false` if it is not a
+ *   serialized state of a supported version, in which case the hash function
+ *   is left untouched.
+ */
+Bool Crypto_SHA512_Import(struct Crypto_SHA512_Context* context,
+                          const UInt8* state,
+                          Int64 count);
+
+/* MARK: - Streaming */
+/**
+ * The number of bytes the host can stage in a SHA512 stream per commit.
+ */
+#define Crypto_SHA512_StreamCapacity 4194304
+
+/**
+ * A SHA512 hash function that owns its input buffer.
+ *
+ * A stream keeps a fixed, 64-byte aligned staging area of
+ * ``Crypto_SHA512_StreamCapacity`` bytes in linear memory. Instead of
+ * allocating and copying a buffer for every update, the host writes the data
+ * directly into the area returned by ``Crypto_SHA512_Stream_Buffer()`` and then
+ * commits it. Full blocks are compressed where they were written; only the
+ * last partial block of each commit is carried over, in front of the area.
+ */
+struct Crypto_SHA512_Stream;
+
+/**
+ * Creates a SHA512 stream.
+ *
+ * The stream lives in an arena of its own, so its staging area is counted by
+ * ``Memory_GetStatistics()`` and reused by the next stream once it is
+ * destroyed.
+ *
+ * - Returns: A new SHA512 stream, or `NULL` if the memory could not be
+ *   allocated. Release it with ``Crypto_SHA512_Stream_Destroy()``.
+ */
+struct Crypto_SHA512_Stream* Crypto_SHA512_Stream_Create(void);
+
+/**
+ * Destroys a SHA512 stream.
+ *
+ * - Parameter stream: A SHA512 stream, or `NULL`.
+ */
+void Crypto_SHA512_Stream_Destroy(struct Crypto_SHA512_Stream* stream);
+
+/**
+ * Returns the number of bytes a SHA512 stream occupies.
+ *
+ * Together with ``Crypto_SHA512_Stream_Init()``, this lets the host place a
+ * stream in memory it manages, such as a buffer of ``Memory_ArenaAllocate()``
+ * from an arena that it owns for the length of an operation.
+ *
+ * - Returns: The size of `struct Crypto_SHA512_Stream`.
+ */
+Int64 Crypto_SHA512_Stream_Size(void);
+
+/**
+ * Initializes a SHA512 stream in place.
+ *
+ * A stream initialized this way must not be passed to
+ * ``Crypto_SHA512_Stream_Destroy()``; release its memory instead.
+ *
+ * - Parameter stream: ``Crypto_SHA512_Stream_Size()`` bytes of 64-byte
+ *   aligned memory.
+ */
+void Crypto_SHA512_Stream_Init(struct Crypto_SHA512_Stream* stream);
+
+/**
+ * Returns the staging area of the stream.
+ *
+ * The address stays the same for the lifetime of the stream, so the host can
+ * keep a view of it. Write at most ``Crypto_SHA512_Stream_Capacity()`` bytes
+ * to it before each call to ``Crypto_SHA512_Stream_Commit()``.
+ *
+ * - Parameter stream: A SHA512 stream.
+ *
+ * - Returns: A pointer to the staging area.
+ */
+UInt8* Crypto_SHA512_Stream_Buffer(struct Crypto_SHA512_Stream* stream);
+
+/**
+ * Returns the number of bytes in the staging area of the stream.
+ *
+ * - Parameter stream: A SHA512 stream.
+ *
+ * - Returns: ``Crypto_SHA512_StreamCapacity``.
+ */
+Int64 Crypto_SHA512_Stream_Capacity(const struct Crypto_SHA512_Stream* stream);
+
+/**
+ * Hashes the first `count` bytes of the staging area.
+ *
+ * The contents of the staging area are undefined afterwards.
+ *
+ * - Parameters:
+ *   - stream: A SHA512 stream.
+ *   - count: The number of bytes written to the staging area, between 0 and
+ *            ``Crypto_SHA512_StreamCapacity``.
+ *
+ * - Returns: `true` if the bytes were hashed; `false` if `count` is out of
+ *   range, in which case the stream is left unchanged.
+ */
+Bool Crypto_SHA512_Stream_Commit(struct Crypto_SHA512_Stream* stream,
+                                 Int64 count);
+
+/**
+ * Finalizes the stream and returns the digest of all committed bytes.
+ *
+ * The stream is reset afterwards and can hash the next message.
+ *
+ * - Parameters:
+ *   - stream: A SHA512 stream.
+ *   - digest: A buffer to store the computed digest of the data.
+ */
+void Crypto_SHA512_Stream_Finalize(struct Crypto_SHA512_Stream* stream,
+                                   UInt8 digest[static 64]);
+
+/**
+ * Serializes the intermediate state of a stream.
+ *
+ * The format is the same as for ``Crypto_SHA512_Export()``, so a stream can
+ * resume the work of a hash function and vice versa.
+ *
+ * - Parameters:
+ *   - stream: A SHA512 stream.
+ *   - state: A buffer to store the serialized state.
+ */
+void Crypto_SHA512_Stream_Export(const struct Crypto_SHA512_Stream* stream,
+                                 UInt8 state[static Crypto_SHA512_StateSize]);
+
+/**
+ * Restores a stream from a serialized state.
+ *
+ * - Parameters:
+ *   - stream: A SHA512 stream to overwrite.
+ *   - state: A state serialized by ``Crypto_SHA512_Export()`` or
+ *            ``Crypto_SHA512_Stream_Export()``.
+ *   - count: The number of bytes in the serialized state.
+ *
+ * - Returns: `true` if the state was restored; otherwise, `false`, and the
+ *   stream is left untouched.
+ */
+Bool Crypto_SHA512_Stream_Import(struct Crypto_SHA512_Stream* stream,
+                                 const UInt8* state,
+                                 Int64 count);
+
 #endif /* Crypto_SHA512_h */
@@ -0,0 +1,155 @@
+//
+//  Crypto_SHA512Tree.c
+//  core-cloud-wasm
+//
+//  Created by Fang Ling on 2026/10/17.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#include "Crypto_SHA512Tree.h"
+#include "Crypto_SHA512_Private.h"
+#include "TaskPool_Private.h"
+
+/* Domain separation prefixes */
+static const UInt8 LEAF_PREFIX = 0x00;
+static const UInt8 NODE_PREFIX = 0x01;
+
+/* Leaf digest: SHA512(0x00 || chunk) */
+void Crypto_SHA512Tree_HashLeaf(const UInt8* chunk,
+                                Int64 count,
+                                UInt8 digest[static 64]) {
+  struct Crypto_SHA512_Context context;
+
+  Crypto_SHA512_Init(&context);
+  Crypto_SHA512_Update(&context, &LEAF_PREFIX, 1);
+  Crypto_SHA512_Update(&context, chunk, count);
+  Crypto_SHA512_Finalize(&context, digest);
+}
+
+/* The buffer whose chunks `Crypto_SHA512Tree_HashLeaves()` hashes */
+struct Crypto_SHA512Tree_Task {
+  const UInt8* buffer;
+  Int64 count;
+  UInt8* leaves;
+};
+
+/* Hash the four leaves from `4 * index` on, or as many as are left. */
+static void Crypto_SHA512Tree_HashLeavesx4(void* context, Int64 index) {
+  const struct Crypto_SHA512Tree_Task* task = context;
+  struct Crypto_SHA512_Context contexts[4];
+  struct Crypto_SHA512_Context* lanes[4];
+  const UInt8* prefixes[4];
+  const UInt8* chunks[4];
+  Int64 prefixCounts[4];
+  Int64 chunkCounts[4];
+
+  for (Int32 i = 0; i < 4; i += 1) {
+    lanes[i] = &contexts[i];
+    prefixes[i] = &LEAF_PREFIX;
+    prefixCounts[i] = 1;
+  }
+
+  const Int64 leafCount = (task->count + Crypto_SHA512Tree_LeafSize - 1) /
+                          Crypto_SHA512Tree_LeafSize;
+  const Int64 first = index * 4;
+  Int32 n = leafCount - first < 4 ? (Int32)(leafCount - first) : 4;
+
+  for (Int32 i = 0; i < n; i += 1) {
+    Int64 offset = (first + i) * Crypto_SHA512Tree_LeafSize;
+    chunks[i] = task->buffer + offset;
+    chunkCounts[i] = task->count - offset < Crypto_SHA512Tree_LeafSize
+                   ? task->count - offset
+                   : Crypto_SHA512Tree_LeafSize;
+    Crypto_SHA512_Init(lanes[i]);
+  }
+
+  Crypto_SHA512xN_Update(lanes, prefixes, prefixCounts, n);
+  Crypto_SHA512xN_Update(lanes, chunks, chunkCounts, n);
+
+  for (Int32 i = 0; i < n; i += 1) {
+    Crypto_SHA512_Finalize(lanes[i], task->leaves + (first + i) * 64);
+  }
+}
+
+/* Hash the chunks of a buffer four leaves per task. */
+void Crypto_SHA512Tree_HashLeaves(const UInt8* buffer,
+                                  Int64 count,
+                                  UInt8* leaves) {
+  struct Crypto_SHA512Tree_Task task = { buffer, count, leaves };
+  const Int64 leafCount = (count + Crypto_SHA512Tree_LeafSize - 1) /
+                          Crypto_SHA512Tree_LeafSize;
+
+  TaskPoolApply((leafCount + 3) / 4, &task, Crypto_SHA512Tree_HashLeavesx4);
+}
+
+/*
+ * Root of the subtree over `count` (at least one) leaves.  The recursion is
+ * as deep as the tree is tall, which is 64 levels at the very most.
+ */
+static void Crypto_SHA512Tree_Root(const UInt8* leaves,
+                                   Int64 count,
+                                   UInt8 root[static 64]) {
+  struct Crypto_SHA512_Context context;
+  UInt8 children[128];
+
+  if (count == 1) {
+    memcpy(root, leaves, 64);
+    return;
+  }
+
+  /* Largest power of two strictly less than the number of leaves */
+  Int64 split = 1;
+  while (split * 2 < count) {
+    split *= 2;
+  }
+
+  Crypto_SHA512Tree_Root(leaves, split, children);
+  Crypto_SHA512Tree_Root(leaves + split * 64, count - split, children + 64);
+
+  /* Node digest: SHA512(0x01 || left || right) */
+  Crypto_SHA512_Init(&context);
+  Crypto_SHA512_Update(&context, &NODE_PREFIX, 1);
+  Crypto_SHA512_Update(&context, children, 128);
+  Crypto_SHA512_Finalize(&context, root);
+}
+
+void Crypto_SHA512Tree_Combine(const UInt8* leaves,
+                               Int64 count,
+                               UInt8 root[static 64]) {
+  struct Crypto_SHA512_Context context;
+
+  if (count == 0) {
+    Crypto_SHA512_Init(&context);
+    Crypto_SHA512_Finalize(&context, root);
+    return;
+  }
+
+  Crypto_SHA512Tree_Root(leaves, count, root);
+}
+
+Bool Crypto_SHA512Tree_VerifyLeaf(const UInt8* chunk,
+                                  Int64 count,
+                                  const UInt8 digest[static 64]) {
+  UInt8 actual[64];
+  UInt8 difference = 0;
+
+  Crypto_SHA512Tree_HashLeaf(chunk, count, actual);
+
+  /* Compare without an early exit, so timing doesn't reveal the mismatch. */
+  for (Int32 i = 0; i < 64; i += 1) {
+    difference |= actual[i] ^ digest[i];
+  }
+
+  return difference == 0;
+}
@@ -0,0 +1,102 @@
+//
+//  Crypto_SHA512Tree.h
+//  core-cloud-wasm
+//
+//  Created by Fang Ling on 2026/10/17.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#ifndef Crypto_SHA512Tree_h
+#define Crypto_SHA512Tree_h
+
+#include "Base.h"
+
+/**
+ * The number of bytes in each leaf of a SHA512 hash tree, 4 MiB.
+ *
+ * This matches the chunk size the server stores files in, so that every
+ * stored chunk can be checked against its own leaf digest.
+ */
+#define Crypto_SHA512Tree_LeafSize 4194304
+
+/**
+ * Computes the digest of a single leaf of a SHA512 hash tree.
+ *
+ * A leaf digest is the SHA512 digest of the byte `0x00` followed by the
+ * contents of the chunk. Because the leaves don't depend on each other, the
+ * chunks of a file can be hashed in any order and on any number of threads.
+ *
+ * - Parameters:
+ *   - chunk: A pointer to the contents of the chunk.
+ *   - count: The number of bytes in the chunk, at most
+ *            ``Crypto_SHA512Tree_LeafSize``.
+ *   - digest: A buffer to store the computed leaf digest.
+ */
+void Crypto_SHA512Tree_HashLeaf(const UInt8* chunk,
+                                Int64 count,
+                                UInt8 digest[static 64]);
+
+/**
+ * Computes the leaf digests of every chunk of a buffer.
+ *
+ * The buffer is split into chunks of ``Crypto_SHA512Tree_LeafSize`` bytes,
+ * the last of which may be shorter, and the chunks are hashed four at a time,
+ * on the threads of the task pool once it is started (see ``TaskPoolStart()``).
+ * An empty buffer has no leaves.
+ *
+ * - Parameters:
+ *   - buffer: A pointer to the data to hash.
+ *   - count: The number of bytes in the buffer.
+ *   - leaves: A buffer to store the computed leaf digests, 64 bytes for each
+ *             chunk of the buffer.
+ */
+void Crypto_SHA512Tree_HashLeaves(const UInt8* buffer,
+                                  Int64 count,
+                                  UInt8* leaves);
+
+/**
+ * Combines the leaf digests of a SHA512 hash tree into its root digest.
+ *
+ * An interior node is the SHA512 digest of the byte `0x01` followed by the
+ * digests of its two children. The leaves are split the same way as a
+ * Certificate Transparency log (RFC 6962): the left subtree holds the largest
+ * power of two strictly less than the number of leaves. The root of a tree
+ * without leaves is the SHA512 digest of the empty string.
+ *
+ * - Parameters:
+ *   - leaves: The leaf digests, 64 bytes each, in chunk order.
+ *   - count: The number of leaf digests.
+ *   - root: A buffer to store the computed root digest.
+ */
+void Crypto_SHA512Tree_Combine(const UInt8* leaves,
+                               Int64 count,
+                               UInt8 root[static 64]);
+
+/**
+ * Checks a single chunk against its stored leaf digest.
+ *
+ * The digests are compared in constant time.
+ *
+ * - Parameters:
+ *   - chunk: A pointer to the contents of the chunk.
+ *   - count: The number of bytes in the chunk.
+ *   - digest: The expected leaf digest of the chunk.
+ *
+ * - Returns: `true` if the chunk hashes to `digest`; otherwise, `false`.
+ */
+Bool Crypto_SHA512Tree_VerifyLeaf(const UInt8* chunk,
+                                  Int64 count,
+                                  const UInt8 digest[static 64]);
+
+#endif /* Crypto_SHA512Tree_h */
@@ -0,0 +1,48 @@
+//
+//  Crypto_SHA512_Private.h
+//  core-cloud-wasm
+//
+//  Created by Fang Ling on 2026/10/17.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#ifndef Crypto_SHA512_Private_h
+#define Crypto_SHA512_Private_h
+
+#include "Crypto_SHA512.h"
+
+/*
+ * The layout of the SHA512 hash function.  Only the sources of this library
+ * may depend on it, e.g. to keep a hash function on the stack; callers outside
+ * of it treat the context as opaque.
+ */
+struct Crypto_SHA512_Context {
+  UInt64 state[8];
+  UInt64 count[2];
+  UInt8 buffer[128];
+};
+
+/*
+ * Compress the final block of a 192-byte message into `state`: a full block
+ * that `state` has already absorbed, followed by the 64 bytes `message` as
+ * big-endian words.  The padding is implied, which makes this the whole
+ * per-iteration cost of HMAC-SHA512 over a 64-byte value.
+ */
+void Crypto_SHA512_Transform64(UInt64 state[8], const UInt64 message[8]);
+
+/* `Crypto_SHA512_Transform64()` for four independent states at once. */
+void Crypto_SHA512_Transform64x4(UInt64* states[4],
+                                 const UInt64* messages[4]);
+
+#endif /* Crypto_SHA512_Private_h */
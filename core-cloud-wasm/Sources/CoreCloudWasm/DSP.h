@@ -21,6 +21,10 @@
 #define DSP_h
 
 #include "DSPDCT.h"
+#include "DSPDCTSetup.h"
+#include "DSPIDCT.h"
+#include "DSPImage.h"
 #include "DSPMatrix.h"
+#include "DSPPolyphase.h"
 
 #endif /* DSP_h */
@@ -42,8 +42,11 @@
  */
 
 #include "DSPDCT.h"
+#include "DSPMatrix.h"
+#include "DSPVector.h"
+#include "TaskPool_Private.h"
 
-#define MULH3(x, y, s) ((s)*(y)*(x))
+#define MULH3(x, y, s) DCT32_MUL(x, (s)*(y))
 
 /* tab[i][j] = 1.0 / (2.0 * cos(pi*(2*k+1) / 2^(6 - j))) */
 
@@ -85,225 +88,266 @@
 
 #define COS4_0 (Float32)(0.707106781186547524400844362104849039 / 2)
 
+#define LOAD(i) DCT32_LOAD(input + (i) * stride)
+#define STORE(i, x) DCT32_STORE(output + (i) * stride, x)
+
 /* butterfly operator */
-#define BF(a, b, c, s) {               \
-  alpha = value##a + value##b;         \
-  beta = value##a - value##b;          \
-  value##a = alpha;                    \
-  value##b = MULH3(beta, c, 1 << (s)); \
+#define BF(a, b, c, s) {                 \
+  alpha = DCT32_ADD(value##a, value##b); \
+  beta = DCT32_SUB(value##a, value##b);  \
+  value##a = alpha;                      \
+  value##b = MULH3(beta, c, 1 << (s));   \
 }
 
-#define BF0(a, b, c, s) {              \
-  alpha = input[a] + input[b];         \
-  beta = input[a] - input[b];          \
-  value##a = alpha;                    \
-  value##b = MULH3(beta, c, 1 << (s)); \
+#define BF0(a, b, c, s) {                \
+  alpha = DCT32_ADD(LOAD(a), LOAD(b));   \
+  beta = DCT32_SUB(LOAD(a), LOAD(b));    \
+  value##a = alpha;                      \
+  value##b = MULH3(beta, c, 1 << (s));   \
 }
 
 #define BF1(a, b, c, d) { \
   BF(a, b, COS4_0, 1);    \
   BF(c, d, -COS4_0, 1);   \
-  value##c += value##d;   \
+  ADD(c, d);              \
 }
 
 #define BF2(a, b, c, d) { \
   BF(a, b, COS4_0, 1);    \
   BF(c, d, -COS4_0, 1);   \
-  value##c += value##d;   \
-  value##a += value##c;   \
-  value##c += value##b;   \
-  value##b += value##d;   \
+  ADD(c, d);              \
+  ADD(a, c);              \
+  ADD(c, b);              \
+  ADD(b, d);              \
 }
 
-#define ADD(a, b) value##a += value##b
+#define ADD(a, b) value##a = DCT32_ADD(value##a, value##b)
+
+/* MARK: - Scalar */
+#define DCT32_FUNCTION    DSPDCT32ExecuteStride
+#define DCT32_VALUE       Float32
+#define DCT32_LOAD(p)     (*(p))
+#define DCT32_STORE(p, x) (*(p) = (x))
+#define DCT32_ADD(x, y)   ((x) + (y))
+#define DCT32_SUB(x, y)   ((x) - (y))
+#define DCT32_MUL(x, c)   ((x) * (c))
+#include "DSPDCT32Template.h"
+#undef DCT32_FUNCTION
+#undef DCT32_VALUE
+#undef DCT32_LOAD
+#undef DCT32_STORE
+#undef DCT32_ADD
+#undef DCT32_SUB
+#undef DCT32_MUL
 
-/* DCT32 without 1/sqrt(2) coef zero scaling. */
 void DSPDCT32Execute(const Float32* input, Float32* output) {
-  Float32 alpha;
-  Float32 beta;
-  Float32 value0;
-  Float32 value1;
-  Float32 value2;
-  Float32 value3;
-  Float32 value4;
-  Float32 value5;
-  Float32 value6;
-  Float32 value7;
-  Float32 value8;
-  Float32 value9;
-  Float32 value10;
-  Float32 value11;
-  Float32 value12;
-  Float32 value13;
-  Float32 value14;
-  Float32 value15;
-  Float32 value16;
-  Float32 value17;
-  Float32 value18;
-  Float32 value19;
-  Float32 value20;
-  Float32 value21;
-  Float32 value22;
-  Float32 value23;
-  Float32 value24;
-  Float32 value25;
-  Float32 value26;
-  Float32 value27;
-  Float32 value28;
-  Float32 value29;
-  Float32 value30;
-  Float32 value31;
-
-  /* pass 1 */
-  BF0( 0, 31, COS0_0 , 1);
-  BF0(15, 16, COS0_15, 5);
-  /* pass 2 */
-  BF( 0, 15, COS1_0 , 1);
-  BF(16, 31, -COS1_0, 1);
-  /* pass 1 */
-  BF0( 7, 24, COS0_7 , 1);
-  BF0( 8, 23, COS0_8 , 1);
-  /* pass 2 */
-  BF( 7,  8, COS1_7 , 4);
-  BF(23, 24, -COS1_7, 4);
-  /* pass 3 */
-  BF( 0,  7, COS2_0 , 1);
-  BF( 8, 15, -COS2_0, 1);
-  BF(16, 23, COS2_0 , 1);
-  BF(24, 31, -COS2_0, 1);
-  /* pass 1 */
-  BF0( 3, 28, COS0_3 , 1);
-  BF0(12, 19, COS0_12, 2);
-  /* pass 2 */
-  BF( 3, 12, COS1_3 , 1);
-  BF(19, 28, -COS1_3, 1);
-  /* pass 1 */
-  BF0( 4, 27, COS0_4 , 1);
-  BF0(11, 20, COS0_11, 2);
-  /* pass 2 */
-  BF( 4, 11, COS1_4 , 1);
-  BF(20, 27, -COS1_4, 1);
-  /* pass 3 */
-  BF( 3,  4, COS2_3 , 3);
-  BF(11, 12, -COS2_3, 3);
-  BF(19, 20, COS2_3 , 3);
-  BF(27, 28, -COS2_3, 3);
-  /* pass 4 */
-  BF( 0,  3, COS3_0 , 1);
-  BF( 4,  7, -COS3_0, 1);
-  BF( 8, 11, COS3_0 , 1);
-  BF(12, 15, -COS3_0, 1);
-  BF(16, 19, COS3_0 , 1);
-  BF(20, 23, -COS3_0, 1);
-  BF(24, 27, COS3_0 , 1);
-  BF(28, 31, -COS3_0, 1);
-
-
-
-  /* pass 1 */
-  BF0( 1, 30, COS0_1 , 1);
-  BF0(14, 17, COS0_14, 3);
-  /* pass 2 */
-  BF( 1, 14, COS1_1 , 1);
-  BF(17, 30, -COS1_1, 1);
-  /* pass 1 */
-  BF0( 6, 25, COS0_6 , 1);
-  BF0( 9, 22, COS0_9 , 1);
-  /* pass 2 */
-  BF( 6,  9, COS1_6 , 2);
-  BF(22, 25, -COS1_6, 2);
-  /* pass 3 */
-  BF( 1,  6, COS2_1 , 1);
-  BF( 9, 14, -COS2_1, 1);
-  BF(17, 22, COS2_1 , 1);
-  BF(25, 30, -COS2_1, 1);
-
-  /* pass 1 */
-  BF0( 2, 29, COS0_2 , 1);
-  BF0(13, 18, COS0_13, 3);
-  /* pass 2 */
-  BF( 2, 13, COS1_2 , 1);
-  BF(18, 29, -COS1_2, 1);
-  /* pass 1 */
-  BF0( 5, 26, COS0_5 , 1);
-  BF0(10, 21, COS0_10, 1);
-  /* pass 2 */
-  BF( 5, 10, COS1_5 , 2);
-  BF(21, 26, -COS1_5, 2);
-  /* pass 3 */
-  BF( 2,  5, COS2_2 , 1);
-  BF(10, 13, -COS2_2, 1);
-  BF(18, 21, COS2_2 , 1);
-  BF(26, 29, -COS2_2, 1);
-  /* pass 4 */
-  BF( 1,  2, COS3_1 , 2);
-  BF( 5,  6, -COS3_1, 2);
-  BF( 9, 10, COS3_1 , 2);
-  BF(13, 14, -COS3_1, 2);
-  BF(17, 18, COS3_1 , 2);
-  BF(21, 22, -COS3_1, 2);
-  BF(25, 26, COS3_1 , 2);
-  BF(29, 30, -COS3_1, 2);
-
-  /* pass 5 */
-  BF1( 0,  1,  2,  3);
-  BF2( 4,  5,  6,  7);
-  BF1( 8,  9, 10, 11);
-  BF2(12, 13, 14, 15);
-  BF1(16, 17, 18, 19);
-  BF2(20, 21, 22, 23);
-  BF1(24, 25, 26, 27);
-  BF2(28, 29, 30, 31);
-
-  /* pass 6 */
-
-  ADD( 8, 12);
-  ADD(12, 10);
-  ADD(10, 14);
-  ADD(14,  9);
-  ADD( 9, 13);
-  ADD(13, 11);
-  ADD(11, 15);
-
-  output[ 0] = value0;
-  output[16] = value1;
-  output[ 8] = value2;
-  output[24] = value3;
-  output[ 4] = value4;
-  output[20] = value5;
-  output[12] = value6;
-  output[28] = value7;
-  output[ 2] = value8;
-  output[18] = value9;
-  output[10] = value10;
-  output[26] = value11;
-  output[ 6] = value12;
-  output[22] = value13;
-  output[14] = value14;
-  output[30] = value15;
-
-  ADD(24, 28);
-  ADD(28, 26);
-  ADD(26, 30);
-  ADD(30, 25);
-  ADD(25, 29);
-  ADD(29, 27);
-  ADD(27, 31);
-
-  output[ 1] = value16 + value24;
-  output[17] = value17 + value25;
-  output[ 9] = value18 + value26;
-  output[25] = value19 + value27;
-  output[ 5] = value20 + value28;
-  output[21] = value21 + value29;
-  output[13] = value22 + value30;
-  output[29] = value23 + value31;
-  output[ 3] = value24 + value20;
-  output[19] = value25 + value21;
-  output[11] = value26 + value22;
-  output[27] = value27 + value23;
-  output[ 7] = value28 + value18;
-  output[23] = value29 + value19;
-  output[15] = value30 + value17;
-  output[31] = value31;
+  DSPDCT32ExecuteStride(input, output, 1);
+}
+
+/* MARK: - Batch */
+#define DCT32_FUNCTION    DSPDCT32ExecuteVector
+#define DCT32_VALUE       Vector
+#define DCT32_LOAD(p)     VLOAD(p)
+#define DCT32_STORE(p, x) VSTORE(p, x)
+#define DCT32_ADD(x, y)   VADD(x, y)
+#define DCT32_SUB(x, y)   VSUB(x, y)
+#define DCT32_MUL(x, c)   VMUL(x, VSPLAT(c))
+#include "DSPDCT32Template.h"
+#undef DCT32_FUNCTION
+#undef DCT32_VALUE
+#undef DCT32_LOAD
+#undef DCT32_STORE
+#undef DCT32_ADD
+#undef DCT32_SUB
+#undef DCT32_MUL
+
+/*
+ * Number of transforms in each task of `DSPDCT32ExecuteBatch()`, a multiple
+ * of `DSPDCT32TileCount` so that every task splits its transforms between
+ * the kernels as a single thread would.
+ */
+#define DSPDCT32TaskCount 256
+
+/*
+ * Number of adjacent transforms staged together, four 64-byte cache lines of
+ * each of the 32 elements.  When the stride is a multiple of
+ * `DSPDCT32TileStride`, the 32 elements of a transform fall into at most four
+ * sets of a 4 KiB-way cache, so storing them `VLANES` at a time evicts each
+ * line before the next lanes of it are written.  Other strides go straight to
+ * the vector kernel, which the extra copies would only slow down.
+ */
+#define DSPDCT32TileCount 64
+#define DSPDCT32TileStride 256
+
+/* The vector kernel once more, with the stride of a tile built in */
+#undef LOAD
+#undef STORE
+#define LOAD(i) DCT32_LOAD(input + (i) * DSPDCT32TileCount)
+#define STORE(i, x) DCT32_STORE(output + (i) * DSPDCT32TileCount, x)
+#define DCT32_FUNCTION    DSPDCT32ExecuteTileVector
+#define DCT32_VALUE       Vector
+#define DCT32_LOAD(p)     VLOAD(p)
+#define DCT32_STORE(p, x) VSTORE(p, x)
+#define DCT32_ADD(x, y)   VADD(x, y)
+#define DCT32_SUB(x, y)   VSUB(x, y)
+#define DCT32_MUL(x, c)   VMUL(x, VSPLAT(c))
+#include "DSPDCT32Template.h"
+#undef DCT32_FUNCTION
+#undef DCT32_VALUE
+#undef DCT32_LOAD
+#undef DCT32_STORE
+#undef DCT32_ADD
+#undef DCT32_SUB
+#undef DCT32_MUL
+
+/* Copies the rows `first` to `last` of a tile between two layouts. */
+static void DSPDCT32CopyRows(Float32* destination,
+                             Int32 destinationStride,
+                             const Float32* source,
+                             Int32 sourceStride,
+                             Int32 first,
+                             Int32 last) {
+  for (Int32 j = first; j < last; j += 1) {
+    memcpy(
+      destination + (Int64)j * destinationStride,
+      source + (Int64)j * sourceStride,
+      DSPDCT32TileCount * sizeof(Float32)
+    );
+  }
+}
+
+/*
+ * Transforms `count` vectors, a multiple of `DSPDCT32TileCount`, a tile at a
+ * time in two stack buffers.  After each kernel call on one buffer, a few
+ * rows of the other are written out to the previous tile and read in from
+ * the next one, so that the copies overlap the arithmetic instead of
+ * stalling on every line in turn.
+ */
+static void DSPDCT32ExecuteTiles(const Float32* input,
+                                 Float32* output,
+                                 Int32 count,
+                                 Int32 stride) {
+  _Alignas(64) Float32 buffers[2][32 * DSPDCT32TileCount];
+  const Int32 rowCount = 32 * VLANES / DSPDCT32TileCount;
+  const Int32 tileCount = count / DSPDCT32TileCount;
+
+  /* 1. The first tile */
+  DSPDCT32CopyRows(buffers[0], DSPDCT32TileCount, input, stride, 0, 32);
+
+  /* 2. Every tile, while exchanging the rows of its neighbors */
+  for (Int32 t = 0; t < tileCount; t += 1) {
+    Float32* current = buffers[t % 2];
+    Float32* other = buffers[1 - t % 2];
+    Int32 first = 0;
+
+    for (Int32 i = 0; i < DSPDCT32TileCount; i += VLANES) {
+      if (t > 0) {
+        DSPDCT32CopyRows(
+          output + (t - 1) * DSPDCT32TileCount,
+          stride,
+          other,
+          DSPDCT32TileCount,
+          first,
+          first + rowCount
+        );
+      }
+      if (t + 1 < tileCount) {
+        DSPDCT32CopyRows(
+          other,
+          DSPDCT32TileCount,
+          input + (t + 1) * DSPDCT32TileCount,
+          stride,
+          first,
+          first + rowCount
+        );
+      }
+      DSPDCT32ExecuteTileVector(current + i, current + i, DSPDCT32TileCount);
+      first += rowCount;
+    }
+  }
+
+  /* 3. The last tile */
+  DSPDCT32CopyRows(
+    output + (tileCount - 1) * DSPDCT32TileCount,
+    stride,
+    buffers[(tileCount - 1) % 2],
+    DSPDCT32TileCount,
+    0,
+    32
+  );
+}
+
+/* The arguments of `DSPDCT32ExecuteBatch()` */
+struct DSPDCT32Task {
+  const Float32* input;
+  Float32* output;
+  Int32 count;
+  Int32 stride;
+};
+
+/* Transforms the vectors from `DSPDCT32TaskCount * index` on. */
+static void DSPDCT32ExecuteTask(void* context, Int64 index) {
+  const struct DSPDCT32Task* task = context;
+  Int32 first = (Int32)index * DSPDCT32TaskCount;
+  Int32 count = task->count - first < DSPDCT32TaskCount
+              ? task->count - first
+              : DSPDCT32TaskCount;
+  Int32 i = 0;
+
+  /* Whole tiles on aliasing strides, then `VLANES` transforms per call */
+  if (
+    task->stride % DSPDCT32TileStride == 0 &&
+    count >= DSPDCT32TileCount
+  ) {
+    i = count - count % DSPDCT32TileCount;
+    DSPDCT32ExecuteTiles(
+      task->input + first,
+      task->output + first,
+      i,
+      task->stride
+    );
+  }
+  for (; i + VLANES <= count; i += VLANES) {
+    DSPDCT32ExecuteVector(
+      task->input + first + i,
+      task->output + first + i,
+      task->stride
+    );
+  }
+
+  /* The remaining transforms, one at a time */
+  for (; i < count; i += 1) {
+    DSPDCT32ExecuteStride(
+      task->input + first + i,
+      task->output + first + i,
+      task->stride
+    );
+  }
+}
+
+void DSPDCT32ExecuteBatch(const Float32* input,
+                          Float32* output,
+                          Int32 count,
+                          Int32 stride) {
+  struct DSPDCT32Task task = { input, output, count, stride };
+
+  TaskPoolApply(
+    (count + DSPDCT32TaskCount - 1) / DSPDCT32TaskCount,
+    &task,
+    DSPDCT32ExecuteTask
+  );
+}
+
+/* MARK: - 2-D */
+/* The rows are the columns of the transpose, which the batch reads as is. */
+void DSPDCT2D32x32(const Float32* input, Float32* output) {
+  Float32 buffer[32 * 32];
+
+  /* 1. Rows */
+  DSPMatrixTranspose32x32(input, buffer);
+  DSPDCT32ExecuteBatch(buffer, buffer, 32, 32);
+
+  /* 2. Columns */
+  DSPMatrixTranspose32x32(buffer, output);
+  DSPDCT32ExecuteBatch(output, output, 32, 32);
 }
@@ -64,4 +64,52 @@
  */
 void DSPDCT32Execute(const Float32* input, Float32* output);
 
+/**
+ * Computes the type-II DCT of ``DSPDCT32Execute()`` for many vectors at once.
+ *
+ * The vectors are stored in a structure-of-arrays layout: element `j` of
+ * vector `i` is at `j * stride + i`. Adjacent vectors fill the lanes of the
+ * SIMD registers, so one pass of the butterfly network transforms 4 vectors
+ * (8 with AVX). Large batches are spread over the threads of the task pool
+ * once it is started (see ``TaskPoolStart()``).
+ *
+ * With 4 lanes, a batch runs about 4 times as fast as one
+ * ``DSPDCT32Execute()`` call per vector. A stride that is a multiple of 256
+ * puts all 32 elements of a vector into the same few cache sets, so such
+ * batches are copied through stack buffers in tiles of 64 vectors, and run
+ * about 3 times as fast instead (somewhat less without `-O3`).
+ *
+ * - Parameters:
+ *   - input: Single-precision input vectors that contain 32 elements each.
+ *   - output: Single-precision output vectors that contain 32 elements each,
+ *             in the same layout as `input`. It may be the same buffer as
+ *             `input`.
+ *   - count: The number of vectors to transform.
+ *   - stride: The distance between two elements of the same vector, at
+ *             least `count`.
+ */
+void DSPDCT32ExecuteBatch(const Float32* input,
+                          Float32* output,
+                          Int32 count,
+                          Int32 stride);
+
+/**
+ * Computes a two-dimensional type-II out-of-place single-precision real
+ * discrete cosine transform of a 32x32 matrix.
+ *
+ *     // `h` is the input matrix that contains real numbers.
+ *     // `H` is the output matrix that contains real numbers.
+ *
+ *     For 0 <= u < 32, 0 <= v < 32
+ *       H[u][v] = sum(h[y][x] * cos(u * (y+1/2) * pi / 32)
+ *                             * cos(v * (x+1/2) * pi / 32), 0 <= y, x < 32)
+ *
+ * - Parameters:
+ *   - input: Single-precision row-major input matrix that contains 32x32
+ *            elements.
+ *   - output: Single-precision row-major output matrix that contains 32x32
+ *             elements. It may be the same matrix as `input`.
+ */
+void DSPDCT2D32x32(const Float32* input, Float32* output);
+
 #endif /* DSPDCT_h */
@@ -0,0 +1,250 @@
+//
+//  DSPDCT32Template.h
+//  core-cloud-wasm
+//
+//  Created by Fang Ling on 2025/11/1.
+//
+//  This library is free software; you can redistribute it and/or
+//  modify it under the terms of the GNU Lesser General Public
+//  License as published by the Free Software Foundation; either
+//  version 2.1 of the License, or (at your option) any later version.
+//
+//  This library is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//  Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with this library; if not, write to the Free Software
+//  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+//  USA
+//
+
+/*
+ * Template for the Discrete Cosine Transform for 32 samples
+ * Copyright (c) 2001, 2002 Fabrice Bellard
+ *
+ * This file is part of FFmpeg.
+ *
+ * FFmpeg is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * FFmpeg is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with FFmpeg; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/*
+ * The body of the 32-point DCT, instantiated by DSPDCT.c once per sample type
+ * with its butterfly macros.  The includer also defines:
+ *
+ *   DCT32_FUNCTION     the name of the function
+ *   DCT32_VALUE        the type of a sample
+ *   DCT32_LOAD(p)      loads a sample from `p`
+ *   DCT32_STORE(p, x)  stores the sample `x` to `p`
+ *   DCT32_ADD(x, y)    x + y
+ *   DCT32_SUB(x, y)    x - y
+ *   DCT32_MUL(x, c)    x * c, for a Float32 constant `c`
+ *
+ * Element j of the input and output is at `j * stride`.
+ */
+
+/* DCT32 without 1/sqrt(2) coef zero scaling. */
+static inline void DCT32_FUNCTION(const Float32* input,
+                                  Float32* output,
+                                  Int32 stride) {
+  DCT32_VALUE alpha;
+  DCT32_VALUE beta;
+  DCT32_VALUE value0;
+  DCT32_VALUE value1;
+  DCT32_VALUE value2;
+  DCT32_VALUE value3;
+  DCT32_VALUE value4;
+  DCT32_VALUE value5;
+  DCT32_VALUE value6;
+  DCT32_VALUE value7;
+  DCT32_VALUE value8;
+  DCT32_VALUE value9;
+  DCT32_VALUE value10;
+  DCT32_VALUE value11;
+  DCT32_VALUE value12;
+  DCT32_VALUE value13;
+  DCT32_VALUE value14;
+  DCT32_VALUE value15;
+  DCT32_VALUE value16;
+  DCT32_VALUE value17;
+  DCT32_VALUE value18;
+  DCT32_VALUE value19;
+  DCT32_VALUE value20;
+  DCT32_VALUE value21;
+  DCT32_VALUE value22;
+  DCT32_VALUE value23;
+  DCT32_VALUE value24;
+  DCT32_VALUE value25;
+  DCT32_VALUE value26;
+  DCT32_VALUE value27;
+  DCT32_VALUE value28;
+  DCT32_VALUE value29;
+  DCT32_VALUE value30;
+  DCT32_VALUE value31;
+
+  /* pass 1 */
+  BF0( 0, 31, COS0_0 , 1);
+  BF0(15, 16, COS0_15, 5);
+  /* pass 2 */
+  BF( 0, 15, COS1_0 , 1);
+  BF(16, 31, -COS1_0, 1);
+  /* pass 1 */
+  BF0( 7, 24, COS0_7 , 1);
+  BF0( 8, 23, COS0_8 , 1);
+  /* pass 2 */
+  BF( 7,  8, COS1_7 , 4);
+  BF(23, 24, -COS1_7, 4);
+  /* pass 3 */
+  BF( 0,  7, COS2_0 , 1);
+  BF( 8, 15, -COS2_0, 1);
+  BF(16, 23, COS2_0 , 1);
+  BF(24, 31, -COS2_0, 1);
+  /* pass 1 */
+  BF0( 3, 28, COS0_3 , 1);
+  BF0(12, 19, COS0_12, 2);
+  /* pass 2 */
+  BF( 3, 12, COS1_3 , 1);
+  BF(19, 28, -COS1_3, 1);
+  /* pass 1 */
+  BF0( 4, 27, COS0_4 , 1);
+  BF0(11, 20, COS0_11, 2);
+  /* pass 2 */
+  BF( 4, 11, COS1_4 , 1);
+  BF(20, 27, -COS1_4, 1);
+  /* pass 3 */
+  BF( 3,  4, COS2_3 , 3);
+  BF(11, 12, -COS2_3, 3);
+  BF(19, 20, COS2_3 , 3);
+  BF(27, 28, -COS2_3, 3);
+  /* pass 4 */
+  BF( 0,  3, COS3_0 , 1);
+  BF( 4,  7, -COS3_0, 1);
+  BF( 8, 11, COS3_0 , 1);
+  BF(12, 15, -COS3_0, 1);
+  BF(16, 19, COS3_0 , 1);
+  BF(20, 23, -COS3_0, 1);
+  BF(24, 27, COS3_0 , 1);
+  BF(28, 31, -COS3_0, 1);
+
+
+
+  /* pass 1 */
+  BF0( 1, 30, COS0_1 , 1);
+  BF0(14, 17, COS0_14, 3);
+  /* pass 2 */
+  BF( 1, 14, COS1_1 , 1);
+  BF(17, 30, -COS1_1, 1);
+  /* pass 1 */
+  BF0( 6, 25, COS0_6 , 1);
+  BF0( 9, 22, COS0_9 , 1);
+  /* pass 2 */
+  BF( 6,  9, COS1_6 , 2);
+  BF(22, 25, -COS1_6, 2);
+  /* pass 3 */
+  BF( 1,  6, COS2_1 , 1);
+  BF( 9, 14, -COS2_1, 1);
+  BF(17, 22, COS2_1 , 1);
+  BF(25, 30, -COS2_1, 1);
+
+  /* pass 1 */
+  BF0( 2, 29, COS0_2 , 1);
+  BF0(13, 18, COS0_13, 3);
+  /* pass 2 */
+  BF( 2, 13, COS1_2 , 1);
+  BF(18, 29, -COS1_2, 1);
+  /* pass 1 */
+  BF0( 5, 26, COS0_5 , 1);
+  BF0(10, 21, COS0_10, 1);
+  /* pass 2 */
+  BF( 5, 10, COS1_5 , 2);
+  BF(21, 26, -COS1_5, 2);
+  /* pass 3 */
+  BF( 2,  5, COS2_2 , 1);
+  BF(10, 13, -COS2_2, 1);
+  BF(18, 21, COS2_2 , 1);
+  BF(26, 29, -COS2_2, 1);
+  /* pass 4 */
+  BF( 1,  2, COS3_1 , 2);
+  BF( 5,  6, -COS3_1, 2);
+  BF( 9, 10, COS3_1 , 2);
+  BF(13, 14, -COS3_1, 2);
+  BF(17, 18, COS3_1 , 2);
+  BF(21, 22, -COS3_1, 2);
+  BF(25, 26, COS3_1 , 2);
+  BF(29, 30, -COS3_1, 2);
+
+  /* pass 5 */
+  BF1( 0,  1,  2,  3);
+  BF2( 4,  5,  6,  7);
+  BF1( 8,  9, 10, 11);
+  BF2(12, 13, 14, 15);
+  BF1(16, 17, 18, 19);
+  BF2(20, 21, 22, 23);
+  BF1(24, 25, 26, 27);
+  BF2(28, 29, 30, 31);
+
+  /* pass 6 */
+
+  ADD( 8, 12);
+  ADD(12, 10);
+  ADD(10, 14);
+  ADD(14,  9);
+  ADD( 9, 13);
+  ADD(13, 11);
+  ADD(11, 15);
+
+  STORE( 0, value0);
+  STORE(16, value1);
+  STORE( 8, value2);
+  STORE(24, value3);
+  STORE( 4, value4);
+  STORE(20, value5);
+  STORE(12, value6);
+  STORE(28, value7);
+  STORE( 2, value8);
+  STORE(18, value9);
+  STORE(10, value10);
+  STORE(26, value11);
+  STORE( 6, value12);
+  STORE(22, value13);
+  STORE(14, value14);
+  STORE(30, value15);
+
+  ADD(24, 28);
+  ADD(28, 26);
+  ADD(26, 30);
+  ADD(30, 25);
+  ADD(25, 29);
+  ADD(29, 27);
+  ADD(27, 31);
+
+  STORE( 1, DCT32_ADD(value16, value24));
+  STORE(17, DCT32_ADD(value17, value25));
+  STORE( 9, DCT32_ADD(value18, value26));
+  STORE(25, DCT32_ADD(value19, value27));
+  STORE( 5, DCT32_ADD(value20, value28));
+  STORE(21, DCT32_ADD(value21, value29));
+  STORE(13, DCT32_ADD(value22, value30));
+  STORE(29, DCT32_ADD(value23, value31));
+  STORE( 3, DCT32_ADD(value24, value20));
+  STORE(19, DCT32_ADD(value25, value21));
+  STORE(11, DCT32_ADD(value26, value22));
+  STORE(27, DCT32_ADD(value27, value23));
+  STORE( 7, DCT32_ADD(value28, value18));
+  STORE(23, DCT32_ADD(value29, value19));
+  STORE(15, DCT32_ADD(value30, value17));
+  STORE(31, value31);
+}
@@ -0,0 +1,498 @@
+//
+//  DSPDCTSetup.c
+//  core-cloud-wasm
+//
+//  Created by Fang Ling on 2026/10/17.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#include "DSPDCTSetup_Private.h"
+#include "DSPDCT.h"
+
+#include <math.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+
+/*
+ * Every size is reduced to the unrolled 8 and 32-point codelets and to
+ * type-IV transforms:
+ *
+ *   DCT-II(N)  = DCT-II(N/2) of the folded sums and DCT-IV(N/2) of the folded
+ *                differences, interleaved
+ *   DCT-III(N) = the transpose of the above
+ *   DCT-IV(N)  = a complex FFT of N/2 points between two rotations
+ *
+ * All twiddle factors are computed in double precision when the setup is
+ * created, or once for every setup by `DSPDCTSetupInitialize()`.
+ */
+
+/* log2(DSPDCTMaximumCount) + 1 */
+#define DSPDCTLevelCount 13
+
+struct DSPDCTSetup {
+  Int32 count;
+  enum DSPDCTType type;
+  /* The number of points of the largest FFT */
+  Int32 twiddleCount;
+  /* e^(-2 pi i j / twiddleCount) for 0 <= j < twiddleCount / 2 */
+  Float32* twiddles;
+  /* Per DCT-IV size 2^i >= 16: N/2 pre-rotations, then N/2 post-rotations */
+  Float32* rotations[DSPDCTLevelCount];
+  /* Per DCT-IV size 2^i >= 16: the bit reversal of the N/2-point FFT */
+  Int32* reversals[DSPDCTLevelCount];
+  /* The 8-point DCT-IV matrix */
+  Float32 kernel[64];
+  /* 2 * count elements of scratch memory */
+  Float32* buffer;
+};
+
+/* MARK: - Codelets */
+/* cos(i*pi/16) */
+#define C1 (Float32)0.98078528040323044913
+#define C2 (Float32)0.92387953251128675613
+#define C3 (Float32)0.83146961230254523708
+#define C4 (Float32)0.70710678118654752440
+#define C5 (Float32)0.55557023301960222474
+#define C6 (Float32)0.38268343236508977173
+#define C7 (Float32)0.19509032201612826785
+
+/* DCT8 without 1/sqrt(2) coef zero scaling. */
+static void DSPDCT8ExecuteII(const Float32* input, Float32* output) {
+  Float32 s0 = input[0] + input[7];
+  Float32 s1 = input[1] + input[6];
+  Float32 s2 = input[2] + input[5];
+  Float32 s3 = input[3] + input[4];
+  Float32 d0 = input[0] - input[7];
+  Float32 d1 = input[1] - input[6];
+  Float32 d2 = input[2] - input[5];
+  Float32 d3 = input[3] - input[4];
+
+  /* even half: DCT-II(4) */
+  Float32 a = s0 + s3;
+  Float32 b = s1 + s2;
+  Float32 c = s0 - s3;
+  Float32 e = s1 - s2;
+  output[0] = a + b;
+  output[4] = (a - b) * C4;
+  output[2] = c * C2 + e * C6;
+  output[6] = c * C6 - e * C2;
+
+  /* odd half: DCT-IV(4) */
+  output[1] = d0 * C1 + d1 * C3 + d2 * C5 + d3 * C7;
+  output[3] = d0 * C3 - d1 * C7 - d2 * C1 - d3 * C5;
+  output[5] = d0 * C5 - d1 * C1 + d2 * C7 + d3 * C3;
+  output[7] = d0 * C7 - d1 * C5 + d2 * C3 - d3 * C1;
+}
+
+/* The transpose of DSPDCT8ExecuteII, with input[0] multiplied by `scale`. */
+static void DSPDCT8ExecuteIII(const Float32* input,
+                              Float32* output,
+                              Float32 scale) {
+  Float32 x0 = input[0] * scale;
+  Float32 x1 = input[1];
+  Float32 x2 = input[2];
+  Float32 x3 = input[3];
+  Float32 x4 = input[4] * C4;
+  Float32 x5 = input[5];
+  Float32 x6 = input[6];
+  Float32 x7 = input[7];
+
+  /* even half: DCT-III(4) */
+  Float32 a = x0 + x4;
+  Float32 b = x0 - x4;
+  Float32 c = x2 * C2 + x6 * C6;
+  Float32 e = x2 * C6 - x6 * C2;
+  Float32 s0 = a + c;
+  Float32 s1 = b + e;
+  Float32 s2 = b - e;
+  Float32 s3 = a - c;
+
+  /* odd half: DCT-IV(4) */
+  Float32 d0 = x1 * C1 + x3 * C3 + x5 * C5 + x7 * C7;
+  Float32 d1 = x1 * C3 - x3 * C7 - x5 * C1 - x7 * C5;
+  Float32 d2 = x1 * C5 - x3 * C1 + x5 * C7 + x7 * C3;
+  Float32 d3 = x1 * C7 - x3 * C5 + x5 * C3 - x7 * C1;
+
+  output[0] = s0 + d0;
+  output[1] = s1 + d1;
+  output[2] = s2 + d2;
+  output[3] = s3 + d3;
+  output[4] = s3 - d3;
+  output[5] = s2 - d2;
+  output[6] = s1 - d1;
+  output[7] = s0 - d0;
+}
+
+static void DSPDCT8ExecuteIV(const Float32 kernel[static 64],
+                             const Float32* input,
+                             Float32* output) {
+  Float32 x[8];
+
+  memcpy(x, input, sizeof(x));
+  for (Int32 k = 0; k < 8; k += 1) {
+    const Float32* row = kernel + k * 8;
+    output[k] = x[0] * row[0] + x[1] * row[1] + x[2] * row[2] +
+                x[3] * row[3] + x[4] * row[4] + x[5] * row[5] +
+                x[6] * row[6] + x[7] * row[7];
+  }
+}
+
+/* MARK: - FFT */
+/* In-place radix-2 FFT of `count` complex values in bit-reversed order */
+static void DSPDCTSetupFFT(const struct DSPDCTSetup* setup,
+                           Float32* values,
+                           Int32 count) {
+  /* size 2: the twiddle factor is 1 */
+  for (Int32 i = 0; i < count * 2; i += 4) {
+    Float32 re = values[i + 2];
+    Float32 im = values[i + 3];
+    values[i + 2] = values[i] - re;
+    values[i + 3] = values[i + 1] - im;
+    values[i] += re;
+    values[i + 1] += im;
+  }
+
+  for (Int32 size = 4; size <= count; size *= 2) {
+    Int32 half = size / 2;
+    Int32 stride = setup->twiddleCount / size;
+
+    for (Int32 start = 0; start < count; start += size) {
+      Float32* a = values + start * 2;
+      Float32* b = a + half * 2;
+
+      for (Int32 j = 0; j < half; j += 1) {
+        Float32 wr = setup->twiddles[j * stride * 2];
+        Float32 wi = setup->twiddles[j * stride * 2 + 1];
+        Float32 re = b[j * 2] * wr - b[j * 2 + 1] * wi;
+        Float32 im = b[j * 2] * wi + b[j * 2 + 1] * wr;
+
+        b[j * 2] = a[j * 2] - re;
+        b[j * 2 + 1] = a[j * 2 + 1] - im;
+        a[j * 2] += re;
+        a[j * 2 + 1] += im;
+      }
+    }
+  }
+}
+
+/* MARK: - Transforms */
+/*
+ * With M = N/2 and z[n] = x[2n] + i * x[N-1-2n]:
+ *
+ *   Z = FFT(z[n] * e^(-i pi (4n+1) / 4N))
+ *   X[2k] - i * X[N-1-2k] = Z[k] * e^(-i pi k / N)
+ */
+static void DSPDCTSetupExecuteIV(const struct DSPDCTSetup* setup,
+                                 const Float32* input,
+                                 Float32* output,
+                                 Int32 count,
+                                 Float32* work) {
+  if (count == 8) {
+    DSPDCT8ExecuteIV(setup->kernel, input, output);
+    return;
+  }
+
+  Int32 half = count / 2;
+  Int32 level = __builtin_ctz(count);
+  const Float32* pre = setup->rotations[level];
+  const Float32* post = pre + count;
+  const Int32* reversal = setup->reversals[level];
+
+  /* 1. Pre-rotation, stored in bit-reversed order */
+  for (Int32 n = 0; n < half; n += 1) {
+    Float32 re = input[n * 2];
+    Float32 im = input[count - 1 - n * 2];
+    Float32 c = pre[n * 2];
+    Float32 s = pre[n * 2 + 1];
+    Int32 j = reversal[n];
+
+    work[j * 2] = re * c - im * s;
+    work[j * 2 + 1] = re * s + im * c;
+  }
+
+  /* 2. FFT */
+  DSPDCTSetupFFT(setup, work, half);
+
+  /* 3. Post-rotation */
+  for (Int32 k = 0; k < half; k += 1) {
+    Float32 re = work[k * 2];
+    Float32 im = work[k * 2 + 1];
+    Float32 c = post[k * 2];
+    Float32 s = post[k * 2 + 1];
+
+    output[k * 2] = re * c - im * s;
+    output[count - 1 - k * 2] = -(re * s + im * c);
+  }
+}
+
+static void DSPDCTSetupExecuteII(const struct DSPDCTSetup* setup,
+                                 const Float32* input,
+                                 Float32* output,
+                                 Int32 count,
+                                 Float32* work) {
+  if (count == 8) {
+    DSPDCT8ExecuteII(input, output);
+    return;
+  }
+  if (count == 32) {
+    DSPDCT32Execute(input, output);
+    return;
+  }
+
+  Int32 half = count / 2;
+  Float32* even = work;
+  Float32* odd = work + half;
+
+  for (Int32 n = 0; n < half; n += 1) {
+    even[n] = input[n] + input[count - 1 - n];
+    odd[n] = input[n] - input[count - 1 - n];
+  }
+
+  DSPDCTSetupExecuteII(setup, even, even, half, work + count);
+  DSPDCTSetupExecuteIV(setup, odd, odd, half, work + count);
+
+  for (Int32 k = 0; k < half; k += 1) {
+    output[k * 2] = even[k];
+    output[k * 2 + 1] = odd[k];
+  }
+}
+
+/* The transpose of DSPDCTSetupExecuteII, with input[0] scaled by `scale` */
+static void DSPDCTSetupExecuteIII(const struct DSPDCTSetup* setup,
+                                  const Float32* input,
+                                  Float32* output,
+                                  Int32 count,
+                                  Float32 scale,
+                                  Float32* work) {
+  if (count == 8) {
+    DSPDCT8ExecuteIII(input, output, scale);
+    return;
+  }
+
+  Int32 half = count / 2;
+  Float32* even = work;
+  Float32* odd = work + half;
+
+  for (Int32 k = 0; k < half; k += 1) {
+    even[k] = input[k * 2];
+    odd[k] = input[k * 2 + 1];
+  }
+  even[0] *= scale;
+
+  DSPDCTSetupExecuteIII(setup, even, even, half, 1, work + count);
+  DSPDCTSetupExecuteIV(setup, odd, odd, half, work + count);
+
+  for (Int32 n = 0; n < half; n += 1) {
+    output[n] = even[n] + odd[n];
+    output[count - 1 - n] = even[n] - odd[n];
+  }
+}
+
+/* MARK: - Tables */
+/*
+ * The tables of a setup depend only on its largest DCT-IV, and are a part of
+ * those of the largest setup: the same rotations and bit reversals for each
+ * size, and every `s`-th twiddle factor.  `DSPDCTSetupInitialize()` fills
+ * `TABLES` once, and later setups copy their tables from it.
+ */
+#define DSPDCTTablesEmpty 0
+#define DSPDCTTablesFilling 1
+#define DSPDCTTablesReady 2
+
+static Float32 TWIDDLES[DSPDCTMaximumCount / 2];
+static Float32 ROTATIONS[DSPDCTMaximumCount * 4];
+static Int32 REVERSALS[DSPDCTMaximumCount];
+static struct DSPDCTSetup TABLES;
+static _Atomic Int32 TABLES_STATE = DSPDCTTablesEmpty;
+
+/* Computes the tables of a setup whose largest DCT-IV has `largest` points. */
+static void DSPDCTSetupFill(struct DSPDCTSetup* setup, Int32 largest) {
+  Int32 twiddleCount = setup->twiddleCount;
+
+  for (Int32 j = 0; j < twiddleCount / 2; j += 1) {
+    double angle = -2 * M_PI * j / twiddleCount;
+    setup->twiddles[j * 2] = (Float32)cos(angle);
+    setup->twiddles[j * 2 + 1] = (Float32)sin(angle);
+  }
+
+  for (Int32 size = 16; size <= largest; size *= 2) {
+    Int32 level = __builtin_ctz(size);
+    Int32 half = size / 2;
+    Float32* pre = setup->rotations[level];
+    Float32* post = pre + size;
+
+    for (Int32 n = 0; n < half; n += 1) {
+      double angle = -M_PI * (4 * n + 1) / (4.0 * size);
+      pre[n * 2] = (Float32)cos(angle);
+      pre[n * 2 + 1] = (Float32)sin(angle);
+
+      angle = -M_PI * n / size;
+      post[n * 2] = (Float32)cos(angle);
+      post[n * 2 + 1] = (Float32)sin(angle);
+
+      Int32 reversed = 0;
+      for (Int32 bit = 1; bit < half; bit *= 2) {
+        reversed = reversed * 2 + ((n & bit) != 0);
+      }
+      setup->reversals[level][n] = reversed;
+    }
+  }
+
+  for (Int32 k = 0; k < 8; k += 1) {
+    for (Int32 n = 0; n < 8; n += 1) {
+      setup->kernel[k * 8 + n] = (Float32)cos(M_PI * (k + 0.5) * (n + 0.5) / 8);
+    }
+  }
+}
+
+/* Copies the tables of a setup from `TABLES`. */
+static void DSPDCTSetupCopy(struct DSPDCTSetup* setup, Int32 largest) {
+  Int32 stride = TABLES.twiddleCount / setup->twiddleCount;
+
+  for (Int32 j = 0; j < setup->twiddleCount / 2; j += 1) {
+    setup->twiddles[j * 2] = TABLES.twiddles[j * stride * 2];
+    setup->twiddles[j * 2 + 1] = TABLES.twiddles[j * stride * 2 + 1];
+  }
+
+  for (Int32 size = 16; size <= largest; size *= 2) {
+    Int32 level = __builtin_ctz(size);
+    memcpy(
+      setup->rotations[level],
+      TABLES.rotations[level],
+      size * 2 * sizeof(Float32)
+    );
+    memcpy(
+      setup->reversals[level],
+      TABLES.reversals[level],
+      size / 2 * sizeof(Int32)
+    );
+  }
+
+  memcpy(setup->kernel, TABLES.kernel, sizeof(setup->kernel));
+}
+
+void DSPDCTSetupInitialize(void) {
+  Int32 state = DSPDCTTablesEmpty;
+
+  if (
+    !atomic_compare_exchange_strong(
+      &TABLES_STATE,
+      &state,
+      DSPDCTTablesFilling
+    )
+  ) {
+    return;
+  }
+
+  /* The largest setup, a DCT-IV of the maximum size, without scratch */
+  TABLES.count = DSPDCTMaximumCount;
+  TABLES.type = DSPDCTTypeIV;
+  TABLES.twiddleCount = DSPDCTMaximumCount / 2;
+  TABLES.twiddles = TWIDDLES;
+  Float32* rotations = ROTATIONS;
+  Int32* reversals = REVERSALS;
+  for (Int32 size = 16; size <= DSPDCTMaximumCount; size *= 2) {
+    TABLES.rotations[__builtin_ctz(size)] = rotations;
+    TABLES.reversals[__builtin_ctz(size)] = reversals;
+    rotations += size * 2;
+    reversals += size / 2;
+  }
+  DSPDCTSetupFill(&TABLES, DSPDCTMaximumCount);
+
+  atomic_store(&TABLES_STATE, DSPDCTTablesReady);
+}
+
+/* MARK: - Setup */
+struct DSPDCTSetup* DSPDCTCreateSetup(Int32 count, enum DSPDCTType type) {
+  if (count < DSPDCTMinimumCount || count > DSPDCTMaximumCount ||
+      (count & (count - 1)) != 0) {
+    return NULL;
+  }
+  if (type != DSPDCTTypeII && type != DSPDCTTypeIII && type != DSPDCTTypeIV) {
+    return NULL;
+  }
+
+  /* 1. Measure: the largest DCT-IV is N for type IV and N/2 otherwise. */
+  Int32 largest = type == DSPDCTTypeIV ? count : count / 2;
+  Int32 twiddleCount = largest / 2;
+  UInt64 floats = twiddleCount + count * 2;
+  UInt64 integers = 0;
+  for (Int32 size = 16; size <= largest; size *= 2) {
+    floats += size * 2;
+    integers += size / 2;
+  }
+
+  struct DSPDCTSetup* setup = malloc(
+    sizeof(*setup) + floats * sizeof(Float32) + integers * sizeof(Int32)
+  );
+  if (setup == NULL) {
+    return NULL;
+  }
+  memset(setup, 0, sizeof(*setup));
+  setup->count = count;
+  setup->type = type;
+  setup->twiddleCount = twiddleCount;
+
+  /* 2. Carve the tables out of the allocation */
+  Float32* next = (Float32*)(setup + 1);
+  setup->buffer = next;
+  next += count * 2;
+  setup->twiddles = next;
+  next += twiddleCount;
+  for (Int32 size = 16; size <= largest; size *= 2) {
+    setup->rotations[__builtin_ctz(size)] = next;
+    next += size * 2;
+  }
+  Int32* reversal = (Int32*)next;
+  for (Int32 size = 16; size <= largest; size *= 2) {
+    setup->reversals[__builtin_ctz(size)] = reversal;
+    reversal += size / 2;
+  }
+
+  /* 3. Fill them, from the shared tables if they are ready */
+  if (atomic_load(&TABLES_STATE) == DSPDCTTablesReady) {
+    DSPDCTSetupCopy(setup, largest);
+  } else {
+    DSPDCTSetupFill(setup, largest);
+  }
+
+  return setup;
+}
+
+void DSPDCTExecute(struct DSPDCTSetup* setup,
+                   const Float32* input,
+                   Float32* output) {
+  switch (setup->type) {
+  case DSPDCTTypeII:
+    DSPDCTSetupExecuteII(setup, input, output, setup->count, setup->buffer);
+    break;
+  case DSPDCTTypeIII:
+    DSPDCTSetupExecuteIII(
+      setup,
+      input,
+      output,
+      setup->count,
+      0.5,
+      setup->buffer
+    );
+    break;
+  case DSPDCTTypeIV:
+    DSPDCTSetupExecuteIV(setup, input, output, setup->count, setup->buffer);
+    break;
+  }
+}
+
+void DSPDCTDestroySetup(struct DSPDCTSetup* setup) {
+  free(setup);
+}
@@ -0,0 +1,106 @@
+//
+//  DSPDCTSetup.h
+//  core-cloud-wasm
+//
+//  Created by Fang Ling on 2026/10/17.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#ifndef DSPDCTSetup_h
+#define DSPDCTSetup_h
+
+#include "Base.h"
+
+/**
+ * DCT types supported by ``DSPDCTCreateSetup()``.
+ *
+ * The transforms are unscaled and use the same definitions as vDSP:
+ *
+ *     // `h` is the input array that contains real numbers.
+ *     // `H` is the output array that contains real numbers.
+ *     // `N` is the number of elements.
+ *
+ *     Type II, for 0 <= k < N
+ *       H[k] = sum(h[j] * cos(k * (j+1/2) * pi / N), 0 <= j < N)
+ *
+ *     Type III, for 0 <= k < N
+ *       H[k] = h[0] / 2 + sum(h[j] * cos((k+1/2) * j * pi / N), 1 <= j < N)
+ *
+ *     Type IV, for 0 <= k < N
+ *       H[k] = sum(h[j] * cos((k+1/2) * (j+1/2) * pi / N), 0 <= j < N)
+ *
+ * Type III inverts type II up to a factor of N / 2, and type IV inverts
+ * itself up to the same factor.
+ */
+enum DSPDCTType {
+  DSPDCTTypeII,
+  DSPDCTTypeIII,
+  DSPDCTTypeIV
+};
+
+/**
+ * The smallest number of elements a DCT setup supports.
+ */
+#define DSPDCTMinimumCount 8
+
+/**
+ * The largest number of elements a DCT setup supports.
+ */
+#define DSPDCTMaximumCount 4096
+
+/**
+ * A precomputed plan for single-precision real discrete cosine transforms of
+ * one size and type.
+ *
+ * A setup owns its twiddle factors and scratch memory. Create one setup per
+ * size and type, reuse it for every vector, and do not use the same setup
+ * from more than one thread at a time.
+ */
+struct DSPDCTSetup;
+
+/**
+ * Creates a setup for a discrete cosine transform.
+ *
+ * - Parameters:
+ *   - count: The number of elements to transform, a power of two between
+ *            ``DSPDCTMinimumCount`` and ``DSPDCTMaximumCount``.
+ *   - type: The type of the transform.
+ *
+ * - Returns: A new DCT setup, or `NULL` if `count` or `type` is not supported
+ *   or the memory could not be allocated. Release it with
+ *   ``DSPDCTDestroySetup()``.
+ */
+struct DSPDCTSetup* DSPDCTCreateSetup(Int32 count, enum DSPDCTType type);
+
+/**
+ * Computes an out-of-place single-precision real discrete cosine transform.
+ *
+ * - Parameters:
+ *   - setup: A DCT setup.
+ *   - input: Single-precision input vector that contains `count` elements.
+ *   - output: Single-precision output vector that contains `count` elements.
+ *             It may be the same vector as `input`.
+ */
+void DSPDCTExecute(struct DSPDCTSetup* setup,
+                   const Float32* input,
+                   Float32* output);
+
+/**
+ * Destroys a DCT setup.
+ *
+ * - Parameter setup: A DCT setup, or `NULL`.
+ */
+void DSPDCTDestroySetup(struct DSPDCTSetup* setup);
+
+#endif /* DSPDCTSetup_h */
@@ -0,0 +1,332 @@
+//
+//  DSPIDCT.c
+//  core-cloud-wasm
+//
+//  Created by Fang Ling on 2026/10/17.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#include "DSPIDCT.h"
+#include "DSPMatrix.h"
+#include "DSPVector.h"
+
+#include <math.h>
+
+/*
+ * The fixed-point kernels keep `DSPIDCTConstantBits` fraction bits in their
+ * constants and `DSPIDCTPassBits` extra bits between the two passes, as in
+ * libjpeg.  Each one-dimensional pass scales by sqrt(8), so the output is
+ * also divided by 8.
+ */
+#define DSPIDCTConstantBits 13
+#define DSPIDCTPassBits 2
+
+#define FIX(x) ((Int32)((x) * (1 << DSPIDCTConstantBits) + 0.5))
+#define DESCALE(x, n) (((x) + (1 << ((n) - 1))) >> (n))
+
+#define FIX_0_298631336 FIX(0.298631336)
+#define FIX_0_390180644 FIX(0.390180644)
+#define FIX_0_541196100 FIX(0.541196100)
+#define FIX_0_765366865 FIX(0.765366865)
+#define FIX_0_899976223 FIX(0.899976223)
+#define FIX_1_175875602 FIX(1.175875602)
+#define FIX_1_501321110 FIX(1.501321110)
+#define FIX_1_847759065 FIX(1.847759065)
+#define FIX_1_961570560 FIX(1.961570560)
+#define FIX_2_053119869 FIX(2.053119869)
+#define FIX_2_562915447 FIX(2.562915447)
+#define FIX_3_072711026 FIX(3.072711026)
+
+/* Level-shifts a sample and clamps it to 8 bits. */
+static inline UInt8 DSPIDCTClamp(Int32 x) {
+  x += 128;
+  return x < 0 ? 0 : (x > 255 ? 255 : (UInt8)x);
+}
+
+/* MARK: - 8x8 Integer */
+/* One-dimensional 8-point IDCT of `w` in place, descaled by `shift` bits. */
+static inline void DSPIDCTButterfly8(Int32 w[8], Int32 shift) {
+  /* 1. Even part: a rotation by 3pi/8 */
+  Int32 z1 = (w[2] + w[6]) * FIX_0_541196100;
+  Int32 t2 = z1 - w[6] * FIX_1_847759065;
+  Int32 t3 = z1 + w[2] * FIX_0_765366865;
+  Int32 t0 = (w[0] + w[4]) * (1 << DSPIDCTConstantBits);
+  Int32 t1 = (w[0] - w[4]) * (1 << DSPIDCTConstantBits);
+
+  Int32 t10 = t0 + t3;
+  Int32 t13 = t0 - t3;
+  Int32 t11 = t1 + t2;
+  Int32 t12 = t1 - t2;
+
+  /* 2. Odd part */
+  Int32 o0 = w[7];
+  Int32 o1 = w[5];
+  Int32 o2 = w[3];
+  Int32 o3 = w[1];
+  Int32 s1 = o0 + o3;
+  Int32 s2 = o1 + o2;
+  Int32 s3 = o0 + o2;
+  Int32 s4 = o1 + o3;
+  Int32 s5 = (s3 + s4) * FIX_1_175875602;
+
+  o0 *= FIX_0_298631336;
+  o1 *= FIX_2_053119869;
+  o2 *= FIX_3_072711026;
+  o3 *= FIX_1_501321110;
+  s1 *= -FIX_0_899976223;
+  s2 *= -FIX_2_562915447;
+  s3 = s3 * -FIX_1_961570560 + s5;
+  s4 = s4 * -FIX_0_390180644 + s5;
+
+  o0 += s1 + s3;
+  o1 += s2 + s4;
+  o2 += s2 + s3;
+  o3 += s1 + s4;
+
+  /* 3. Final butterflies */
+  w[0] = DESCALE(t10 + o3, shift);
+  w[7] = DESCALE(t10 - o3, shift);
+  w[1] = DESCALE(t11 + o2, shift);
+  w[6] = DESCALE(t11 - o2, shift);
+  w[2] = DESCALE(t12 + o1, shift);
+  w[5] = DESCALE(t12 - o1, shift);
+  w[3] = DESCALE(t13 + o0, shift);
+  w[4] = DESCALE(t13 - o0, shift);
+}
+
+void DSPIDCT8x8(const Int16 coefficients[static 64],
+                const UInt16 quantization[static 64],
+                UInt8* output,
+                Int32 outputStride) {
+  Int32 workspace[64];
+
+  /* 1. Columns, dequantized, with `DSPIDCTPassBits` extra bits */
+  for (Int32 x = 0; x < 8; x += 1) {
+    Int32 w[8];
+    Bool flat = true;
+    for (Int32 y = 0; y < 8; y += 1) {
+      w[y] = coefficients[y * 8 + x] * quantization[y * 8 + x];
+      flat = flat && (y == 0 || w[y] == 0);
+    }
+
+    if (flat) {
+      /* Only the DC term: the column is constant */
+      Int32 dc = w[0] * (1 << DSPIDCTPassBits);
+      for (Int32 y = 0; y < 8; y += 1) {
+        workspace[y * 8 + x] = dc;
+      }
+      continue;
+    }
+
+    DSPIDCTButterfly8(w, DSPIDCTConstantBits - DSPIDCTPassBits);
+    for (Int32 y = 0; y < 8; y += 1) {
+      workspace[y * 8 + x] = w[y];
+    }
+  }
+
+  /* 2. Rows, descaled by the extra bits and by 8 */
+  for (Int32 y = 0; y < 8; y += 1) {
+    Int32* w = workspace + y * 8;
+    UInt8* row = output + y * outputStride;
+
+    if ((w[1] | w[2] | w[3] | w[4] | w[5] | w[6] | w[7]) == 0) {
+      UInt8 dc = DSPIDCTClamp(DESCALE(w[0], DSPIDCTPassBits + 3));
+      memset(row, dc, 8);
+      continue;
+    }
+
+    DSPIDCTButterfly8(w, DSPIDCTConstantBits + DSPIDCTPassBits + 3);
+    for (Int32 x = 0; x < 8; x += 1) {
+      row[x] = DSPIDCTClamp(w[x]);
+    }
+  }
+}
+
+/* MARK: - 8x8 Float */
+void DSPIDCTPrepareFloat(const UInt16 quantization[static 64],
+                         Float32 multipliers[static 64]) {
+  /* sqrt(2) cos(k pi / 16), and 1 for k = 0 */
+  static const double scales[8] = {
+    1.0, 1.387039845, 1.306562965, 1.175875602,
+    1.0, 0.785694958, 0.541196100, 0.275899379
+  };
+
+  for (Int32 v = 0; v < 8; v += 1) {
+    for (Int32 u = 0; u < 8; u += 1) {
+      double q = quantization[v * 8 + u];
+      multipliers[v * 8 + u] = (Float32)(q * scales[v] * scales[u] / 8);
+    }
+  }
+}
+
+/* One AAN pass over the columns of `w`, `VLANES` columns at a time. */
+static inline void DSPIDCTFloatPass(Float32 w[static 64]) {
+  const Vector sqrt2 = VSPLAT(1.414213562f);
+  const Vector c1 = VSPLAT(1.847759065f);
+  const Vector c2 = VSPLAT(1.082392200f);
+  const Vector c3 = VSPLAT(2.613125930f);
+
+  for (Int32 x = 0; x < 8; x += VLANES) {
+    /* 1. Even part */
+    Vector t0 = VLOAD(w + 0 * 8 + x);
+    Vector t1 = VLOAD(w + 2 * 8 + x);
+    Vector t2 = VLOAD(w + 4 * 8 + x);
+    Vector t3 = VLOAD(w + 6 * 8 + x);
+
+    Vector t10 = VADD(t0, t2);
+    Vector t11 = VSUB(t0, t2);
+    Vector t13 = VADD(t1, t3);
+    Vector t12 = VSUB(VMUL(VSUB(t1, t3), sqrt2), t13);
+
+    t0 = VADD(t10, t13);
+    t3 = VSUB(t10, t13);
+    t1 = VADD(t11, t12);
+    t2 = VSUB(t11, t12);
+
+    /* 2. Odd part */
+    Vector t4 = VLOAD(w + 1 * 8 + x);
+    Vector t5 = VLOAD(w + 3 * 8 + x);
+    Vector t6 = VLOAD(w + 5 * 8 + x);
+    Vector t7 = VLOAD(w + 7 * 8 + x);
+
+    Vector z13 = VADD(t6, t5);
+    Vector z10 = VSUB(t6, t5);
+    Vector z11 = VADD(t4, t7);
+    Vector z12 = VSUB(t4, t7);
+
+    t7 = VADD(z11, z13);
+    t11 = VMUL(VSUB(z11, z13), sqrt2);
+    Vector z5 = VMUL(VADD(z10, z12), c1);
+    t10 = VSUB(z5, VMUL(z12, c2));
+    t12 = VSUB(z5, VMUL(z10, c3));
+
+    t6 = VSUB(t12, t7);
+    t5 = VSUB(t11, t6);
+    t4 = VSUB(t10, t5);
+
+    /* 3. Final butterflies */
+    VSTORE(w + 0 * 8 + x, VADD(t0, t7));
+    VSTORE(w + 7 * 8 + x, VSUB(t0, t7));
+    VSTORE(w + 1 * 8 + x, VADD(t1, t6));
+    VSTORE(w + 6 * 8 + x, VSUB(t1, t6));
+    VSTORE(w + 2 * 8 + x, VADD(t2, t5));
+    VSTORE(w + 5 * 8 + x, VSUB(t2, t5));
+    VSTORE(w + 3 * 8 + x, VADD(t3, t4));
+    VSTORE(w + 4 * 8 + x, VSUB(t3, t4));
+  }
+}
+
+void DSPIDCT8x8Float(const Int16 coefficients[static 64],
+                     const Float32 multipliers[static 64],
+                     UInt8* output,
+                     Int32 outputStride) {
+  Float32 workspace[64];
+
+  for (Int32 i = 0; i < 64; i += 1) {
+    workspace[i] = coefficients[i] * multipliers[i];
+  }
+
+  /* Columns, then rows as the columns of the transpose */
+  DSPIDCTFloatPass(workspace);
+  DSPMatrixTransposeInPlace(workspace, 8, 8);
+  DSPIDCTFloatPass(workspace);
+
+  for (Int32 y = 0; y < 8; y += 1) {
+    UInt8* row = output + y * outputStride;
+    for (Int32 x = 0; x < 8; x += 1) {
+      row[x] = DSPIDCTClamp((Int32)lrintf(workspace[x * 8 + y]));
+    }
+  }
+}
+
+/* MARK: - Reduced Sizes */
+void DSPIDCT4x4(const Int16 coefficients[static 64],
+                const UInt16 quantization[static 64],
+                UInt8* output,
+                Int32 outputStride) {
+  Int32 workspace[16];
+
+  /*
+   * A 4-point IDCT scaled by sqrt(8) like the 8-point one:
+   *
+   *   even: (F0 + F2) and (F0 - F2), shifted
+   *   odd:  F1 sqrt(2) cos(pi/8) + F3 sqrt(2) cos(3pi/8), and its rotation
+   */
+
+  /* 1. Columns */
+  for (Int32 x = 0; x < 4; x += 1) {
+    Int32 f0 = coefficients[0 * 8 + x] * quantization[0 * 8 + x];
+    Int32 f1 = coefficients[1 * 8 + x] * quantization[1 * 8 + x];
+    Int32 f2 = coefficients[2 * 8 + x] * quantization[2 * 8 + x];
+    Int32 f3 = coefficients[3 * 8 + x] * quantization[3 * 8 + x];
+
+    Int32 t0 = (f0 + f2) * (1 << DSPIDCTPassBits);
+    Int32 t2 = (f0 - f2) * (1 << DSPIDCTPassBits);
+
+    Int32 z1 = (f1 + f3) * FIX_0_541196100;
+    Int32 shift = DSPIDCTConstantBits - DSPIDCTPassBits;
+    Int32 o0 = DESCALE(z1 + f1 * FIX_0_765366865, shift);
+    Int32 o2 = DESCALE(z1 - f3 * FIX_1_847759065, shift);
+
+    workspace[0 * 4 + x] = t0 + o0;
+    workspace[3 * 4 + x] = t0 - o0;
+    workspace[1 * 4 + x] = t2 + o2;
+    workspace[2 * 4 + x] = t2 - o2;
+  }
+
+  /* 2. Rows */
+  for (Int32 y = 0; y < 4; y += 1) {
+    const Int32* w = workspace + y * 4;
+    UInt8* row = output + y * outputStride;
+
+    Int32 t0 = (w[0] + w[2]) * (1 << DSPIDCTConstantBits);
+    Int32 t2 = (w[0] - w[2]) * (1 << DSPIDCTConstantBits);
+
+    Int32 z1 = (w[1] + w[3]) * FIX_0_541196100;
+    Int32 o0 = z1 + w[1] * FIX_0_765366865;
+    Int32 o2 = z1 - w[3] * FIX_1_847759065;
+
+    Int32 shift = DSPIDCTConstantBits + DSPIDCTPassBits + 3;
+    row[0] = DSPIDCTClamp(DESCALE(t0 + o0, shift));
+    row[3] = DSPIDCTClamp(DESCALE(t0 - o0, shift));
+    row[1] = DSPIDCTClamp(DESCALE(t2 + o2, shift));
+    row[2] = DSPIDCTClamp(DESCALE(t2 - o2, shift));
+  }
+}
+
+void DSPIDCT2x2(const Int16 coefficients[static 64],
+                const UInt16 quantization[static 64],
+                UInt8* output,
+                Int32 outputStride) {
+  /* The 2-point IDCT scaled by sqrt(8) is a plain butterfly */
+  Int32 f00 = coefficients[0] * quantization[0];
+  Int32 f01 = coefficients[1] * quantization[1];
+  Int32 f10 = coefficients[8] * quantization[8];
+  Int32 f11 = coefficients[9] * quantization[9];
+
+  Int32 t0 = f00 + f10;
+  Int32 t1 = f00 - f10;
+  Int32 t2 = f01 + f11;
+  Int32 t3 = f01 - f11;
+
+  output[0] = DSPIDCTClamp(DESCALE(t0 + t2, 3));
+  output[1] = DSPIDCTClamp(DESCALE(t0 - t2, 3));
+  output[outputStride] = DSPIDCTClamp(DESCALE(t1 + t3, 3));
+  output[outputStride + 1] = DSPIDCTClamp(DESCALE(t1 - t3, 3));
+}
+
+UInt8 DSPIDCT1x1(const Int16 coefficients[static 1],
+                 const UInt16 quantization[static 1]) {
+  return DSPIDCTClamp(DESCALE(coefficients[0] * quantization[0], 3));
+}
@@ -0,0 +1,141 @@
+//
+//  DSPIDCT.h
+//  core-cloud-wasm
+//
+//  Created by Fang Ling on 2026/10/17.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#ifndef DSPIDCT_h
+#define DSPIDCT_h
+
+#include "Base.h"
+
+/*
+ * The inverse DCTs of baseline JPEG decoding, with the same definitions and
+ * rounding as libjpeg:
+ *
+ *     // `F` is the block of dequantized coefficients, `F[v][u] * Q[v][u]`.
+ *     // `f` is the block of 8-bit samples.
+ *     // C(0) = 1 / sqrt(2), and C(k) = 1 otherwise.
+ *
+ *     For 0 <= y < 8, 0 <= x < 8
+ *       f[y][x] = 128 + sum(C(v) * C(u) / 4 * F[v][u]
+ *                             * cos(v * (2y+1) * pi / 16)
+ *                             * cos(u * (2x+1) * pi / 16), 0 <= v, u < 8)
+ *
+ * and every sample is rounded and clamped to [0, 255].
+ *
+ * The reduced-size kernels evaluate the same sum with only the lowest
+ * frequencies, at the centers of blocks of 2, 4 or 8 samples, so that an image
+ * decodes straight to 1/2, 1/4 or 1/8 of its size. Coefficients and
+ * quantization tables are in natural (row-major) order, not zigzag order.
+ */
+
+/**
+ * Computes an 8x8 inverse DCT in 32-bit fixed point.
+ *
+ * This is the accurate integer algorithm of libjpeg (Loeffler, Ligtenberg and
+ * Moschytz, 12 multiplications per pass), which meets IEEE 1180.
+ *
+ * - Parameters:
+ *   - coefficients: The 8x8 quantized coefficients of a block.
+ *   - quantization: The 8x8 quantization table of the component.
+ *   - output: The top-left sample of the 8x8 output block.
+ *   - outputStride: The distance in bytes between two rows of `output`.
+ */
+void DSPIDCT8x8(const Int16 coefficients[static 64],
+                const UInt16 quantization[static 64],
+                UInt8* output,
+                Int32 outputStride);
+
+/**
+ * Prepares a quantization table for ``DSPIDCT8x8Float()``.
+ *
+ * The multipliers fold the scale factors of the AAN algorithm and the final
+ * division by 8 into the dequantization. Prepare them once per table.
+ *
+ * - Parameters:
+ *   - quantization: The 8x8 quantization table of the component.
+ *   - multipliers: A buffer to store the 8x8 multipliers.
+ */
+void DSPIDCTPrepareFloat(const UInt16 quantization[static 64],
+                         Float32 multipliers[static 64]);
+
+/**
+ * Computes an 8x8 inverse DCT in single precision.
+ *
+ * This is the floating-point algorithm of libjpeg (Arai, Agui and Nakajima, 5
+ * multiplications per pass), with both passes running over several columns
+ * at once in vector lanes.
+ *
+ * - Parameters:
+ *   - coefficients: The 8x8 quantized coefficients of a block.
+ *   - multipliers: The multipliers of ``DSPIDCTPrepareFloat()``.
+ *   - output: The top-left sample of the 8x8 output block.
+ *   - outputStride: The distance in bytes between two rows of `output`.
+ */
+void DSPIDCT8x8Float(const Int16 coefficients[static 64],
+                     const Float32 multipliers[static 64],
+                     UInt8* output,
+                     Int32 outputStride);
+
+/**
+ * Computes a 4x4 output block from the 4x4 lowest frequencies of an 8x8
+ * block of coefficients, in 32-bit fixed point.
+ *
+ * - Parameters:
+ *   - coefficients: The 8x8 quantized coefficients of a block.
+ *   - quantization: The 8x8 quantization table of the component.
+ *   - output: The top-left sample of the 4x4 output block.
+ *   - outputStride: The distance in bytes between two rows of `output`.
+ */
+void DSPIDCT4x4(const Int16 coefficients[static 64],
+                const UInt16 quantization[static 64],
+                UInt8* output,
+                Int32 outputStride);
+
+/**
+ * Computes a 2x2 output block from the 2x2 lowest frequencies of an 8x8
+ * block of coefficients. It needs no multiplication besides dequantization.
+ *
+ * - Parameters:
+ *   - coefficients: The 8x8 quantized coefficients of a block.
+ *   - quantization: The 8x8 quantization table of the component.
+ *   - output: The top-left sample of the 2x2 output block.
+ *   - outputStride: The distance in bytes between two rows of `output`.
+ */
+void DSPIDCT2x2(const Int16 coefficients[static 64],
+                const UInt16 quantization[static 64],
+                UInt8* output,
+                Int32 outputStride);
+
+/**
+ * Computes the average sample of a block from its DC coefficient.
+ *
+ * A decoder at 1/8 scale needs nothing else, and can skip the entropy-coded
+ * AC coefficients without storing them.
+ *
+ * - Parameters:
+ *   - coefficients: The 8x8 quantized coefficients of a block; only the first
+ *                   one is read.
+ *   - quantization: The 8x8 quantization table of the component; only the
+ *                   first entry is read.
+ *
+ * - Returns: The sample of the 1x1 output block.
+ */
+UInt8 DSPIDCT1x1(const Int16 coefficients[static 1],
+                 const UInt16 quantization[static 1]);
+
+#endif /* DSPIDCT_h */
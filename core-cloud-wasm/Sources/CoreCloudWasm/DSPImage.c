@@ -0,0 +1,396 @@
+//
+//  DSPImage.c
+//  core-cloud-wasm
+//
+//  Created by Fang Ling on 2026/10/17.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#include "DSPImage.h"
+
+#include <stdlib.h>
+
+/* 256 * BT.601 luma, at most 255 * 256 */
+#define LUMA(p) \
+  (77 * (UInt32)(p)[0] + 150 * (UInt32)(p)[1] + 29 * (UInt32)(p)[2])
+
+/* MARK: - Vector Backends */
+/*
+ * Each backend adds one row of luma to 32-bit column sums, four or more
+ * pixels at a time, and leaves the last few pixels to the scalar loops below.
+ * They return the number of pixels they accumulated.  Define `SIMD_SCALAR` to
+ * build the plain C reference instead.
+ */
+#if defined(__wasm_simd128__) && !defined(SIMD_SCALAR)
+#include <wasm_simd128.h>
+
+/* 16 bytes of RGBA pixels to 4 lumas */
+static inline v128_t DSPImageLumax4(v128_t pixels) {
+  const v128_t weights = wasm_i16x8_make(77, 150, 29, 0, 77, 150, 29, 0);
+  v128_t lo = wasm_i32x4_dot_i16x8(wasm_u16x8_extend_low_u8x16(pixels),
+                                   weights);
+  v128_t hi = wasm_i32x4_dot_i16x8(wasm_u16x8_extend_high_u8x16(pixels),
+                                   weights);
+  return wasm_i32x4_add(wasm_i32x4_shuffle(lo, hi, 0, 2, 4, 6),
+                        wasm_i32x4_shuffle(lo, hi, 1, 3, 5, 7));
+}
+
+static Int32 DSPImageAccumulateRGBAVector(const UInt8* row,
+                                          UInt32* sums,
+                                          Int32 count) {
+  Int32 x = 0;
+  for (; x + 4 <= count; x += 4) {
+    v128_t luma = DSPImageLumax4(wasm_v128_load(row + x * 4));
+    wasm_v128_store(sums + x, wasm_i32x4_add(wasm_v128_load(sums + x), luma));
+  }
+  return x;
+}
+
+static Int32 DSPImageAccumulateRGBVector(const UInt8* row,
+                                         UInt32* sums,
+                                         Int32 count) {
+  /* RGB to RGBA; the alpha byte has weight 0 */
+  const v128_t spread = wasm_i8x16_make(0, 1, 2, -1, 3, 4, 5, -1,
+                                        6, 7, 8, -1, 9, 10, 11, -1);
+  Int32 x = 0;
+  /* Each load reads 16 of the 12 bytes it needs */
+  for (; x + 6 <= count; x += 4) {
+    v128_t pixels = wasm_i8x16_swizzle(wasm_v128_load(row + x * 3), spread);
+    v128_t luma = DSPImageLumax4(pixels);
+    wasm_v128_store(sums + x, wasm_i32x4_add(wasm_v128_load(sums + x), luma));
+  }
+  return x;
+}
+
+static Int32 DSPImageAccumulateYVector(const UInt8* row,
+                                       UInt32* sums,
+                                       Int32 count) {
+  Int32 x = 0;
+  for (; x + 16 <= count; x += 16) {
+    v128_t y = wasm_v128_load(row + x);
+    v128_t lo = wasm_u16x8_extend_low_u8x16(y);
+    v128_t hi = wasm_u16x8_extend_high_u8x16(y);
+    v128_t y0 = wasm_u32x4_extend_low_u16x8(lo);
+    v128_t y1 = wasm_u32x4_extend_high_u16x8(lo);
+    v128_t y2 = wasm_u32x4_extend_low_u16x8(hi);
+    v128_t y3 = wasm_u32x4_extend_high_u16x8(hi);
+    wasm_v128_store(sums + x, wasm_i32x4_add(wasm_v128_load(sums + x), y0));
+    wasm_v128_store(sums + x + 4,
+                    wasm_i32x4_add(wasm_v128_load(sums + x + 4), y1));
+    wasm_v128_store(sums + x + 8,
+                    wasm_i32x4_add(wasm_v128_load(sums + x + 8), y2));
+    wasm_v128_store(sums + x + 12,
+                    wasm_i32x4_add(wasm_v128_load(sums + x + 12), y3));
+  }
+  return x;
+}
+#elif defined(__SSE2__) && !defined(SIMD_SCALAR)
+#include <emmintrin.h>
+#if defined(__SSSE3__)
+#include <tmmintrin.h>
+#endif
+
+/* 16 bytes of RGBA pixels to 4 lumas */
+static inline __m128i DSPImageLumax4(__m128i pixels) {
+  const __m128i weights = _mm_set_epi16(0, 29, 150, 77, 0, 29, 150, 77);
+  const __m128i zero = _mm_setzero_si128();
+  __m128 lo = _mm_castsi128_ps(
+    _mm_madd_epi16(_mm_unpacklo_epi8(pixels, zero), weights)
+  );
+  __m128 hi = _mm_castsi128_ps(
+    _mm_madd_epi16(_mm_unpackhi_epi8(pixels, zero), weights)
+  );
+  return _mm_add_epi32(
+    _mm_castps_si128(_mm_shuffle_ps(lo, hi, _MM_SHUFFLE(2, 0, 2, 0))),
+    _mm_castps_si128(_mm_shuffle_ps(lo, hi, _MM_SHUFFLE(3, 1, 3, 1)))
+  );
+}
+
+static Int32 DSPImageAccumulateRGBAVector(const UInt8* row,
+                                          UInt32* sums,
+                                          Int32 count) {
+  Int32 x = 0;
+  for (; x + 4 <= count; x += 4) {
+    __m128i luma = DSPImageLumax4(
+      _mm_loadu_si128((const __m128i*)(row + x * 4))
+    );
+    __m128i* sum = (__m128i*)(sums + x);
+    _mm_storeu_si128(sum, _mm_add_epi32(_mm_loadu_si128(sum), luma));
+  }
+  return x;
+}
+
+/* 12 bytes of RGB pixels to 16 bytes of RGBA; the alpha byte has weight 0 */
+static inline __m128i DSPImageSpreadRGB(__m128i pixels) {
+#if defined(__SSSE3__)
+  const __m128i spread = _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1,
+                                       6, 7, 8, -1, 9, 10, 11, -1);
+  return _mm_shuffle_epi8(pixels, spread);
+#else
+  /* Pixel i moves up by i bytes. */
+  const __m128i mask = _mm_setr_epi32(0x00FFFFFF, 0, 0, 0);
+  __m128i rgba = _mm_and_si128(pixels, mask);
+  rgba = _mm_or_si128(
+    rgba,
+    _mm_and_si128(_mm_slli_si128(pixels, 1), _mm_slli_si128(mask, 4))
+  );
+  rgba = _mm_or_si128(
+    rgba,
+    _mm_and_si128(_mm_slli_si128(pixels, 2), _mm_slli_si128(mask, 8))
+  );
+  return _mm_or_si128(
+    rgba,
+    _mm_and_si128(_mm_slli_si128(pixels, 3), _mm_slli_si128(mask, 12))
+  );
+#endif
+}
+
+static Int32 DSPImageAccumulateRGBVector(const UInt8* row,
+                                         UInt32* sums,
+                                         Int32 count) {
+  Int32 x = 0;
+  /* Each load reads 16 of the 12 bytes it needs */
+  for (; x + 6 <= count; x += 4) {
+    __m128i pixels = DSPImageSpreadRGB(
+      _mm_loadu_si128((const __m128i*)(row + x * 3))
+    );
+    __m128i luma = DSPImageLumax4(pixels);
+    __m128i* sum = (__m128i*)(sums + x);
+    _mm_storeu_si128(sum, _mm_add_epi32(_mm_loadu_si128(sum), luma));
+  }
+  return x;
+}
+
+static Int32 DSPImageAccumulateYVector(const UInt8* row,
+                                       UInt32* sums,
+                                       Int32 count) {
+  const __m128i zero = _mm_setzero_si128();
+  Int32 x = 0;
+  for (; x + 16 <= count; x += 16) {
+    __m128i y = _mm_loadu_si128((const __m128i*)(row + x));
+    __m128i lo = _mm_unpacklo_epi8(y, zero);
+    __m128i hi = _mm_unpackhi_epi8(y, zero);
+    __m128i values[4] = {
+      _mm_unpacklo_epi16(lo, zero),
+      _mm_unpackhi_epi16(lo, zero),
+      _mm_unpacklo_epi16(hi, zero),
+      _mm_unpackhi_epi16(hi, zero)
+    };
+    for (Int32 i = 0; i < 4; i += 1) {
+      __m128i* sum = (__m128i*)(sums + x + i * 4);
+      _mm_storeu_si128(sum, _mm_add_epi32(_mm_loadu_si128(sum), values[i]));
+    }
+  }
+  return x;
+}
+#elif defined(__ARM_NEON) && !defined(SIMD_SCALAR)
+#include <arm_neon.h>
+
+/* Adds 8 lumas to 8 column sums */
+static inline void DSPImageAddx8(UInt32* sums, uint16x8_t luma) {
+  vst1q_u32(sums, vaddw_u16(vld1q_u32(sums), vget_low_u16(luma)));
+  vst1q_u32(sums + 4, vaddw_u16(vld1q_u32(sums + 4), vget_high_u16(luma)));
+}
+
+/* 77R + 150G + 29B fits 16 bits. */
+static inline uint16x8_t DSPImageLumax8(uint8x8_t r,
+                                        uint8x8_t g,
+                                        uint8x8_t b) {
+  uint16x8_t luma = vmull_u8(r, vdup_n_u8(77));
+  luma = vmlal_u8(luma, g, vdup_n_u8(150));
+  return vmlal_u8(luma, b, vdup_n_u8(29));
+}
+
+static Int32 DSPImageAccumulateRGBAVector(const UInt8* row,
+                                          UInt32* sums,
+                                          Int32 count) {
+  Int32 x = 0;
+  for (; x + 8 <= count; x += 8) {
+    uint8x8x4_t p = vld4_u8(row + x * 4);
+    DSPImageAddx8(sums + x, DSPImageLumax8(p.val[0], p.val[1], p.val[2]));
+  }
+  return x;
+}
+
+static Int32 DSPImageAccumulateRGBVector(const UInt8* row,
+                                         UInt32* sums,
+                                         Int32 count) {
+  Int32 x = 0;
+  for (; x + 8 <= count; x += 8) {
+    uint8x8x3_t p = vld3_u8(row + x * 3);
+    DSPImageAddx8(sums + x, DSPImageLumax8(p.val[0], p.val[1], p.val[2]));
+  }
+  return x;
+}
+
+static Int32 DSPImageAccumulateYVector(const UInt8* row,
+                                       UInt32* sums,
+                                       Int32 count) {
+  Int32 x = 0;
+  for (; x + 16 <= count; x += 16) {
+    uint8x16_t y = vld1q_u8(row + x);
+    DSPImageAddx8(sums + x, vmovl_u8(vget_low_u8(y)));
+    DSPImageAddx8(sums + x + 8, vmovl_u8(vget_high_u8(y)));
+  }
+  return x;
+}
+#else
+static Int32 DSPImageAccumulateRGBAVector(const UInt8* row,
+                                          UInt32* sums,
+                                          Int32 count) {
+  (void)row;
+  (void)sums;
+  (void)count;
+  return 0;
+}
+
+static Int32 DSPImageAccumulateRGBVector(const UInt8* row,
+                                         UInt32* sums,
+                                         Int32 count) {
+  (void)row;
+  (void)sums;
+  (void)count;
+  return 0;
+}
+
+static Int32 DSPImageAccumulateYVector(const UInt8* row,
+                                       UInt32* sums,
+                                       Int32 count) {
+  (void)row;
+  (void)sums;
+  (void)count;
+  return 0;
+}
+#endif
+
+/* MARK: - Reduction */
+/* Adds the luma of one row to the column sums. */
+static void DSPImageAccumulate(const UInt8* row,
+                               UInt32* sums,
+                               Int32 count,
+                               enum DSPImagePixelFormat format) {
+  switch (format) {
+  case DSPImagePixelFormatRGBA8:
+    for (Int32 x = DSPImageAccumulateRGBAVector(row, sums, count); x < count;
+         x += 1) {
+      sums[x] += LUMA(row + x * 4);
+    }
+    break;
+  case DSPImagePixelFormatRGB8:
+    for (Int32 x = DSPImageAccumulateRGBVector(row, sums, count); x < count;
+         x += 1) {
+      sums[x] += LUMA(row + x * 3);
+    }
+    break;
+  case DSPImagePixelFormatYUV420:
+    for (Int32 x = DSPImageAccumulateYVector(row, sums, count); x < count;
+         x += 1) {
+      sums[x] += row[x];
+    }
+    break;
+  }
+}
+
+Bool DSPImageReduceLuma(const UInt8* pixels,
+                        Int32 width,
+                        Int32 height,
+                        Int32 bytesPerRow,
+                        enum DSPImagePixelFormat format,
+                        Float32* output,
+                        Int32 outputWidth,
+                        Int32 outputHeight) {
+  Int32 bytesPerPixel;
+  double scale;
+
+  switch (format) {
+  case DSPImagePixelFormatRGBA8:
+    bytesPerPixel = 4;
+    scale = 256;
+    break;
+  case DSPImagePixelFormatRGB8:
+    bytesPerPixel = 3;
+    scale = 256;
+    break;
+  case DSPImagePixelFormatYUV420:
+    bytesPerPixel = 1;
+    scale = 1;
+    break;
+  default:
+    return false;
+  }
+
+  /*
+   * A column sum adds up at most 65535 rows of 255 * 256, which still fits
+   * 32 bits.
+   */
+  if (width > 65535 || height > 65535 ||
+      outputWidth < 1 || outputWidth > width ||
+      outputHeight < 1 || outputHeight > height ||
+      bytesPerRow < (Int64)width * bytesPerPixel) {
+    return false;
+  }
+
+  UInt32* sums = malloc(width * sizeof(UInt32));
+  if (sums == NULL) {
+    return false;
+  }
+
+  Int32 y = 0;
+  for (Int32 oy = 0; oy < outputHeight; oy += 1) {
+    Int32 bottom = (Int32)((Int64)(oy + 1) * height / outputHeight);
+    Int32 rows = bottom - y;
+
+    /* 1. Vertical: the rows of this output row, into column sums */
+    memset(sums, 0, width * sizeof(UInt32));
+    for (; y < bottom; y += 1) {
+      DSPImageAccumulate(pixels + (Int64)y * bytesPerRow, sums, width, format);
+    }
+
+    /* 2. Horizontal: the column sums of each output sample */
+    Int32 x = 0;
+    for (Int32 ox = 0; ox < outputWidth; ox += 1) {
+      Int32 right = (Int32)((Int64)(ox + 1) * width / outputWidth);
+      Int32 columns = right - x;
+      UInt64 sum = 0;
+
+      for (; x < right; x += 1) {
+        sum += sums[x];
+      }
+      output[oy * outputWidth + ox] = (Float32)(
+        (double)sum / ((double)rows * columns * scale)
+      );
+    }
+  }
+
+  free(sums);
+  return true;
+}
+
+Bool DSPImageReduceLuma32x32(const UInt8* pixels,
+                             Int32 width,
+                             Int32 height,
+                             Int32 bytesPerRow,
+                             enum DSPImagePixelFormat format,
+                             Float32 output[static 1024]) {
+  return DSPImageReduceLuma(
+    pixels,
+    width,
+    height,
+    bytesPerRow,
+    format,
+    output,
+    32,
+    32
+  );
+}
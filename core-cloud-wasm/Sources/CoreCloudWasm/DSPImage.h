@@ -0,0 +1,91 @@
+//
+//  DSPImage.h
+//  core-cloud-wasm
+//
+//  Created by Fang Ling on 2026/10/17.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#ifndef DSPImage_h
+#define DSPImage_h
+
+#include "Base.h"
+
+/**
+ * Pixel formats accepted by ``DSPImageReduceLuma()``.
+ */
+enum DSPImagePixelFormat {
+  /** 8-bit red, green, blue and alpha samples; alpha is ignored. */
+  DSPImagePixelFormatRGBA8,
+  /** 8-bit red, green and blue samples. */
+  DSPImagePixelFormatRGB8,
+  /** Planar 4:2:0 YUV; only the Y plane is read. */
+  DSPImagePixelFormatYUV420
+};
+
+/**
+ * Reduces an image to a grid of luma samples by box averaging.
+ *
+ * Every output sample is the mean luma of the source pixels it covers, with
+ * red, green and blue weighted 77:150:29 (BT.601 in 1/256 steps) and the Y
+ * plane of YUV images taken as is. The image is read once, top to bottom,
+ * accumulating the rows of each output row in 32-bit integer vector lanes.
+ *
+ * - Parameters:
+ *   - pixels: The first row of the image, or of the Y plane for YUV.
+ *   - width: The number of pixels in a row, at most 65535.
+ *   - height: The number of rows, at most 65535.
+ *   - bytesPerRow: The distance in bytes between two rows.
+ *   - format: The pixel format of the image.
+ *   - output: A buffer to store `outputWidth * outputHeight` luma samples
+ *             between 0 and 255, row by row.
+ *   - outputWidth: The number of output samples per row, between 1 and
+ *                  `width`.
+ *   - outputHeight: The number of output rows, between 1 and `height`.
+ *
+ * - Returns: `true` if the image was reduced; `false` if a size is out of
+ *   range or the memory could not be allocated.
+ */
+Bool DSPImageReduceLuma(const UInt8* pixels,
+                        Int32 width,
+                        Int32 height,
+                        Int32 bytesPerRow,
+                        enum DSPImagePixelFormat format,
+                        Float32* output,
+                        Int32 outputWidth,
+                        Int32 outputHeight);
+
+/**
+ * Reduces an image to the 32x32 luma block that ``DSPDCT2D32x32()`` and
+ * ``ImagePerceptualHash64()`` consume.
+ *
+ * - Parameters:
+ *   - pixels: The first row of the image, or of the Y plane for YUV.
+ *   - width: The number of pixels in a row, between 32 and 65535.
+ *   - height: The number of rows, between 32 and 65535.
+ *   - bytesPerRow: The distance in bytes between two rows.
+ *   - format: The pixel format of the image.
+ *   - output: A buffer to store the row-major 32x32 luma block.
+ *
+ * - Returns: `true` if the image was reduced; `false` if a size is out of
+ *   range or the memory could not be allocated.
+ */
+Bool DSPImageReduceLuma32x32(const UInt8* pixels,
+                             Int32 width,
+                             Int32 height,
+                             Int32 bytesPerRow,
+                             enum DSPImagePixelFormat format,
+                             Float32 output[static 1024]);
+
+#endif /* DSPImage_h */
@@ -19,15 +19,210 @@
 
 #include "DSPMatrix.h"
 
+/*
+ * Blocks are halved along their longer side, at multiples of 4, until both
+ * sides fit `DSPMatrixBlockCount`.  Such a block fits in L1 whatever the
+ * strides, and is then moved in 4x4 register tiles.
+ */
+#define DSPMatrixBlockCount 16
+
+/* MARK: - Tiles */
+/* Loads the 4x4 tile at `source` and stores its transpose at `destination`. */
+static inline void DSPMatrixTransposeTile(const Float32* source,
+                                          Int32 sourceStride,
+                                          Float32* destination,
+                                          Int32 destinationStride) {
+  Float32x4 r[4];
+
+  for (Int32 i = 0; i < 4; i += 1) {
+    r[i] = Float32x4_Load(source + i * sourceStride);
+  }
+  Float32x4_Transpose4x4(r);
+  for (Int32 i = 0; i < 4; i += 1) {
+    Float32x4_Store(destination + i * destinationStride, r[i]);
+  }
+}
+
+/* Exchanges the 4x4 tile at `a` with the transpose of the one at `b`. */
+static inline void DSPMatrixSwapTile(Float32* a, Float32* b, Int32 stride) {
+  Float32x4 x[4];
+  Float32x4 y[4];
+
+  for (Int32 i = 0; i < 4; i += 1) {
+    x[i] = Float32x4_Load(a + i * stride);
+    y[i] = Float32x4_Load(b + i * stride);
+  }
+  Float32x4_Transpose4x4(x);
+  Float32x4_Transpose4x4(y);
+  for (Int32 i = 0; i < 4; i += 1) {
+    Float32x4_Store(b + i * stride, x[i]);
+    Float32x4_Store(a + i * stride, y[i]);
+  }
+}
+
+/* Splits `count` in two, at a multiple of 4 when it is large enough. */
+static inline Int32 DSPMatrixSplit(Int32 count) {
+  Int32 half = (count / 2 + 3) & ~3;
+  return half < count ? half : count / 2;
+}
+
+/* MARK: - Out-of-place */
+void DSPMatrixTranspose(const Float32* input,
+                        Int32 rows,
+                        Int32 columns,
+                        Int32 inputStride,
+                        Float32* output,
+                        Int32 outputStride) {
+  if (rows > DSPMatrixBlockCount || columns > DSPMatrixBlockCount) {
+    if (rows >= columns) {
+      Int32 top = DSPMatrixSplit(rows);
+      DSPMatrixTranspose(
+        input,
+        top,
+        columns,
+        inputStride,
+        output,
+        outputStride
+      );
+      DSPMatrixTranspose(
+        input + top * inputStride,
+        rows - top,
+        columns,
+        inputStride,
+        output + top,
+        outputStride
+      );
+    } else {
+      Int32 left = DSPMatrixSplit(columns);
+      DSPMatrixTranspose(
+        input,
+        rows,
+        left,
+        inputStride,
+        output,
+        outputStride
+      );
+      DSPMatrixTranspose(
+        input + left,
+        rows,
+        columns - left,
+        inputStride,
+        output + left * outputStride,
+        outputStride
+      );
+    }
+    return;
+  }
+
+  /* 1. 4x4 tiles */
+  Int32 rows4 = rows & ~3;
+  Int32 columns4 = columns & ~3;
+  for (Int32 r = 0; r < rows4; r += 4) {
+    for (Int32 c = 0; c < columns4; c += 4) {
+      DSPMatrixTransposeTile(
+        input + r * inputStride + c,
+        inputStride,
+        output + c * outputStride + r,
+        outputStride
+      );
+    }
+  }
+
+  /* 2. The last rows and columns, one element at a time */
+  for (Int32 r = 0; r < rows; r += 1) {
+    for (Int32 c = r < rows4 ? columns4 : 0; c < columns; c += 1) {
+      output[c * outputStride + r] = input[r * inputStride + c];
+    }
+  }
+}
+
 /* 32x32 matrix transposition. */
 void DSPMatrixTranspose32x32(const Float32* input, Float32* output) {
-  for (Int32 i = 0; i < 32; i += 8) {
-    for (Int32 j = 0; j < 32; j += 8) {
-      for (Int32 r = 0; r < 8; r += 1) {
-        for (Int32 c = 0; c < 8; c += 1) {
-          output[(j + c) * 32 + (i + r)] = input[(i + r) * 32 + (j + c)];
-        }
-      }
+  DSPMatrixTranspose(input, 32, 32, 32, output, 32);
+}
+
+/* MARK: - In-place */
+/* Exchanges the rows x columns block `a` with the transpose of block `b`. */
+static void DSPMatrixSwapBlock(Float32* a,
+                               Float32* b,
+                               Int32 rows,
+                               Int32 columns,
+                               Int32 stride) {
+  if (rows > DSPMatrixBlockCount || columns > DSPMatrixBlockCount) {
+    if (rows >= columns) {
+      Int32 top = DSPMatrixSplit(rows);
+      DSPMatrixSwapBlock(a, b, top, columns, stride);
+      DSPMatrixSwapBlock(
+        a + top * stride,
+        b + top,
+        rows - top,
+        columns,
+        stride
+      );
+    } else {
+      Int32 left = DSPMatrixSplit(columns);
+      DSPMatrixSwapBlock(a, b, rows, left, stride);
+      DSPMatrixSwapBlock(
+        a + left,
+        b + left * stride,
+        rows,
+        columns - left,
+        stride
+      );
+    }
+    return;
+  }
+
+  /* 1. 4x4 tiles */
+  Int32 rows4 = rows & ~3;
+  Int32 columns4 = columns & ~3;
+  for (Int32 r = 0; r < rows4; r += 4) {
+    for (Int32 c = 0; c < columns4; c += 4) {
+      DSPMatrixSwapTile(a + r * stride + c, b + c * stride + r, stride);
+    }
+  }
+
+  /* 2. The last rows and columns, one element at a time */
+  for (Int32 r = 0; r < rows; r += 1) {
+    for (Int32 c = r < rows4 ? columns4 : 0; c < columns; c += 1) {
+      Float32 x = a[r * stride + c];
+      a[r * stride + c] = b[c * stride + r];
+      b[c * stride + r] = x;
+    }
+  }
+}
+
+/* The diagonal blocks in place, the blocks across the diagonal in pairs */
+void DSPMatrixTransposeInPlace(Float32* matrix, Int32 count, Int32 stride) {
+  if (count > DSPMatrixBlockCount) {
+    Int32 half = DSPMatrixSplit(count);
+    Float32* right = matrix + half;
+    Float32* bottom = matrix + half * stride;
+
+    DSPMatrixTransposeInPlace(matrix, half, stride);
+    DSPMatrixTransposeInPlace(bottom + half, count - half, stride);
+    DSPMatrixSwapBlock(right, bottom, half, count - half, stride);
+    return;
+  }
+
+  /* 1. 4x4 tiles: the diagonal ones in place, the others in pairs */
+  Int32 count4 = count & ~3;
+  for (Int32 r = 0; r < count4; r += 4) {
+    Float32* tile = matrix + r * stride + r;
+    DSPMatrixTransposeTile(tile, stride, tile, stride);
+    for (Int32 c = r + 4; c < count4; c += 4) {
+      Float32* upper = matrix + r * stride + c;
+      Float32* lower = matrix + c * stride + r;
+      DSPMatrixSwapTile(upper, lower, stride);
+    }
+  }
+
+  /* 2. The last columns and the rows they mirror */
+  for (Int32 r = 0; r < count; r += 1) {
+    for (Int32 c = r + 1 > count4 ? r + 1 : count4; c < count; c += 1) {
+      Float32 x = matrix[r * stride + c];
+      matrix[r * stride + c] = matrix[c * stride + r];
+      matrix[c * stride + r] = x;
     }
   }
 }
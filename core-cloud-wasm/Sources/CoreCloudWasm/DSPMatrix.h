@@ -31,4 +31,39 @@
  */
 void DSPMatrixTranspose32x32(const Float32* input, Float32* output);
 
+/**
+ * Transposes a single-precision matrix of any size.
+ *
+ * The matrix is divided recursively into blocks that fit in the data cache,
+ * and each block is moved in 4x4 register tiles, so large matrices and large
+ * strides do not thrash the cache.
+ *
+ * - Parameters:
+ *   - input: The row-major input matrix.
+ *   - rows: The number of rows in the input matrix.
+ *   - columns: The number of columns in the input matrix.
+ *   - inputStride: The distance between two rows of the input matrix, at
+ *                  least `columns`.
+ *   - output: The row-major output matrix, with `columns` rows and `rows`
+ *             columns. It must not overlap the input matrix.
+ *   - outputStride: The distance between two rows of the output matrix, at
+ *                   least `rows`.
+ */
+void DSPMatrixTranspose(const Float32* input,
+                        Int32 rows,
+                        Int32 columns,
+                        Int32 inputStride,
+                        Float32* output,
+                        Int32 outputStride);
+
+/**
+ * Transposes a square, single-precision matrix in place.
+ *
+ * - Parameters:
+ *   - matrix: The row-major matrix.
+ *   - count: The number of rows and columns.
+ *   - stride: The distance between two rows, at least `count`.
+ */
+void DSPMatrixTransposeInPlace(Float32* matrix, Int32 count, Int32 stride);
+
 #endif /* DSPMatrix_h */
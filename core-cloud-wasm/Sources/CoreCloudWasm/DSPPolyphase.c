@@ -0,0 +1,181 @@
+//
+//  DSPPolyphase.c
+//  core-cloud-wasm
+//
+//  Created by Fang Ling on 2026/10/17.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#include "DSPPolyphase.h"
+#include "DSPDCT.h"
+#include "DSPVector.h"
+
+#include <stdlib.h>
+
+/*
+ * The standard computes V[i] = sum(cos((16+i)(2k+1)pi/64) S[k]) for 64 values
+ * of i per frame, shifts them into a 1024-sample vector, and then takes 16
+ * dot products of 32 taps out of every other 32-sample half.  Every V[i] is a
+ * coefficient of the 32-point DCT-II of S, up to a sign, so one DSPDCT32 call
+ * feeds each frame, and only the halves that the windowing reads are used.
+ *
+ * The history is a ring of the last 16 blocks of V, newest first.  For every
+ * block t, the windowing reads V[0..31] of even blocks and V[32..63] of odd
+ * ones:
+ *
+ *   sample[j] = sum(V_2i[j] D[64i+j] + V_2i+1[32+j] D[64i+32+j], 0 <= i < 8)
+ *
+ * which are contiguous runs of j on both sides, so they are vectorized as is.
+ */
+
+/* The number of blocks of V the windowing reads */
+#define DSPPolyphaseBlockCount 16
+
+struct DSPPolyphaseSynthesis {
+  /* D[i] */
+  Float32 window[DSPPolyphaseWindowCount];
+  /* The last blocks of V, the newest at `offset` */
+  Float32 history[DSPPolyphaseBlockCount][2 * DSPPolyphaseSubbandCount];
+  Int32 offset;
+};
+
+/* MARK: - Window */
+/*
+ * D[i] * 65536 for 0 <= i <= 256, rounded.  The other half mirrors it:
+ * D[512-i] = D[i] when i is a multiple of 64, and -D[i] otherwise.
+ */
+static const Int32 DSPPolyphaseHalfWindow[257] = {
+       0,     -1,     -1,     -1,     -1,     -1,     -1,     -2,
+      -2,     -2,     -2,     -3,     -3,     -4,     -4,     -5,
+      -5,     -6,     -7,     -7,     -8,     -9,    -10,    -11,
+     -13,    -14,    -16,    -17,    -19,    -21,    -24,    -26,
+     -29,    -31,    -35,    -38,    -41,    -45,    -49,    -53,
+     -58,    -63,    -68,    -73,    -79,    -85,    -91,    -97,
+    -104,   -111,   -117,   -125,   -132,   -139,   -147,   -154,
+    -161,   -169,   -176,   -183,   -190,   -196,   -202,   -208,
+     213,    218,    222,    225,    227,    228,    228,    227,
+     224,    221,    215,    208,    200,    189,    177,    163,
+     146,    127,    106,     83,     57,     29,     -2,    -36,
+     -72,   -111,   -153,   -197,   -244,   -294,   -347,   -401,
+    -459,   -519,   -581,   -645,   -711,   -779,   -848,   -919,
+    -991,  -1064,  -1137,  -1210,  -1283,  -1356,  -1428,  -1498,
+   -1567,  -1634,  -1698,  -1759,  -1817,  -1870,  -1919,  -1962,
+   -2001,  -2032,  -2057,  -2075,  -2085,  -2087,  -2080,  -2063,
+    2037,   2000,   1952,   1893,   1822,   1739,   1644,   1535,
+    1414,   1280,   1131,    970,    794,    605,    402,    185,
+     -45,   -288,   -545,   -814,  -1095,  -1388,  -1692,  -2006,
+   -2330,  -2663,  -3004,  -3351,  -3705,  -4063,  -4425,  -4788,
+   -5153,  -5517,  -5879,  -6237,  -6589,  -6935,  -7271,  -7597,
+   -7910,  -8209,  -8491,  -8755,  -8998,  -9219,  -9416,  -9585,
+   -9727,  -9838,  -9916,  -9959,  -9966,  -9935,  -9863,  -9750,
+   -9592,  -9389,  -9139,  -8840,  -8492,  -8092,  -7640,  -7134,
+    6574,   5959,   5288,   4561,   3776,   2935,   2037,   1082,
+      70,   -998,  -2122,  -3300,  -4533,  -5818,  -7154,  -8540,
+   -9975, -11455, -12980, -14548, -16155, -17799, -19478, -21189,
+  -22929, -24694, -26482, -28289, -30112, -31947, -33791, -35640,
+  -37489, -39336, -41176, -43006, -44821, -46617, -48390, -50137,
+  -51853, -53534, -55178, -56778, -58333, -59838, -61289, -62684,
+  -64019, -65290, -66494, -67629, -68692, -69679, -70590, -71420,
+  -72169, -72835, -73415, -73908, -74313, -74630, -74856, -74992,
+   75038,
+};
+
+void DSPPolyphaseGetWindow(Float32 window[static 512]) {
+  for (Int32 i = 0; i <= 256; i += 1) {
+    window[i] = (Float32)DSPPolyphaseHalfWindow[i] / 65536;
+  }
+  for (Int32 i = 1; i < 256; i += 1) {
+    window[512 - i] = i % 64 == 0 ? window[i] : -window[i];
+  }
+}
+
+/* MARK: - Synthesis */
+struct DSPPolyphaseSynthesis* DSPPolyphaseCreateSynthesis(void) {
+  struct DSPPolyphaseSynthesis* synthesis = malloc(sizeof(*synthesis));
+  if (synthesis == NULL) {
+    return NULL;
+  }
+  DSPPolyphaseGetWindow(synthesis->window);
+  DSPPolyphaseResetSynthesis(synthesis);
+  return synthesis;
+}
+
+/* Shifts the block of V of the next frame into the history. */
+static void DSPPolyphaseMatrix(struct DSPPolyphaseSynthesis* synthesis,
+                               const Float32* subbands) {
+  Float32 x[DSPPolyphaseSubbandCount];
+  DSPDCT32Execute(subbands, x);
+
+  synthesis->offset = (synthesis->offset - 1) & (DSPPolyphaseBlockCount - 1);
+  Float32* v = synthesis->history[synthesis->offset];
+
+  /* V[i] = X[16+i], with X[32] = 0, X[64-i] = -X[i] and X[64+i] = -X[i] */
+  for (Int32 j = 0; j < 16; j += 1) {
+    v[j] = x[16 + j];
+    v[32 + j] = -x[16 - j];
+  }
+  v[16] = 0;
+  v[48] = -x[0];
+  for (Int32 j = 17; j < 32; j += 1) {
+    v[j] = -x[48 - j];
+    v[32 + j] = -x[j - 16];
+  }
+}
+
+/* Windows the history into 32 PCM samples. */
+static void DSPPolyphaseWindow(const struct DSPPolyphaseSynthesis* synthesis,
+                               Float32* samples) {
+  Vector sum[DSPPolyphaseSubbandCount / VLANES];
+  for (Int32 k = 0; k < DSPPolyphaseSubbandCount / VLANES; k += 1) {
+    sum[k] = VSPLAT(0);
+  }
+
+  for (Int32 i = 0; i < DSPPolyphaseBlockCount / 2; i += 1) {
+    Int32 t = (synthesis->offset + 2 * i) & (DSPPolyphaseBlockCount - 1);
+    Int32 u = (t + 1) & (DSPPolyphaseBlockCount - 1);
+    const Float32* even = synthesis->history[t];
+    const Float32* odd = synthesis->history[u] + 32;
+    const Float32* window = synthesis->window + 64 * i;
+
+    for (Int32 k = 0; k < DSPPolyphaseSubbandCount / VLANES; k += 1) {
+      Int32 j = k * VLANES;
+      sum[k] = VMADD(VLOAD(even + j), VLOAD(window + j), sum[k]);
+      sum[k] = VMADD(VLOAD(odd + j), VLOAD(window + 32 + j), sum[k]);
+    }
+  }
+
+  for (Int32 k = 0; k < DSPPolyphaseSubbandCount / VLANES; k += 1) {
+    VSTORE(samples + k * VLANES, sum[k]);
+  }
+}
+
+void DSPPolyphaseSynthesize(struct DSPPolyphaseSynthesis* synthesis,
+                            const Float32* subbands,
+                            Float32* samples,
+                            Int32 count) {
+  for (Int32 n = 0; n < count; n += 1) {
+    Int32 offset = n * DSPPolyphaseSubbandCount;
+    DSPPolyphaseMatrix(synthesis, subbands + offset);
+    DSPPolyphaseWindow(synthesis, samples + offset);
+  }
+}
+
+void DSPPolyphaseResetSynthesis(struct DSPPolyphaseSynthesis* synthesis) {
+  memset(synthesis->history, 0, sizeof(synthesis->history));
+  synthesis->offset = 0;
+}
+
+void DSPPolyphaseDestroySynthesis(struct DSPPolyphaseSynthesis* synthesis) {
+  free(synthesis);
+}
@@ -0,0 +1,97 @@
+//
+//  DSPPolyphase.h
+//  core-cloud-wasm
+//
+//  Created by Fang Ling on 2026/10/17.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#ifndef DSPPolyphase_h
+#define DSPPolyphase_h
+
+#include "Base.h"
+
+/**
+ * The number of subbands, and of PCM samples, in a polyphase frame.
+ */
+#define DSPPolyphaseSubbandCount 32
+
+/**
+ * The number of taps of the polyphase synthesis window.
+ */
+#define DSPPolyphaseWindowCount 512
+
+/**
+ * The 32-subband polyphase synthesis filterbank of MPEG-1 audio layers I, II
+ * and III (ISO/IEC 11172-3, 2.4.3.2.2).
+ *
+ * A synthesis keeps the 1024-sample V vector of the standard between calls,
+ * so a channel is decoded by feeding its frames to the same synthesis in
+ * order. Create one synthesis per channel, and do not use the same synthesis
+ * from more than one thread at a time.
+ */
+struct DSPPolyphaseSynthesis;
+
+/**
+ * Creates a polyphase synthesis with a silent history.
+ *
+ * - Returns: A new polyphase synthesis, or `NULL` if the memory could not be
+ *   allocated. Release it with ``DSPPolyphaseDestroySynthesis()``.
+ */
+struct DSPPolyphaseSynthesis* DSPPolyphaseCreateSynthesis(void);
+
+/**
+ * Turns frames of subband samples into PCM samples.
+ *
+ * Each frame of ``DSPPolyphaseSubbandCount`` subband samples, lowest band
+ * first, yields ``DSPPolyphaseSubbandCount`` PCM samples. Full-scale subband
+ * samples give PCM samples between -1 and 1.
+ *
+ * - Parameters:
+ *   - synthesis: A polyphase synthesis.
+ *   - subbands: `count` frames of subband samples, one after another.
+ *   - samples: A buffer to store `count * DSPPolyphaseSubbandCount` PCM
+ *              samples. It may be the same buffer as `subbands`.
+ *   - count: The number of frames.
+ */
+void DSPPolyphaseSynthesize(struct DSPPolyphaseSynthesis* synthesis,
+                            const Float32* subbands,
+                            Float32* samples,
+                            Int32 count);
+
+/**
+ * Clears the history of a polyphase synthesis, as after a seek.
+ *
+ * - Parameter synthesis: A polyphase synthesis.
+ */
+void DSPPolyphaseResetSynthesis(struct DSPPolyphaseSynthesis* synthesis);
+
+/**
+ * Destroys a polyphase synthesis.
+ *
+ * - Parameter synthesis: A polyphase synthesis, or `NULL`.
+ */
+void DSPPolyphaseDestroySynthesis(struct DSPPolyphaseSynthesis* synthesis);
+
+/**
+ * Copies the synthesis window D[i] of ISO/IEC 11172-3, table 3-B.3.
+ *
+ * The matching analysis window of table 3-C.1 is `D[i] / 32`.
+ *
+ * - Parameter window: A buffer to store ``DSPPolyphaseWindowCount`` window
+ *                     coefficients.
+ */
+void DSPPolyphaseGetWindow(Float32 window[static 512]);
+
+#endif /* DSPPolyphase_h */
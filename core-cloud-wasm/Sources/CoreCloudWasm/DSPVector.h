@@ -0,0 +1,66 @@
+//
+//  DSPVector.h
+//  core-cloud-wasm
+//
+//  Created by Fang Ling on 2026/10/17.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#ifndef DSPVector_h
+#define DSPVector_h
+
+#include "Base.h"
+
+/*
+ * Single-precision vectors shared by the DSP kernels.
+ *
+ * A vector holds `VLANES` independent samples.  AVX targets use 8 lanes;
+ * every other target uses the 4 lanes of `Float32x4`.  Define `SIMD_SCALAR`
+ * to build the plain C reference instead.
+ */
+#if defined(__AVX__) && !defined(SIMD_SCALAR)
+#include <immintrin.h>
+
+typedef __m256 Vector;
+
+#define VLANES         8
+#define VADD(a, b)     _mm256_add_ps(a, b)
+#define VSUB(a, b)     _mm256_sub_ps(a, b)
+#define VMUL(a, b)     _mm256_mul_ps(a, b)
+#if defined(__FMA__)
+#define VMADD(a, b, c) _mm256_fmadd_ps(a, b, c)
+#else
+#define VMADD(a, b, c) _mm256_add_ps(_mm256_mul_ps(a, b), c)
+#endif
+#define VMIN(a, b)     _mm256_min_ps(a, b)
+#define VMAX(a, b)     _mm256_max_ps(a, b)
+#define VSPLAT(x)      _mm256_set1_ps(x)
+#define VLOAD(p)       _mm256_loadu_ps(p)
+#define VSTORE(p, x)   _mm256_storeu_ps(p, x)
+#else
+typedef Float32x4 Vector;
+
+#define VLANES         4
+#define VADD(a, b)     Float32x4_Add(a, b)
+#define VSUB(a, b)     Float32x4_Subtract(a, b)
+#define VMUL(a, b)     Float32x4_Multiply(a, b)
+#define VMADD(a, b, c) Float32x4_MultiplyAdd(a, b, c)
+#define VMIN(a, b)     Float32x4_Minimum(a, b)
+#define VMAX(a, b)     Float32x4_Maximum(a, b)
+#define VSPLAT(x)      Float32x4_Splat(x)
+#define VLOAD(p)       Float32x4_Load(p)
+#define VSTORE(p, x)   Float32x4_Store(p, x)
+#endif
+
+#endif /* DSPVector_h */
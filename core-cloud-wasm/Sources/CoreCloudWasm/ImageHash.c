@@ -0,0 +1,56 @@
+//
+//  ImageHash.c
+//  core-cloud-wasm
+//
+//  Created by Fang Ling on 2026/10/17.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#include "ImageHash.h"
+#include "DSPDCT.h"
+
+/* MARK: - Perceptual Hash */
+UInt64 ImagePerceptualHash64(const Float32 luma[static 1024]) {
+  Float32 block[32 * 32];
+  Float32 coefficients[64];
+  Float32 sorted[64];
+  UInt64 hash = 0;
+
+  DSPDCT2D32x32(luma, block);
+
+  /* 1. The low frequencies, without the first row and column */
+  for (Int32 u = 0; u < 8; u += 1) {
+    for (Int32 v = 0; v < 8; v += 1) {
+      coefficients[u * 8 + v] = block[(u + 1) * 32 + (v + 1)];
+    }
+  }
+
+  /* 2. Their median, by insertion sort */
+  for (Int32 i = 0; i < 64; i += 1) {
+    Float32 x = coefficients[i];
+    Int32 j = i;
+
+    for (; j > 0 && sorted[j - 1] > x; j -= 1) {
+      sorted[j] = sorted[j - 1];
+    }
+    sorted[j] = x;
+  }
+  Float32 median = (sorted[31] + sorted[32]) / 2;
+
+  /* 3. One bit per coefficient */
+  for (Int32 i = 0; i < 64; i += 1) {
+    hash |= (UInt64)(coefficients[i] > median) << i;
+  }
+  return hash;
+}
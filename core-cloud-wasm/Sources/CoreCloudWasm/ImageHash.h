@@ -0,0 +1,45 @@
+//
+//  ImageHash.h
+//  core-cloud-wasm
+//
+//  Created by Fang Ling on 2026/10/17.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#ifndef ImageHash_h
+#define ImageHash_h
+
+#include "Base.h"
+
+/**
+ * Computes the 64-bit perceptual hash (pHash) of a 32x32 luma block.
+ *
+ * The hash keeps the 8x8 lowest frequencies of the block's two-dimensional
+ * DCT, skipping the first row and column whose DC and one-dimensional terms
+ * mostly follow the brightness and gradients of the picture. Each bit is set
+ * when its coefficient is greater than the median of the 64 coefficients:
+ *
+ *     bit (8 * u + v) = H[u + 1][v + 1] > median, for 0 <= u, v < 8
+ *
+ * Visually similar images have hashes that differ in few bits, so compare
+ * hashes by their Hamming distance.
+ *
+ * - Parameter luma: A row-major 32x32 block of luma samples, typically the
+ *   whole image reduced by ``DSPImageReduceLuma32x32()``.
+ *
+ * - Returns: The perceptual hash of the block.
+ */
+UInt64 ImagePerceptualHash64(const Float32 luma[static 1024]);
+
+#endif /* ImageHash_h */
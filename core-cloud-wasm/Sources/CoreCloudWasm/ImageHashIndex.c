@@ -0,0 +1,539 @@
+//
+//  ImageHashIndex.c
+//  core-cloud-wasm
+//
+//  Created by Fang Ling on 2026/10/17.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#include "ImageHashIndex.h"
+
+#include <stdlib.h>
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__
+#error "The buffer of an image hash index is little-endian"
+#endif
+
+#define ImageHashIndexHeaderSize 16
+#define ImageHashIndexMinimumSubstringCount 4
+#define ImageHashIndexMaximumSubstringCount 8
+/* Pending hashes are merged when there are more than this, or than indexed */
+#define ImageHashIndexPendingLimit 4096
+/* A probe costs about as much as scanning this many hashes */
+#define ImageHashIndexProbeCost 16
+/* Hashes are verified this many at a time in a scan or a probe */
+#define ImageHashIndexScanCount 256
+
+static const UInt8 INDEX_MAGIC[8] = { 'H', 'A', 'S', 'H', 'I', 'D', 'X', 1 };
+
+struct ImageHashIndex {
+  /* The buffer, which the index owns if `storage` is not `NULL` */
+  const UInt8* bytes;
+  Int64 byteCount;
+  UInt8* storage;
+
+  /* Views into the buffer */
+  Int64 count;
+  Int32 substringCount;
+  Int32 widths[ImageHashIndexMaximumSubstringCount];
+  Int32 shifts[ImageHashIndexMaximumSubstringCount];
+  const UInt64* hashes;
+  const UInt32* entries[ImageHashIndexMaximumSubstringCount];
+  const UInt32* directories[ImageHashIndexMaximumSubstringCount];
+
+  /* Hashes inserted since the buffer was built, entries `count` and up */
+  UInt64* pending;
+  Int64 pendingCount;
+  Int64 pendingCapacity;
+};
+
+/* MARK: - Layout */
+/* Aims for about log2(count) bits per substring */
+static Int32 ImageHashIndexSubstringCount(Int64 count) {
+  Int32 bits = count > 1 ? 63 - __builtin_clzll((UInt64)count) : 1;
+  Int32 m = (64 + bits - 1) / bits;
+
+  if (m < ImageHashIndexMinimumSubstringCount) {
+    m = ImageHashIndexMinimumSubstringCount;
+  }
+  if (m > ImageHashIndexMaximumSubstringCount) {
+    m = ImageHashIndexMaximumSubstringCount;
+  }
+  return m;
+}
+
+/* Returns the number of bytes in the buffer. */
+static Int64 ImageHashIndexLayout(Int32 substringCount,
+                                  Int64 count,
+                                  Int32 widths[static 1],
+                                  Int32 shifts[static 1]) {
+  Int64 byteCount = ImageHashIndexHeaderSize;
+  Int32 shift = 0;
+
+  byteCount += count * sizeof(UInt64);
+  byteCount += count * substringCount * sizeof(UInt32);
+  for (Int32 i = 0; i < substringCount; i += 1) {
+    widths[i] = 64 / substringCount + (i < 64 % substringCount ? 1 : 0);
+    shifts[i] = shift;
+    shift += widths[i];
+    byteCount += ((1LL << widths[i]) + 1) * sizeof(UInt32);
+  }
+  return byteCount;
+}
+
+static UInt32 ImageHashIndexSubstring(UInt64 hash, Int32 shift, Int32 width) {
+  return (UInt32)(hash >> shift) & ((1U << width) - 1);
+}
+
+/* Points the views of `index` into a buffer whose header is valid. */
+static void ImageHashIndexAttach(struct ImageHashIndex* index,
+                                 const UInt8* bytes,
+                                 Int64 byteCount) {
+  UInt32 header[2];
+
+  memcpy(header, bytes + 8, sizeof(header));
+  index->bytes = bytes;
+  index->byteCount = byteCount;
+  index->count = header[0];
+  index->substringCount = (Int32)header[1];
+  ImageHashIndexLayout(
+    index->substringCount,
+    index->count,
+    index->widths,
+    index->shifts
+  );
+
+  const UInt8* p = bytes + ImageHashIndexHeaderSize;
+  index->hashes = (const UInt64*)p;
+  p += index->count * sizeof(UInt64);
+  for (Int32 i = 0; i < index->substringCount; i += 1) {
+    index->entries[i] = (const UInt32*)p;
+    p += index->count * sizeof(UInt32);
+  }
+  for (Int32 i = 0; i < index->substringCount; i += 1) {
+    index->directories[i] = (const UInt32*)p;
+    p += ((1LL << index->widths[i]) + 1) * sizeof(UInt32);
+  }
+}
+
+/* MARK: - Building */
+/* Builds the buffer of the hashes of `a` followed by those of `b`. */
+static UInt8* ImageHashIndexBuild(const UInt64* a,
+                                  Int64 aCount,
+                                  const UInt64* b,
+                                  Int64 bCount,
+                                  Int64* byteCount) {
+  Int64 count = aCount + bCount;
+  UInt32 header[2] = { (UInt32)count, 0 };
+  Int32 widths[ImageHashIndexMaximumSubstringCount];
+  Int32 shifts[ImageHashIndexMaximumSubstringCount];
+
+  header[1] = (UInt32)ImageHashIndexSubstringCount(count);
+  *byteCount = ImageHashIndexLayout((Int32)header[1], count, widths, shifts);
+
+  /* `malloc` aligns to at least 8 bytes */
+  UInt8* bytes = malloc(*byteCount);
+  if (bytes == NULL) {
+    return NULL;
+  }
+  memcpy(bytes, INDEX_MAGIC, 8);
+  memcpy(bytes + 8, header, sizeof(header));
+
+  UInt64* hashes = (UInt64*)(bytes + ImageHashIndexHeaderSize);
+  if (aCount > 0) {
+    memcpy(hashes, a, aCount * sizeof(UInt64));
+  }
+  if (bCount > 0) {
+    memcpy(hashes + aCount, b, bCount * sizeof(UInt64));
+  }
+
+  /* Counting sorts, stable so that each bucket lists its entries in order */
+  UInt32* entries = (UInt32*)(hashes + count);
+  UInt32* directory = entries + count * header[1];
+  for (Int32 i = 0; i < (Int32)header[1]; i += 1) {
+    Int64 keyCount = 1LL << widths[i];
+
+    memset(directory, 0, (keyCount + 1) * sizeof(UInt32));
+    for (Int64 e = 0; e < count; e += 1) {
+      UInt32 key = ImageHashIndexSubstring(hashes[e], shifts[i], widths[i]);
+      directory[key + 1] += 1;
+    }
+    for (Int64 key = 0; key < keyCount; key += 1) {
+      directory[key + 1] += directory[key];
+    }
+    /* Placing advances each start to the next one, so shift them back */
+    for (Int64 e = 0; e < count; e += 1) {
+      UInt32 key = ImageHashIndexSubstring(hashes[e], shifts[i], widths[i]);
+      entries[directory[key]] = (UInt32)e;
+      directory[key] += 1;
+    }
+    memmove(directory + 1, directory, keyCount * sizeof(UInt32));
+    directory[0] = 0;
+
+    entries += count;
+    directory += keyCount + 1;
+  }
+  return bytes;
+}
+
+/* Moves the pending hashes into a new buffer. */
+static Bool ImageHashIndexMerge(struct ImageHashIndex* index) {
+  Int64 byteCount;
+
+  if (index->pendingCount == 0) {
+    return true;
+  }
+  UInt8* storage = ImageHashIndexBuild(
+    index->hashes,
+    index->count,
+    index->pending,
+    index->pendingCount,
+    &byteCount
+  );
+  if (storage == NULL) {
+    return false;
+  }
+  free(index->storage);
+  index->storage = storage;
+  index->pendingCount = 0;
+  ImageHashIndexAttach(index, storage, byteCount);
+  return true;
+}
+
+/* MARK: - Creating */
+static struct ImageHashIndex* ImageHashIndexAllocate(void) {
+  struct ImageHashIndex* index = malloc(sizeof(*index));
+  if (index == NULL) {
+    return NULL;
+  }
+  memset(index, 0, sizeof(*index));
+  return index;
+}
+
+struct ImageHashIndex* ImageHashIndexCreate(const UInt64* hashes,
+                                            Int64 count) {
+  Int64 byteCount;
+
+  if (count < 0 || count > UINT32_MAX) {
+    return NULL;
+  }
+  struct ImageHashIndex* index = ImageHashIndexAllocate();
+  if (index == NULL) {
+    return NULL;
+  }
+  index->storage = ImageHashIndexBuild(hashes, count, NULL, 0, &byteCount);
+  if (index->storage == NULL) {
+    free(index);
+    return NULL;
+  }
+  ImageHashIndexAttach(index, index->storage, byteCount);
+  return index;
+}
+
+/* Checks everything a search relies on to stay within the buffer. */
+static Bool ImageHashIndexValidate(const UInt8* bytes, Int64 byteCount) {
+  UInt32 header[2];
+  Int32 widths[ImageHashIndexMaximumSubstringCount];
+  Int32 shifts[ImageHashIndexMaximumSubstringCount];
+
+  if (byteCount < ImageHashIndexHeaderSize ||
+      (uintptr_t)bytes % _Alignof(UInt64) != 0 ||
+      memcmp(bytes, INDEX_MAGIC, 8) != 0) {
+    return false;
+  }
+  memcpy(header, bytes + 8, sizeof(header));
+  if (header[1] < ImageHashIndexMinimumSubstringCount ||
+      header[1] > ImageHashIndexMaximumSubstringCount) {
+    return false;
+  }
+  Int64 count = header[0];
+  Int32 substringCount = (Int32)header[1];
+  if (ImageHashIndexLayout(substringCount, count, widths, shifts) !=
+      byteCount) {
+    return false;
+  }
+
+  const UInt32* entries = (const UInt32*)(
+    bytes + ImageHashIndexHeaderSize + count * sizeof(UInt64)
+  );
+  UInt32 largest = 0;
+  for (Int64 p = 0; p < count * substringCount; p += 1) {
+    largest = entries[p] > largest ? entries[p] : largest;
+  }
+  if (count > 0 && largest >= count) {
+    return false;
+  }
+
+  const UInt32* directory = entries + count * substringCount;
+  for (Int32 i = 0; i < substringCount; i += 1) {
+    Int64 keyCount = 1LL << widths[i];
+    Bool ordered = directory[0] == 0 && directory[keyCount] == count;
+    for (Int64 key = 0; key < keyCount; key += 1) {
+      ordered &= directory[key] <= directory[key + 1];
+    }
+    if (!ordered) {
+      return false;
+    }
+    directory += keyCount + 1;
+  }
+  return true;
+}
+
+struct ImageHashIndex* ImageHashIndexCreateWithBytes(const UInt8* bytes,
+                                                     Int64 count) {
+  if (!ImageHashIndexValidate(bytes, count)) {
+    return NULL;
+  }
+  struct ImageHashIndex* index = ImageHashIndexAllocate();
+  if (index == NULL) {
+    return NULL;
+  }
+  ImageHashIndexAttach(index, bytes, count);
+  return index;
+}
+
+/* MARK: - Inserting */
+Int64 ImageHashIndexInsert(struct ImageHashIndex* index, UInt64 hash) {
+  Int64 entry = index->count + index->pendingCount;
+
+  if (entry >= UINT32_MAX) {
+    return -1;
+  }
+  if (index->pendingCount == index->pendingCapacity) {
+    Int64 capacity = index->pendingCapacity > 0
+      ? index->pendingCapacity * 2
+      : 64;
+    UInt64* pending = realloc(index->pending, capacity * sizeof(UInt64));
+    if (pending == NULL) {
+      return -1;
+    }
+    index->pending = pending;
+    index->pendingCapacity = capacity;
+  }
+  index->pending[index->pendingCount] = hash;
+  index->pendingCount += 1;
+
+  /* If this fails, the hashes wait for the next insertion */
+  if (index->pendingCount > ImageHashIndexPendingLimit ||
+      index->pendingCount > index->count) {
+    ImageHashIndexMerge(index);
+  }
+  return entry;
+}
+
+Int64 ImageHashIndexGetCount(const struct ImageHashIndex* index) {
+  return index->count + index->pendingCount;
+}
+
+/* MARK: - Searching */
+/*
+ * Computes the distances of up to `ImageHashIndexScanCount` hashes to
+ * `hash`, and returns whether any is within `distance`.
+ */
+static Bool ImageHashIndexDistances(const UInt64* hashes,
+                                    Int32 count,
+                                    UInt64 hash,
+                                    Int32 distance,
+                                    UInt8* distances) {
+  /* Branch-free, so that it vectorizes */
+  Int32 any = 0;
+  for (Int32 i = 0; i < count; i += 1) {
+    distances[i] = (UInt8)__builtin_popcountll(hashes[i] ^ hash);
+    any |= distances[i] <= distance;
+  }
+  return any != 0;
+}
+
+/* Appends `hashes` within `distance` of `hash` to the matches. */
+static Int64 ImageHashIndexScan(const UInt64* hashes,
+                                Int64 count,
+                                UInt64 hash,
+                                Int32 distance,
+                                Int64 firstEntry,
+                                struct ImageHashMatch* matches,
+                                Int64 capacity,
+                                Int64 found) {
+  UInt8 distances[ImageHashIndexScanCount];
+
+  for (Int64 start = 0; start < count; start += ImageHashIndexScanCount) {
+    Int32 n = count - start < ImageHashIndexScanCount
+      ? (Int32)(count - start)
+      : ImageHashIndexScanCount;
+
+    if (
+      !ImageHashIndexDistances(hashes + start, n, hash, distance, distances)
+    ) {
+      continue;
+    }
+    for (Int32 i = 0; i < n; i += 1) {
+      if (distances[i] <= distance) {
+        if (found < capacity) {
+          matches[found].entry = (UInt32)(firstEntry + start + i);
+          matches[found].distance = distances[i];
+        }
+        found += 1;
+      }
+    }
+  }
+  return found;
+}
+
+/* Returns the number of substring values within `radius` of one of `width`
+ * bits. */
+static Int64 ImageHashIndexProbeCount(Int32 width, Int32 radius) {
+  Int64 total = 0;
+  Int64 binomial = 1;
+
+  for (Int32 k = 0; k <= radius && k <= width; k += 1) {
+    total += binomial;
+    binomial = binomial * (width - k) / (k + 1);
+  }
+  return total;
+}
+
+Int64 ImageHashIndexSearch(const struct ImageHashIndex* index,
+                           UInt64 hash,
+                           Int32 distance,
+                           struct ImageHashMatch* matches,
+                           Int64 capacity) {
+  const Int32 m = index->substringCount;
+  Int32 radii[ImageHashIndexMaximumSubstringCount];
+  UInt64 candidates[ImageHashIndexScanCount];
+  UInt8 distances[ImageHashIndexScanCount];
+  Int64 probeCount = 0;
+  Int64 found = 0;
+
+  if (distance < 0) {
+    return 0;
+  }
+  distance = distance < 64 ? distance : 64;
+
+  /*
+   * With distance = q * m + a, a match is within q of the query on one of
+   * the first a + 1 substrings, or within q - 1 on one of the others:
+   * otherwise it would differ in at least (a + 1)(q + 1) + (m - a - 1) q =
+   * distance + 1 bits.
+   */
+  for (Int32 i = 0; i < m; i += 1) {
+    radii[i] = distance / m - (i > distance % m ? 1 : 0);
+    probeCount += ImageHashIndexProbeCount(index->widths[i], radii[i]);
+  }
+
+  if (probeCount * ImageHashIndexProbeCost >= index->count) {
+    found = ImageHashIndexScan(
+      index->hashes,
+      index->count,
+      hash,
+      distance,
+      0,
+      matches,
+      capacity,
+      found
+    );
+  } else {
+    for (Int32 i = 0; i < m; i += 1) {
+      const Int32 width = index->widths[i];
+      const UInt32* entries = index->entries[i];
+      const UInt32* directory = index->directories[i];
+      const UInt32 key = ImageHashIndexSubstring(hash, index->shifts[i], width);
+
+      for (Int32 k = 0; k <= radii[i]; k += 1) {
+        /* Every `width`-bit mask of `k` bits, in increasing order */
+        UInt32 mask = (1U << k) - 1;
+        while (mask < (1U << width)) {
+          UInt32 probe = key ^ mask;
+          /* Gathered, so that they are verified like a scan */
+          for (UInt32 p = directory[probe]; p < directory[probe + 1];
+               p += ImageHashIndexScanCount) {
+            Int32 n = directory[probe + 1] - p < ImageHashIndexScanCount
+              ? (Int32)(directory[probe + 1] - p)
+              : ImageHashIndexScanCount;
+            for (Int32 c = 0; c < n; c += 1) {
+              candidates[c] = index->hashes[entries[p + c]];
+            }
+            if (
+              !ImageHashIndexDistances(candidates, n, hash, distance, distances)
+            ) {
+              continue;
+            }
+
+            for (Int32 c = 0; c < n; c += 1) {
+              if (distances[c] > distance) {
+                continue;
+              }
+
+              /* Report each match from the first substring that finds it */
+              UInt64 difference = candidates[c] ^ hash;
+              Bool reported = false;
+              for (Int32 j = 0; j < i; j += 1) {
+                UInt32 x = ImageHashIndexSubstring(
+                  difference,
+                  index->shifts[j],
+                  index->widths[j]
+                );
+                reported |= __builtin_popcount(x) <= radii[j];
+              }
+              if (!reported) {
+                if (found < capacity) {
+                  matches[found].entry = entries[p + c];
+                  matches[found].distance = distances[c];
+                }
+                found += 1;
+              }
+            }
+          }
+
+          if (mask == 0) {
+            break;
+          }
+          /* The next mask with as many bits (Gosper) */
+          UInt32 c = mask & -mask;
+          UInt32 r = mask + c;
+          mask = (((r ^ mask) >> 2) / c) | r;
+        }
+      }
+    }
+  }
+
+  return ImageHashIndexScan(
+    index->pending,
+    index->pendingCount,
+    hash,
+    distance,
+    index->count,
+    matches,
+    capacity,
+    found
+  );
+}
+
+/* MARK: - Serialization */
+const UInt8* ImageHashIndexGetBytes(struct ImageHashIndex* index,
+                                    Int64* count) {
+  if (!ImageHashIndexMerge(index)) {
+    *count = 0;
+    return NULL;
+  }
+  *count = index->byteCount;
+  return index->bytes;
+}
+
+void ImageHashIndexDestroy(struct ImageHashIndex* index) {
+  if (index == NULL) {
+    return;
+  }
+  free(index->pending);
+  free(index->storage);
+  free(index);
+}
@@ -0,0 +1,184 @@
+//
+//  ImageHashIndex.h
+//  core-cloud-wasm
+//
+//  Created by Fang Ling on 2026/10/17.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#ifndef ImageHashIndex_h
+#define ImageHashIndex_h
+
+#include "Base.h"
+
+/**
+ * A hash of an image index within a Hamming distance of a query.
+ */
+struct ImageHashMatch {
+  /**
+   * The entry of the hash, that is, its position in the order the hashes
+   * were added to the index, starting from 0.
+   */
+  UInt32 entry;
+  /**
+   * The number of bits in which the hash differs from the query.
+   */
+  Int32 distance;
+};
+
+/**
+ * An index of 64-bit hashes, such as ``ImagePerceptualHash64()``, that finds
+ * all hashes within a Hamming distance of a query without comparing it to
+ * each of them.
+ *
+ * The index uses multi-index hashing (Norouzi, Punjani and Fleet): the hashes
+ * are split into `m` substrings of about `64 / m` bits, and for each
+ * substring, the entries are kept sorted by its value with a directory of
+ * where each value starts. Two hashes within distance `r` agree within
+ * distance `r / m` on at least one substring, so a query only visits the
+ * entries whose substrings are that close to its own, and verifies each with
+ * a population count. `m` is chosen so that a substring has about as many
+ * bits as the logarithm of the number of hashes, from 4 to 8 substrings.
+ *
+ * Hashes added to a built index wait in a short list that is scanned
+ * linearly, and are merged into the substring tables when it grows long.
+ *
+ * The whole index lives in one buffer that is position-independent and
+ * aligned, so a server can build it, send it with
+ * ``ImageHashIndexGetBytes()``, and a client can search it in place with
+ * ``ImageHashIndexCreateWithBytes()``. All integers are little-endian, as in
+ * WebAssembly memory:
+ *
+ * | Offset         | Size             | Contents                             |
+ * |----------------|------------------|--------------------------------------|
+ * | 0              | 7                | `"HASHIDX"` in ASCII                 |
+ * | 7              | 1                | Version, `1`                         |
+ * | 8              | 4                | Number of hashes `n`                 |
+ * | 12             | 4                | Number of substrings `m`             |
+ * | 16             | 8 * n            | Hashes, in entry order               |
+ * | 16 + 8 * n     | 4 * n * m        | For each substring, the entries      |
+ * |                |                  | sorted by its value                  |
+ * | 16 + 8 * n     | 4 * (2^b + 1)    | For each substring of `b` bits, the  |
+ * | + 4 * n * m    | for each         | position of the first entry with     |
+ * |                |                  | each value, followed by `n`          |
+ *
+ * Substring `i` holds `64 / m + 1` bits if `i < 64 % m`, and `64 / m` bits
+ * otherwise, starting from the least significant bits.
+ *
+ * Searches may run concurrently, but not with ``ImageHashIndexInsert()``
+ * or ``ImageHashIndexGetBytes()``.
+ */
+struct ImageHashIndex;
+
+/**
+ * Creates an index of hashes.
+ *
+ * - Parameters:
+ *   - hashes: The hashes to index, which become entries 0 to `count - 1`.
+ *   - count: The number of hashes, possibly 0.
+ *
+ * - Returns: A new index, or `NULL` if `count` is out of range or the memory
+ *   could not be allocated. Release it with ``ImageHashIndexDestroy()``.
+ */
+struct ImageHashIndex* ImageHashIndexCreate(const UInt64* hashes,
+                                            Int64 count);
+
+/**
+ * Creates an index that searches a buffer of ``ImageHashIndexGetBytes()``
+ * in place.
+ *
+ * The buffer is checked to be an index whose entries and directories stay
+ * within it, but it is neither copied nor modified, and must outlive the
+ * index. Inserting into the index moves it to a buffer of its own.
+ *
+ * - Parameters:
+ *   - bytes: The buffer of an index, aligned to 8 bytes.
+ *   - count: The number of bytes in the buffer.
+ *
+ * - Returns: A new index, or `NULL` if the buffer is not an index of a
+ *   supported version or the memory could not be allocated. Release it with
+ *   ``ImageHashIndexDestroy()``.
+ */
+struct ImageHashIndex* ImageHashIndexCreateWithBytes(const UInt8* bytes,
+                                                     Int64 count);
+
+/**
+ * Adds a hash to an index.
+ *
+ * - Parameters:
+ *   - index: An index.
+ *   - hash: The hash to add.
+ *
+ * - Returns: The entry of the hash, or -1 if the memory could not be
+ *   allocated, in which case the index is left untouched.
+ */
+Int64 ImageHashIndexInsert(struct ImageHashIndex* index, UInt64 hash);
+
+/**
+ * Returns the number of hashes in an index.
+ *
+ * - Parameter index: An index.
+ *
+ * - Returns: The number of hashes, which is also the next entry.
+ */
+Int64 ImageHashIndexGetCount(const struct ImageHashIndex* index);
+
+/**
+ * Finds the hashes within a Hamming distance of a query.
+ *
+ * - Parameters:
+ *   - index: An index.
+ *   - hash: The query.
+ *   - distance: The largest number of bits in which a match may differ from
+ *               the query. Searches are fastest for distances below the
+ *               number of substrings, and fall back to a linear scan when
+ *               that is cheaper.
+ *   - matches: A buffer to store up to `capacity` matches, in no particular
+ *              order.
+ *   - capacity: The number of matches `matches` can hold.
+ *
+ * - Returns: The number of matches, which may exceed `capacity`; search
+ *   again with a larger buffer to get them all.
+ */
+Int64 ImageHashIndexSearch(const struct ImageHashIndex* index,
+                           UInt64 hash,
+                           Int32 distance,
+                           struct ImageHashMatch* matches,
+                           Int64 capacity);
+
+/**
+ * Returns the buffer of an index, in the format described in
+ * ``ImageHashIndex``.
+ *
+ * Hashes still waiting to be merged are merged first.
+ *
+ * - Parameters:
+ *   - index: An index.
+ *   - count: On return, the number of bytes in the buffer, or 0 if the
+ *            pending hashes could not be merged.
+ *
+ * - Returns: The buffer, valid until the next insertion or until the index is
+ *   destroyed, or `NULL` if the pending hashes could not be merged.
+ */
+const UInt8* ImageHashIndexGetBytes(struct ImageHashIndex* index,
+                                    Int64* count);
+
+/**
+ * Destroys an index.
+ *
+ * - Parameter index: An index, or `NULL`.
+ */
+void ImageHashIndexDestroy(struct ImageHashIndex* index);
+
+#endif /* ImageHashIndex_h */
@@ -0,0 +1,311 @@
+//
+//  TaskPool.c
+//  core-cloud-wasm
+//
+//  Created by Fang Ling on 2026/10/17.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#include "TaskPool_Private.h"
+
+/*
+ * Native builds have POSIX threads; WebAssembly builds only when compiled
+ * with `-pthread`, which defines `_REENTRANT`.
+ */
+#if defined(TASK_POOL_SERIAL)
+#elif defined(__wasm__)
+#if defined(_REENTRANT)
+#define TASK_POOL_THREADS 1
+#endif
+#elif !defined(_WIN32)
+#define TASK_POOL_THREADS 1
+#endif
+
+#if defined(TASK_POOL_THREADS)
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+
+/*
+ * The tasks of a call are split into one range per thread.  A thread takes
+ * tasks one by one from the front of its own range, and once it is empty,
+ * steals the back half of another thread's range into its own.  Both update
+ * the range with a single compare-and-swap of `first << 32 | last`, so
+ * nothing ever waits for another thread to make progress.
+ *
+ * Idle workers sleep on a condition variable until the next call.  A call is
+ * open while its caller is running tasks: workers join it by counting
+ * themselves in `STATE`, and the caller closes it and waits for the count to
+ * drop to zero, so a worker that wakes up late never sees a stale call.
+ */
+
+/* The stack of each worker; tasks keep at most a few contexts on it. */
+#define TaskPoolStackSize (256 * 1024)
+
+/* The bit of `STATE` set while a call is open; the rest count workers. */
+#define TaskPoolOpen 0x80000000u
+
+/* A range of tasks, alone on its cache line. */
+struct TaskPoolRange {
+  _Alignas(64) _Atomic UInt64 range;
+};
+
+static pthread_mutex_t MUTEX = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t CONDITION = PTHREAD_COND_INITIALIZER;
+static pthread_t THREADS[TaskPoolMaximumThreadCount];
+/* Guarded by `MUTEX` */
+static UInt64 GENERATION = 0;
+static Bool STOPPING = false;
+
+/* Held by the call using the pool, and by `TaskPoolStart/Stop()`. */
+static atomic_flag LOCK = ATOMIC_FLAG_INIT;
+static _Atomic Int32 THREAD_COUNT = 1;
+
+/* The current call */
+static void* CONTEXT;
+static void (*TASK)(void* context, Int64 index);
+static _Atomic UInt32 STATE = 0;
+static struct TaskPoolRange RANGES[TaskPoolMaximumThreadCount];
+
+/* MARK: - Ranges */
+/* Takes the first task of range `p`, or returns -1 if it is empty. */
+static Int64 TaskPoolTake(Int32 p) {
+  UInt64 range = atomic_load(&RANGES[p].range);
+
+  while (true) {
+    UInt64 first = range >> 32;
+    UInt64 last = range & 0xFFFFFFFF;
+    if (first >= last) {
+      return -1;
+    }
+    if (
+      atomic_compare_exchange_weak(
+        &RANGES[p].range,
+        &range,
+        (first + 1) << 32 | last
+      )
+    ) {
+      return (Int64)first;
+    }
+  }
+}
+
+/*
+ * Moves the back half of another range into the empty range `p`.  Returns
+ * `false` if every other range is empty.
+ */
+static Bool TaskPoolSteal(Int32 p, Int32 threadCount) {
+  for (Int32 i = 1; i < threadCount; i += 1) {
+    Int32 victim = (p + i) % threadCount;
+    UInt64 range = atomic_load(&RANGES[victim].range);
+
+    while (true) {
+      UInt64 first = range >> 32;
+      UInt64 last = range & 0xFFFFFFFF;
+      if (first >= last) {
+        break;
+      }
+      UInt64 middle = first + (last - first) / 2;
+      if (
+        atomic_compare_exchange_weak(
+          &RANGES[victim].range,
+          &range,
+          first << 32 | middle
+        )
+      ) {
+        atomic_store(&RANGES[p].range, middle << 32 | last);
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+/* Runs tasks as thread `p` until every range is empty. */
+static void TaskPoolRun(Int32 p, Int32 threadCount) {
+  do {
+    for (Int64 i = TaskPoolTake(p); i >= 0; i = TaskPoolTake(p)) {
+      TASK(CONTEXT, i);
+    }
+  } while (TaskPoolSteal(p, threadCount));
+}
+
+/* MARK: - Workers */
+static void* TaskPoolWork(void* argument) {
+  Int32 p = (Int32)(intptr_t)argument;
+  UInt64 generation = 0;
+
+  while (true) {
+    pthread_mutex_lock(&MUTEX);
+    while (GENERATION == generation && !STOPPING) {
+      pthread_cond_wait(&CONDITION, &MUTEX);
+    }
+    generation = GENERATION;
+    Bool stopping = STOPPING;
+    pthread_mutex_unlock(&MUTEX);
+
+    if (stopping) {
+      return NULL;
+    }
+
+    /* Join the call if it is still open. */
+    UInt32 state = atomic_load(&STATE);
+    while (
+      (state & TaskPoolOpen) != 0 &&
+      !atomic_compare_exchange_weak(&STATE, &state, state + 1)
+    ) {}
+    if ((state & TaskPoolOpen) == 0) {
+      continue;
+    }
+
+    TaskPoolRun(p, atomic_load(&THREAD_COUNT));
+    atomic_fetch_sub(&STATE, 1);
+  }
+}
+
+Bool TaskPoolStart(Int32 threadCount) {
+  pthread_attr_t attributes;
+  Int32 started = 1;
+
+  if (threadCount < 1 || threadCount > TaskPoolMaximumThreadCount) {
+    return false;
+  }
+
+  while (atomic_flag_test_and_set(&LOCK)) {
+    sched_yield();
+  }
+  if (atomic_load(&THREAD_COUNT) > 1) {
+    atomic_flag_clear(&LOCK);
+    return false;
+  }
+
+  pthread_mutex_lock(&MUTEX);
+  STOPPING = false;
+  pthread_mutex_unlock(&MUTEX);
+
+  if (pthread_attr_init(&attributes) == 0) {
+    pthread_attr_setstacksize(&attributes, TaskPoolStackSize);
+    for (; started < threadCount; started += 1) {
+      if (
+        pthread_create(
+          &THREADS[started],
+          &attributes,
+          TaskPoolWork,
+          (void*)(intptr_t)started
+        ) != 0
+      ) {
+        break;
+      }
+    }
+    pthread_attr_destroy(&attributes);
+  }
+
+  atomic_store(&THREAD_COUNT, started);
+  atomic_flag_clear(&LOCK);
+
+  if (started < threadCount) {
+    TaskPoolStop();
+    return false;
+  }
+  return true;
+}
+
+void TaskPoolStop(void) {
+  while (atomic_flag_test_and_set(&LOCK)) {
+    sched_yield();
+  }
+
+  Int32 threadCount = atomic_load(&THREAD_COUNT);
+  if (threadCount > 1) {
+    pthread_mutex_lock(&MUTEX);
+    STOPPING = true;
+    pthread_cond_broadcast(&CONDITION);
+    pthread_mutex_unlock(&MUTEX);
+
+    for (Int32 i = 1; i < threadCount; i += 1) {
+      pthread_join(THREADS[i], NULL);
+    }
+    atomic_store(&THREAD_COUNT, 1);
+  }
+
+  atomic_flag_clear(&LOCK);
+}
+
+Int32 TaskPoolGetThreadCount(void) {
+  return atomic_load(&THREAD_COUNT);
+}
+
+void TaskPoolApply(Int64 count,
+                   void* context,
+                   void (*task)(void* context, Int64 index)) {
+  Int32 threadCount = atomic_load(&THREAD_COUNT);
+
+  if (
+    threadCount == 1 ||
+    count <= 1 ||
+    count > UINT32_MAX ||
+    atomic_flag_test_and_set(&LOCK)
+  ) {
+    for (Int64 i = 0; i < count; i += 1) {
+      task(context, i);
+    }
+    return;
+  }
+
+  /* 1. Split the tasks evenly and open the call. */
+  threadCount = atomic_load(&THREAD_COUNT);
+  CONTEXT = context;
+  TASK = task;
+  for (Int32 p = 0; p < threadCount; p += 1) {
+    UInt64 first = (UInt64)count * p / threadCount;
+    UInt64 last = (UInt64)count * (p + 1) / threadCount;
+    atomic_store(&RANGES[p].range, first << 32 | last);
+  }
+  atomic_store(&STATE, TaskPoolOpen);
+
+  pthread_mutex_lock(&MUTEX);
+  GENERATION += 1;
+  pthread_cond_broadcast(&CONDITION);
+  pthread_mutex_unlock(&MUTEX);
+
+  /* 2. Run tasks alongside the workers. */
+  TaskPoolRun(0, threadCount);
+
+  /* 3. Close the call, and wait for the workers that joined it. */
+  atomic_fetch_and(&STATE, ~TaskPoolOpen);
+  while (atomic_load(&STATE) != 0) {
+    sched_yield();
+  }
+
+  atomic_flag_clear(&LOCK);
+}
+#else
+Bool TaskPoolStart(Int32 threadCount) {
+  return threadCount == 1;
+}
+
+void TaskPoolStop(void) {}
+
+Int32 TaskPoolGetThreadCount(void) {
+  return 1;
+}
+
+void TaskPoolApply(Int64 count,
+                   void* context,
+                   void (*task)(void* context, Int64 index)) {
+  for (Int64 i = 0; i < count; i += 1) {
+    task(context, i);
+  }
+}
+#endif
@@ -0,0 +1,84 @@
+//
+//  TaskPool.h
+//  core-cloud-wasm
+//
+//  Created by Fang Ling on 2026/10/17.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#ifndef TaskPool_h
+#define TaskPool_h
+
+#include "Base.h"
+
+/**
+ * The largest number of threads of the task pool, including the caller.
+ */
+#define TaskPoolMaximumThreadCount 64
+
+/*
+ * The task pool spreads the bulk entry points of the library over several
+ * threads:
+ *
+ * - ``Crypto_SHA512Tree_HashLeaves()``, four leaves per task;
+ * - ``Crypto_SHA512xN_Hash()``, 256 messages per task;
+ * - ``Crypto_PBKDF2_SHA512()``, four output blocks per task;
+ * - ``DSPDCT32ExecuteBatch()``, 256 transforms per task.
+ *
+ * Every task writes its own part of the output with the same kernels as a
+ * single thread, so the results are identical whatever the number of
+ * threads. Until the pool is started, and in builds without threads, the
+ * entry points run on the calling thread.
+ *
+ * Native builds use POSIX threads. WebAssembly builds use threads only when
+ * compiled with `-pthread`, which needs shared memory and atomics; with
+ * Emscripten, link with `-sPTHREAD_POOL_SIZE` so that the workers exist
+ * before the pool starts. Define `TASK_POOL_SERIAL` to build without
+ * threads.
+ *
+ * The calling thread takes part in every call, and one call at a time uses
+ * the pool: a call made while it is busy, such as from another thread, runs
+ * on its own thread.
+ */
+
+/**
+ * Starts the task pool.
+ *
+ * - Parameter threadCount: The number of threads to use, including the
+ *   calling thread, between 1 and ``TaskPoolMaximumThreadCount``, such as the
+ *   number of cores. 1 runs everything on the calling thread.
+ *
+ * - Returns: `true` if the pool was started; `false` if it is already
+ *   running, `threadCount` is out of range, or more than one thread was
+ *   asked for and the build has no threads or they could not be created.
+ */
+Bool TaskPoolStart(Int32 threadCount);
+
+/**
+ * Stops the task pool and waits for its threads to exit.
+ *
+ * Afterwards, the entry points run on the calling thread until the pool is
+ * started again. Does nothing if the pool is not running.
+ */
+void TaskPoolStop(void);
+
+/**
+ * Returns the number of threads of the task pool, including the calling
+ * thread.
+ *
+ * - Returns: The number of threads, or 1 if the pool is not running.
+ */
+Int32 TaskPoolGetThreadCount(void);
+
+#endif /* TaskPool_h */
@@ -0,0 +1,36 @@
+//
+//  TaskPool_Private.h
+//  core-cloud-wasm
+//
+//  Created by Fang Ling on 2026/10/17.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#ifndef TaskPool_Private_h
+#define TaskPool_Private_h
+
+#include "TaskPool.h"
+
+/*
+ * Runs `task(context, i)` for every `i` in `0 ..< count`, spread over the
+ * threads of the pool, and returns when all of them are done.  The tasks run
+ * in no particular order, and each must write only its own part of the
+ * output.  Runs them in order on the calling thread if the pool is not
+ * running or busy, for example when called from within a task.
+ */
+void TaskPoolApply(Int64 count,
+                   void* context,
+                   void (*task)(void* context, Int64 index));
+
+#endif /* TaskPool_Private_h */
@@ -22,5 +22,23 @@
 
 #include "../DSP.h"
 #include "../Crypto_SHA512.h"
+#include "../Crypto_SHA512Tree.h"
+#include "../Crypto_AESGCM.h"
+#include "../Crypto_HMAC.h"
+#include "../ImageHash.h"
+#include "../ImageHashIndex.h"
+#include "../AudioAnalysis.h"
+#include "../AudioFingerprint.h"
+#include "../TaskPool.h"
+
+/**
+ * Precomputes the tables that the library otherwise computes each time it
+ * needs them, such as the twiddle factors of ``DSPDCTCreateSetup()``.
+ *
+ * Call it once after loading the library, e.g. right after instantiating the
+ * WebAssembly module. Calling it again, or from several threads, is
+ * harmless. Results are the same with or without it.
+ */
+void CoreCloudWasm_Initialize(void);
 
 #endif /* CoreCloudWasm_h */
@@ -0,0 +1,535 @@
+//
+//  CoreCloudWasmBenchmarks.swift
+//  core-cloud-wasm
+//
+//  Created by Fang Ling on 2026/10/17.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import CoreCloudWasm
+import Foundation
+
+/* MARK: - Report */
+
+struct BenchmarkResult: Codable {
+  var name: String
+  /* The fastest of several samples */
+  var nanosecondsPerCall: Double
+  var cyclesPerByte: Double?
+  var gigabytesPerSecond: Double?
+  var gigaflopsPerSecond: Double?
+  /* How many times faster it is than the benchmark it replaces */
+  var speedup: Double?
+  /* Seconds of audio processed per second of CPU time */
+  var realTimeFactor: Double?
+}
+
+struct Report: Codable {
+  /* The clock cycles per byte are estimated from it, in GHz */
+  var cpuFrequency: Double?
+  var results: [BenchmarkResult]
+}
+
+/* MARK: - Measuring */
+
+/* A deterministic generator, so that every run sees the same data */
+struct Xorshift: RandomNumberGenerator {
+  var state: UInt64 = 0x9E37_79B9_7F4A_7C15
+
+  mutating func next() -> UInt64 {
+    state ^= state << 13
+    state ^= state >> 7
+    state ^= state << 17
+    return state
+  }
+}
+
+final class Suite {
+  let filter: String?
+  let cpuFrequency: Double?
+  var results = [BenchmarkResult]()
+  var generator = Xorshift()
+
+  /* Each sample runs for at least this long */
+  let sampleDuration = 0.005
+  let sampleCount = 9
+
+  init(filter: String?, cpuFrequency: Double?) {
+    self.filter = filter
+    self.cpuFrequency = cpuFrequency
+  }
+
+  func buffer<T: BinaryFloatingPoint>(
+    _ count: Int,
+    of type: T.Type,
+    in range: ClosedRange<T> = -1 ... 1
+  ) -> UnsafeMutablePointer<T> where T.RawSignificand: FixedWidthInteger {
+    let buffer = UnsafeMutablePointer<T>.allocate(capacity: count)
+    for i in 0 ..< count {
+      buffer[i] = T.random(in: range, using: &generator)
+    }
+    return buffer
+  }
+
+  func buffer<T: FixedWidthInteger>(
+    _ count: Int,
+    of type: T.Type
+  ) -> UnsafeMutablePointer<T> {
+    let buffer = UnsafeMutablePointer<T>.allocate(capacity: count)
+    for i in 0 ..< count {
+      buffer[i] = T.random(in: .min ... .max, using: &generator)
+    }
+    return buffer
+  }
+
+  private func seconds(_ iterations: Int, _ body: () -> Void) -> Double {
+    let start = DispatchTime.now().uptimeNanoseconds
+    for _ in 0 ..< iterations {
+      body()
+    }
+    return Double(DispatchTime.now().uptimeNanoseconds - start) * 1e-9
+  }
+
+  /*
+   * Runs `body` in samples of enough calls to be timed reliably, and keeps
+   * the fastest sample: noise only ever makes a kernel slower.
+   */
+  func measure(
+    _ name: String,
+    bytes: Int = 0,
+    flops: Int = 0,
+    duration: Double = 0,
+    _ body: () -> Void
+  ) {
+    if let filter, !name.contains(filter) {
+      return
+    }
+
+    var iterations = 1
+    while seconds(iterations, body) < sampleDuration {
+      iterations *= 2
+    }
+    var best = Double.infinity
+    for _ in 0 ..< sampleCount {
+      best = min(best, seconds(iterations, body) / Double(iterations))
+    }
+
+    var result = BenchmarkResult(name: name, nanosecondsPerCall: best * 1e9)
+    if bytes > 0 {
+      result.gigabytesPerSecond = Double(bytes) / best * 1e-9
+      if let cpuFrequency {
+        result.cyclesPerByte = best * cpuFrequency * 1e9 / Double(bytes)
+      }
+    }
+    if flops > 0 {
+      result.gigaflopsPerSecond = Double(flops) / best * 1e-9
+    }
+    if duration > 0 {
+      result.realTimeFactor = duration / best
+    }
+    results.append(result)
+    progress(name, String(format: "%12.1f ns", result.nanosecondsPerCall))
+  }
+
+  /* Records how much faster `name` ran than `baseline`, if both did */
+  func speedup(of name: String, over baseline: String) {
+    guard
+      let index = results.firstIndex(where: { $0.name == name }),
+      let old = results.first(where: { $0.name == baseline })
+    else {
+      return
+    }
+    let speedup = old.nanosecondsPerCall / results[index].nanosecondsPerCall
+    results[index].speedup = speedup
+    progress(name, String(format: "%11.2fx", speedup))
+  }
+}
+
+/* Prints a line of progress, leaving standard output to the report */
+func progress(_ name: String, _ value: String) {
+  let line = name.padding(toLength: 44, withPad: " ", startingAt: 0) + value
+  FileHandle.standardError.write(Data("\(line)\n".utf8))
+}
+
+/* The nominal number of operations of a real transform, as benchFFT counts */
+func transformFlops(_ count: Int) -> Int {
+  5 * count * count.trailingZeroBitCount / 2
+}
+
+/* MARK: - Benchmarks */
+
+func benchmarkCrypto(_ suite: Suite) {
+  for count in [64, 1_024, 16_384, 1_048_576] {
+    let buffer = suite.buffer(count, of: UInt8.self)
+    let context = Crypto_SHA512_Create()!
+    suite.measure("Crypto_SHA512_Update/\(count)", bytes: count, {
+      Crypto_SHA512_Update(context, buffer, Int64(count))
+    })
+    Crypto_SHA512_Destroy(context)
+    buffer.deallocate()
+  }
+
+  let treeCount = 4 * Int(Crypto_SHA512Tree_LeafSize)
+  let tree = suite.buffer(treeCount, of: UInt8.self)
+  let leaves = suite.buffer(4 * 64, of: UInt8.self)
+  suite.measure("Crypto_SHA512Tree_HashLeaves/\(treeCount)", bytes: treeCount, {
+    Crypto_SHA512Tree_HashLeaves(tree, Int64(treeCount), leaves)
+  })
+  tree.deallocate()
+  leaves.deallocate()
+
+  /* Enough leaves to keep eight threads of the task pool busy */
+  let poolCount = 32 * Int(Crypto_SHA512Tree_LeafSize)
+  let threadCount = min(
+    ProcessInfo.processInfo.activeProcessorCount,
+    Int(TaskPoolMaximumThreadCount)
+  )
+  if TaskPoolStart(Int32(threadCount)) {
+    let pool = suite.buffer(poolCount, of: UInt8.self)
+    let poolLeaves = suite.buffer(32 * 64, of: UInt8.self)
+    suite.measure(
+      "Crypto_SHA512Tree_HashLeaves/\(poolCount)/pool",
+      bytes: poolCount,
+      {
+        Crypto_SHA512Tree_HashLeaves(pool, Int64(poolCount), poolLeaves)
+      }
+    )
+    TaskPoolStop()
+    pool.deallocate()
+    poolLeaves.deallocate()
+  }
+
+  let key = suite.buffer(32, of: UInt8.self)
+  let nonce = suite.buffer(Int(Crypto_AESGCM_NonceSize), of: UInt8.self)
+  for count in [1_024, 65_536] {
+    let plaintext = suite.buffer(count, of: UInt8.self)
+    let combined = suite.buffer(count + 28, of: UInt8.self)
+    suite.measure("Crypto_AESGCM_Seal/\(count)", bytes: count, {
+      Crypto_AESGCM_Seal(key, nonce, plaintext, Int64(count), nil, 0, combined)
+    })
+    plaintext.deallocate()
+    combined.deallocate()
+  }
+
+  let message = suite.buffer(1_024, of: UInt8.self)
+  let code = suite.buffer(64, of: UInt8.self)
+  suite.measure("Crypto_HMAC_SHA512/1024", bytes: 1_024, {
+    Crypto_HMAC_SHA512(key, 32, message, 1_024, code)
+  })
+  key.deallocate()
+  nonce.deallocate()
+  message.deallocate()
+  code.deallocate()
+}
+
+func benchmarkDSP(_ suite: Suite) {
+  let input = suite.buffer(32 * 1_024, of: Float32.self)
+  let output = suite.buffer(32 * 1_024, of: Float32.self)
+  defer {
+    input.deallocate()
+    output.deallocate()
+  }
+
+  suite.measure("DSPDCT32Execute", flops: transformFlops(32), {
+    DSPDCT32Execute(input, output)
+  })
+  /* The batch against the same transforms one at a time */
+  suite.measure(
+    "DSPDCT32Execute/1024/loop",
+    flops: 1_024 * transformFlops(32),
+    {
+      for i in 0 ..< 1_024 {
+        DSPDCT32Execute(input + 32 * i, output + 32 * i)
+      }
+    }
+  )
+  suite.measure(
+    "DSPDCT32ExecuteBatch/1024",
+    flops: 1_024 * transformFlops(32),
+    {
+      DSPDCT32ExecuteBatch(input, output, 1_024, 1_024)
+    }
+  )
+  suite.speedup(
+    of: "DSPDCT32ExecuteBatch/1024",
+    over: "DSPDCT32Execute/1024/loop"
+  )
+  suite.measure("DSPDCT2D32x32", flops: 64 * transformFlops(32), {
+    DSPDCT2D32x32(input, output)
+  })
+
+  let types = [
+    ("II", DSPDCTTypeII),
+    ("III", DSPDCTTypeIII),
+    ("IV", DSPDCTTypeIV)
+  ]
+  for (name, type) in types {
+    for count in [256, 4_096] {
+      let setup = DSPDCTCreateSetup(Int32(count), type)!
+      suite.measure(
+        "DSPDCTExecute/\(name)/\(count)",
+        flops: transformFlops(count),
+        {
+          DSPDCTExecute(setup, input, output)
+        }
+      )
+      DSPDCTDestroySetup(setup)
+    }
+  }
+
+  /* Every element is read and written once */
+  suite.measure("DSPMatrixTranspose32x32", bytes: 2 * 32 * 32 * 4, {
+    DSPMatrixTranspose32x32(input, output)
+  })
+  suite.measure("DSPMatrixTranspose/128x256", bytes: 2 * 128 * 256 * 4, {
+    DSPMatrixTranspose(input, 128, 256, 256, output, 128)
+  })
+  suite.measure("DSPMatrixTransposeInPlace/128", bytes: 2 * 128 * 128 * 4, {
+    DSPMatrixTransposeInPlace(output, 128, 128)
+  })
+
+  /* A typical block: a few low frequencies and sparse high ones */
+  let coefficients = UnsafeMutablePointer<Int16>.allocate(capacity: 64)
+  let quantization = UnsafeMutablePointer<UInt16>.allocate(capacity: 64)
+  let multipliers = UnsafeMutablePointer<Float32>.allocate(capacity: 64)
+  let samples = UnsafeMutablePointer<UInt8>.allocate(capacity: 64)
+  for i in 0 ..< 64 {
+    quantization[i] = UInt16(2 + i / 4)
+    coefficients[i] = i < 10 || i % 9 == 0
+      ? Int16.random(in: -32 ... 32, using: &suite.generator)
+      : 0
+  }
+  DSPIDCTPrepareFloat(quantization, multipliers)
+  suite.measure("DSPIDCT8x8", {
+    DSPIDCT8x8(coefficients, quantization, samples, 8)
+  })
+  suite.measure("DSPIDCT8x8Float", {
+    DSPIDCT8x8Float(coefficients, multipliers, samples, 8)
+  })
+  suite.measure("DSPIDCT4x4", {
+    DSPIDCT4x4(coefficients, quantization, samples, 4)
+  })
+  coefficients.deallocate()
+  quantization.deallocate()
+  multipliers.deallocate()
+  samples.deallocate()
+
+  /* One MPEG audio frame of 1152 samples, 26 ms at 44.1 kHz */
+  let synthesis = DSPPolyphaseCreateSynthesis()!
+  suite.measure(
+    "DSPPolyphaseSynthesize/36",
+    bytes: 1_152 * 4,
+    duration: 1_152 / 44_100,
+    {
+      DSPPolyphaseSynthesize(synthesis, input, output, 36)
+    }
+  )
+  DSPPolyphaseDestroySynthesis(synthesis)
+
+  let width = 1_920
+  let height = 1_080
+  let pixels = suite.buffer(width * height * 4, of: UInt8.self)
+  suite.measure(
+    "DSPImageReduceLuma32x32/\(width)x\(height)/RGBA8",
+    bytes: width * height * 4,
+    {
+      _ = DSPImageReduceLuma32x32(
+        pixels,
+        Int32(width),
+        Int32(height),
+        Int32(width * 4),
+        DSPImagePixelFormatRGBA8,
+        output
+      )
+    }
+  )
+  pixels.deallocate()
+}
+
+func benchmarkImage(_ suite: Suite) {
+  let luma = suite.buffer(1_024, of: Float32.self, in: 0 ... 255)
+  suite.measure("ImagePerceptualHash64", {
+    _ = ImagePerceptualHash64(luma)
+  })
+  luma.deallocate()
+
+  let count = 100_000
+  let hashes = suite.buffer(count, of: UInt64.self)
+  let index = ImageHashIndexCreate(hashes, Int64(count))!
+  let matches = UnsafeMutablePointer<ImageHashMatch>.allocate(capacity: 64)
+  for distance in [4, 8, 12] {
+    var query = 0
+    suite.measure("ImageHashIndexSearch/\(count)/\(distance)", {
+      _ = ImageHashIndexSearch(
+        index,
+        hashes[query],
+        Int32(distance),
+        matches,
+        64
+      )
+      query = (query + 1) % count
+    })
+  }
+  suite.measure("ImageHashIndexCreate/\(count)", bytes: count * 8, {
+    ImageHashIndexDestroy(ImageHashIndexCreate(hashes, Int64(count)))
+  })
+  ImageHashIndexDestroy(index)
+  matches.deallocate()
+  hashes.deallocate()
+}
+
+func benchmarkAudio(_ suite: Suite) {
+  /* One second of stereo audio at 48 kHz */
+  let frameCount = 48_000
+  let samples = suite.buffer(frameCount * 2, of: Float32.self)
+  defer {
+    samples.deallocate()
+  }
+
+  let analysis = AudioAnalysisCreate(48_000, 2, 1_024)!
+  suite.measure("AudioAnalysisUpdate/48000x2", bytes: frameCount * 2 * 4, {
+    AudioAnalysisUpdate(analysis, samples, Int64(frameCount))
+  })
+  AudioAnalysisDestroy(analysis)
+
+  /* A fingerprint stops once full, so every call starts a new one */
+  suite.measure("AudioFingerprintUpdate/48000x2", bytes: frameCount * 2 * 4, {
+    let fingerprint = AudioFingerprintCreate(48_000, 2, 1_024)!
+    _ = AudioFingerprintUpdate(fingerprint, samples, Int64(frameCount))
+    AudioFingerprintDestroy(fingerprint)
+  })
+}
+
+/* MARK: - Main */
+
+let usage = """
+  Usage:
+    CoreCloudWasmBenchmarks [--filter <TEXT>] [--ghz <FREQUENCY>]
+                            [--baseline <FILE>] [--tolerance <FRACTION>]
+
+  Runs every benchmark whose name contains TEXT, or all of them, and prints
+  a JSON report to standard output. Build with `-c release`.
+
+    --ghz        The CPU frequency to estimate clock cycles per byte from,
+                 by default the one in /proc/cpuinfo, if any.
+    --baseline   A report of an earlier run on the same machine to compare
+                 with. Exits with status 1 if a benchmark got slower by more
+                 than the tolerance.
+    --tolerance  The slowdown that counts as a regression, 0.1 by default.
+  """
+
+func fail(_ message: String) -> Never {
+  FileHandle.standardError.write(Data("\(message)\n\n\(usage)\n".utf8))
+  exit(2)
+}
+
+/* The current clock of the first processor, in GHz, on Linux */
+func cpuFrequency() -> Double? {
+  guard
+    let cpuinfo = try? String(contentsOfFile: "/proc/cpuinfo", encoding: .utf8),
+    let line = cpuinfo.split(separator: "\n").first(where: {
+      $0.hasPrefix("cpu MHz")
+    }),
+    let value = line.split(separator: ":").last,
+    let megahertz = Double(value.trimmingCharacters(in: .whitespaces))
+  else {
+    return nil
+  }
+  return megahertz / 1_000
+}
+
+/*
+ * Prints the change of every benchmark against the baseline, and returns
+ * whether none of them regressed.
+ */
+func compare(
+  _ report: Report,
+  with baseline: Report,
+  tolerance: Double
+) -> Bool {
+  var passed = true
+  FileHandle.standardError.write(Data("\nAgainst the baseline:\n".utf8))
+  for result in report.results {
+    guard
+      let old = baseline.results.first(where: { $0.name == result.name })
+    else {
+      progress(result.name, "         new")
+      continue
+    }
+    let change = result.nanosecondsPerCall / old.nanosecondsPerCall - 1
+    let regressed = change > tolerance
+    passed = passed && !regressed
+    progress(
+      result.name,
+      String(format: "%+11.1f%%", change * 100) +
+        (regressed ? "  REGRESSION" : "")
+    )
+  }
+  return passed
+}
+
+@main
+struct CoreCloudWasmBenchmarks {
+  static func main() throws {
+    var filter: String?
+    var frequency = cpuFrequency()
+    var baseline: Report?
+    var tolerance = 0.1
+
+    var arguments = CommandLine.arguments.dropFirst()
+    while let argument = arguments.popFirst() {
+      if argument == "--help" {
+        print(usage)
+        return
+      }
+      guard let value = arguments.popFirst() else {
+        fail("Missing value for \(argument)")
+      }
+      switch argument {
+      case "--filter":
+        filter = value
+      case "--ghz":
+        guard let ghz = Double(value), ghz > 0 else {
+          fail("Invalid frequency: \(value)")
+        }
+        frequency = ghz
+      case "--baseline":
+        let data = try Data(contentsOf: URL(fileURLWithPath: value))
+        baseline = try JSONDecoder().decode(Report.self, from: data)
+      case "--tolerance":
+        guard let fraction = Double(value), fraction >= 0 else {
+          fail("Invalid tolerance: \(value)")
+        }
+        tolerance = fraction
+      default:
+        fail("Unknown option: \(argument)")
+      }
+    }
+
+    let suite = Suite(filter: filter, cpuFrequency: frequency)
+    benchmarkCrypto(suite)
+    benchmarkDSP(suite)
+    benchmarkImage(suite)
+    benchmarkAudio(suite)
+
+    let report = Report(cpuFrequency: frequency, results: suite.results)
+    let encoder = JSONEncoder()
+    encoder.outputFormatting = [.prettyPrinted, .sortedKeys]
+    print(String(decoding: try encoder.encode(report), as: UTF8.self))
+
+    if let baseline, !compare(report, with: baseline, tolerance: tolerance) {
+      exit(1)
+    }
+  }
+}
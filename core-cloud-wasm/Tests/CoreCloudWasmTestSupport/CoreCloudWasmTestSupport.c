@@ -0,0 +1,65 @@
+//
+//  CoreCloudWasmTestSupport.c
+//  core-cloud-wasm
+//
+//  Created by Fang Ling on 2026/10/17.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#include "CoreCloudWasmTestSupport.h"
+
+void TestSupport_Float32x4_MultiplyAdd(const Float32* a,
+                                       const Float32* b,
+                                       const Float32* c,
+                                       Float32* result) {
+  Float32x4_Store(
+    result,
+    Float32x4_MultiplyAdd(
+      Float32x4_Load(a),
+      Float32x4_Load(b),
+      Float32x4_Load(c)
+    )
+  );
+}
+
+void TestSupport_Float32x4_Transpose4x4(Float32* matrix) {
+  Float32x4 rows[4];
+
+  for (Int32 i = 0; i < 4; i += 1) {
+    rows[i] = Float32x4_Load(matrix + i * 4);
+  }
+  Float32x4_Transpose4x4(rows);
+  for (Int32 i = 0; i < 4; i += 1) {
+    Float32x4_Store(matrix + i * 4, rows[i]);
+  }
+}
+
+void TestSupport_UInt8x16_Shuffle(const UInt8* x,
+                                  const UInt8* indices,
+                                  UInt8* result) {
+  UInt8x16_Store(
+    result,
+    UInt8x16_Shuffle(UInt8x16_Load(x), UInt8x16_Load(indices))
+  );
+}
+
+void TestSupport_UInt64x2_ByteSwap(const UInt64* x, UInt64* result) {
+  UInt64x2_Store(result, UInt64x2_ByteSwap(UInt64x2_Load(x)));
+}
+
+void TestSupport_UInt64x2_Span(const UInt64* a,
+                               const UInt64* b,
+                               UInt64* result) {
+  UInt64x2_Store(result, UInt64x2_Span(UInt64x2_Load(a), UInt64x2_Load(b)));
+}
@@ -0,0 +1,85 @@
+//
+//  CoreCloudWasmTestSupport.h
+//  core-cloud-wasm
+//
+//  Created by Fang Ling on 2026/10/17.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#ifndef CoreCloudWasmTestSupport_h
+#define CoreCloudWasmTestSupport_h
+
+#include "CoreCloudWasm.h"
+
+/*
+ * The vectors of Base.h are hidden from Swift, so the tests reach their
+ * lane-wise operations through these wrappers, which take and return the
+ * lanes as arrays.
+ */
+
+/**
+ * Computes ``Float32x4_MultiplyAdd()`` of four lanes.
+ *
+ * - Parameters:
+ *   - a: The four lanes of the first factor.
+ *   - b: The four lanes of the second factor.
+ *   - c: The four lanes of the addend.
+ *   - result: A buffer to store the four lanes of `a * b + c`.
+ */
+void TestSupport_Float32x4_MultiplyAdd(const Float32* a,
+                                       const Float32* b,
+                                       const Float32* c,
+                                       Float32* result);
+
+/**
+ * Transposes a 4x4 matrix with ``Float32x4_Transpose4x4()``.
+ *
+ * - Parameter matrix: The 16 values of the matrix, row by row.
+ */
+void TestSupport_Float32x4_Transpose4x4(Float32* matrix);
+
+/**
+ * Picks sixteen lanes with ``UInt8x16_Shuffle()``.
+ *
+ * - Parameters:
+ *   - x: The sixteen lanes to pick from.
+ *   - indices: The sixteen indices, between 0 and 15.
+ *   - result: A buffer to store the sixteen picked lanes.
+ */
+void TestSupport_UInt8x16_Shuffle(const UInt8* x,
+                                  const UInt8* indices,
+                                  UInt8* result);
+
+/**
+ * Reverses the bytes of two lanes with ``UInt64x2_ByteSwap()``.
+ *
+ * - Parameters:
+ *   - x: The two lanes.
+ *   - result: A buffer to store the two swapped lanes.
+ */
+void TestSupport_UInt64x2_ByteSwap(const UInt64* x, UInt64* result);
+
+/**
+ * Returns the pair straddling two vectors with ``UInt64x2_Span()``.
+ *
+ * - Parameters:
+ *   - a: The two lanes of the first vector.
+ *   - b: The two lanes of the second vector.
+ *   - result: A buffer to store lane 1 of `a` and lane 0 of `b`.
+ */
+void TestSupport_UInt64x2_Span(const UInt64* a,
+                               const UInt64* b,
+                               UInt64* result);
+
+#endif /* CoreCloudWasmTestSupport_h */
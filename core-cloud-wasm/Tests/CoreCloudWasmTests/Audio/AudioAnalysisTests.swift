@@ -0,0 +1,177 @@
+//
+//  AudioAnalysisTests.swift
+//  core-cloud-wasm
+//
+//  Created by Fang Ling on 2026/10/17.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import CoreCloudWasm
+import Foundation
+import Testing
+
+/* Sine sections of (level in dBFS, seconds), the same on every channel */
+private func sine(
+  _ sections: [(Double, Double)],
+  frequency: Double = 1_000,
+  phase: Double = 0,
+  sampleRate: Int = 48_000,
+  channelCount: Int = 2
+) -> [Float32] {
+  var samples = [Float32]()
+  var n = 0
+  for (level, seconds) in sections {
+    let amplitude = pow(10, level / 20)
+    for _ in 0 ..< Int(seconds * Double(sampleRate)) {
+      let t = Double(n) / Double(sampleRate)
+      let x = Float32(amplitude * sin(2 * .pi * frequency * t + phase))
+      samples.append(contentsOf: repeatElement(x, count: channelCount))
+      n += 1
+    }
+  }
+  return samples
+}
+
+private func analyze(
+  _ samples: [Float32],
+  sampleRate: Int = 48_000,
+  channelCount: Int = 2,
+  bucketCount: Int = 1_024
+) -> OpaquePointer {
+  let analysis = AudioAnalysisCreate(
+    Int32(sampleRate),
+    Int32(channelCount),
+    Int32(bucketCount)
+  )!
+
+  /* In uneven chunks, as a decoder would deliver them */
+  samples.withUnsafeBufferPointer({ samples in
+    var frame = 0
+    let frameCount = samples.count / channelCount
+    while frame < frameCount {
+      let count = min(777 + frame % 1_000, frameCount - frame)
+      AudioAnalysisUpdate(
+        analysis,
+        samples.baseAddress! + frame * channelCount,
+        Int64(count)
+      )
+      frame += count
+    }
+  })
+  return analysis
+}
+
+private func loudness(
+  _ samples: [Float32],
+  sampleRate: Int = 48_000,
+  channelCount: Int = 2
+) -> AudioLoudness {
+  let analysis = analyze(
+    samples,
+    sampleRate: sampleRate,
+    channelCount: channelCount
+  )
+  defer {
+    AudioAnalysisDestroy(analysis)
+  }
+  var loudness = AudioLoudness()
+  AudioAnalysisGetLoudness(analysis, &loudness)
+  return loudness
+}
+
+/* After EBU Tech 3341, cases 1 to 4, with its tolerance of 0.1 LU */
+@Test
+func testAudioAnalysisLoudness() {
+  var result = loudness(sine([(-23, 20)]))
+  #expect(abs(result.integratedLoudness + 23) < 0.1)
+  #expect(abs(result.replayGain - 5) < 0.1)
+
+  result = loudness(sine([(-33, 20)], sampleRate: 44_100), sampleRate: 44_100)
+  #expect(abs(result.integratedLoudness + 33) < 0.1)
+
+  /* The quiet sections fall below the relative gate */
+  result = loudness(sine([(-36, 5), (-23, 20), (-36, 5)]))
+  #expect(abs(result.integratedLoudness + 23) < 0.1)
+
+  /* The silent sections fall below the absolute gate */
+  result = loudness(
+    sine([(-80, 10), (-23, 10)], channelCount: 1),
+    channelCount: 1
+  )
+  #expect(abs(result.integratedLoudness + 26.01) < 0.1)
+
+  result = loudness([Float32](repeating: 0, count: 96_000))
+  #expect(result.integratedLoudness == -.infinity)
+  #expect(result.replayGain == 0)
+}
+
+/* EBU Tech 3341, case 15: a sine at fs/4 sampled 45 degrees off its peaks */
+@Test
+func testAudioAnalysisTruePeak() {
+  let result = loudness(
+    sine([(0, 2)], frequency: 12_000, phase: .pi / 4, channelCount: 1),
+    channelCount: 1
+  )
+  #expect(abs(result.samplePeak - 0.7071) < 0.001)
+  let truePeak = 20 * log10(result.truePeak)
+  #expect(truePeak > -0.4 && truePeak < 0.2)
+}
+
+@Test
+func testAudioAnalysisPeaks() {
+  let frameCount = 123_457
+  let samples = (0 ..< frameCount * 2).map({ i in
+    Float32.random(in: -1 ... 1) * Float32(i % 5_000) / 5_000
+  })
+  let analysis = analyze(
+    samples,
+    sampleRate: 44_100,
+    bucketCount: 100
+  )
+  defer {
+    AudioAnalysisDestroy(analysis)
+  }
+
+  func quantize(_ x: Float32) -> Int8 {
+    Int8(min(max(x * 127, -127), 127).rounded(.toNearestOrEven))
+  }
+
+  for level in 0 ..< 3 {
+    var peaks = [Int8](repeating: 0, count: 200)
+    var bucketFrames: Int64 = 0
+    let count = Int(AudioAnalysisGetPeaks(
+      analysis,
+      Int32(level),
+      &peaks,
+      &bucketFrames
+    ))
+    let frames = Int(bucketFrames)
+    #expect(count == (frameCount + frames - 1) / frames)
+    #expect(count <= 100)
+
+    for bucket in 0 ..< count {
+      let end = min((bucket + 1) * frames, frameCount)
+      let range = bucket * frames * 2 ..< end * 2
+      #expect(peaks[bucket * 2] == quantize(samples[range].min()!))
+      #expect(peaks[bucket * 2 + 1] == quantize(samples[range].max()!))
+    }
+  }
+
+  /* No level below the finest */
+  var peaks = [Int8](repeating: 0, count: 200)
+  var bucketFrames: Int64 = -1
+  #expect(AudioAnalysisGetPeaks(analysis, -1, &peaks, &bucketFrames) == 0)
+  #expect(bucketFrames == 0)
+  #expect(AudioAnalysisGetPeaks(analysis, .min, &peaks, nil) == 0)
+}
@@ -0,0 +1,202 @@
+//
+//  AudioFingerprintTests.swift
+//  core-cloud-wasm
+//
+//  Created by Fang Ling on 2026/10/17.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import CoreCloudWasm
+import Foundation
+import Testing
+
+/* A tune of random notes, defined at any time so it renders at any rate */
+private struct Tune {
+  var notes: [(start: Double, frequency: Double)] = []
+
+  init<G: RandomNumberGenerator>(duration: Double, using generator: inout G) {
+    var start = 0.0
+    while start < duration {
+      let semitone = Double(Int.random(in: 0 ..< 36, using: &generator))
+      notes.append((start, 110 * pow(2, semitone / 12)))
+      start += Double.random(in: 0.1 ... 0.3, using: &generator)
+    }
+  }
+
+  func render(
+    sampleRate: Int,
+    duration: Double,
+    channelCount: Int = 1,
+    gain: Float32 = 1
+  ) -> [Float32] {
+    var samples = [Float32]()
+    var first = 0
+    for n in 0 ..< Int(duration * Double(sampleRate)) {
+      let t = Double(n) / Double(sampleRate)
+      while first < notes.count && notes[first].start + 1 < t {
+        first += 1
+      }
+      var x = 0.0
+      for note in notes[first...] where note.start <= t {
+        let u = t - note.start
+        for harmonic in 1 ... 4 {
+          let phase = 2 * .pi * note.frequency * Double(harmonic) * u
+          x += exp(-4 * u) * sin(phase) / Double(harmonic)
+        }
+      }
+      for _ in 0 ..< channelCount {
+        samples.append(Float32(x * 0.2) * gain)
+      }
+    }
+    return samples
+  }
+}
+
+private func fingerprint(
+  _ samples: [Float32],
+  sampleRate: Int,
+  channelCount: Int = 1
+) -> [UInt32] {
+  let fingerprint = AudioFingerprintCreate(
+    Int32(sampleRate),
+    Int32(channelCount),
+    100_000
+  )!
+  defer {
+    AudioFingerprintDestroy(fingerprint)
+  }
+
+  /* In uneven chunks, as a decoder would deliver them */
+  samples.withUnsafeBufferPointer({ samples in
+    var frame = 0
+    let frameCount = samples.count / channelCount
+    while frame < frameCount {
+      let count = min(1_000 + frame % 337, frameCount - frame)
+      #expect(
+        AudioFingerprintUpdate(
+          fingerprint,
+          samples.baseAddress! + frame * channelCount,
+          Int64(count)
+        )
+      )
+      frame += count
+    }
+  })
+
+  var count: Int32 = 0
+  let subfingerprints = AudioFingerprintGetSubfingerprints(fingerprint, &count)
+  return Array(UnsafeBufferPointer(start: subfingerprints, count: Int(count)))
+}
+
+@Test
+func testAudioFingerprint() {
+  var generator = SystemRandomNumberGenerator()
+  let tune = Tune(duration: 12, using: &generator)
+  let original = fingerprint(
+    tune.render(sampleRate: 44_100, duration: 10, channelCount: 2),
+    sampleRate: 44_100,
+    channelCount: 2
+  )
+  /* One per 64 samples at 5512.5 Hz, from the end of the first window */
+  #expect(original.count == (55_125 - 2_048) / 64)
+
+  /* Another sample rate and level */
+  let resampled = fingerprint(
+    tune.render(sampleRate: 48_000, duration: 10, gain: 0.3),
+    sampleRate: 48_000
+  )
+  var offset: Int32 = -1
+  let rate = AudioFingerprintMatch(
+    original,
+    Int32(original.count),
+    resampled,
+    Int32(resampled.count),
+    &offset
+  )
+  #expect(rate < 0.2)
+  #expect(offset == 0)
+
+  /* The same tune, starting one second later */
+  let late = tune.render(sampleRate: 22_050, duration: 11)
+  let shifted = fingerprint(Array(late[22_050...]), sampleRate: 22_050)
+  #expect(
+    AudioFingerprintMatch(
+      original,
+      Int32(original.count),
+      shifted,
+      Int32(shifted.count),
+      &offset
+    ) < 0.2
+  )
+  #expect(abs(offset - 86) <= 1)
+
+  /* Another tune */
+  let other = fingerprint(
+    Tune(duration: 12, using: &generator).render(
+      sampleRate: 44_100,
+      duration: 10
+    ),
+    sampleRate: 44_100
+  )
+  #expect(
+    AudioFingerprintMatch(
+      original,
+      Int32(original.count),
+      other,
+      Int32(other.count),
+      nil
+    ) > 0.35
+  )
+}
+
+@Test
+func testAudioFingerprintMatchShort() {
+  var generator = SystemRandomNumberGenerator()
+  let a = (0 ..< 200).map { _ in
+    UInt32.random(in: 0 ... .max, using: &generator)
+  }
+
+  /* Shorter than the minimum overlap of 64, either way round */
+  for b in [Array(a[50 ..< 60]), Array(a[50 ..< 113])] {
+    var offset: Int32 = -1
+    #expect(AudioFingerprintMatch(a, 200, b, Int32(b.count), &offset) == 1)
+    #expect(offset == 0)
+    offset = -1
+    #expect(AudioFingerprintMatch(b, Int32(b.count), a, 200, &offset) == 1)
+    #expect(offset == 0)
+  }
+
+  /* Just long enough */
+  let b = Array(a[50 ..< 114])
+  var offset: Int32 = -1
+  #expect(AudioFingerprintMatch(a, 200, b, 64, &offset) == 0)
+  #expect(offset == 50)
+}
+
+@Test
+func testAudioFingerprintCapacity() {
+  let fingerprint = AudioFingerprintCreate(44_100, 1, 10)!
+  defer {
+    AudioFingerprintDestroy(fingerprint)
+  }
+  let silence = [Float32](repeating: 0, count: 44_100)
+  #expect(!AudioFingerprintUpdate(fingerprint, silence, Int64(silence.count)))
+
+  var count: Int32 = 0
+  _ = AudioFingerprintGetSubfingerprints(fingerprint, &count)
+  #expect(count == 10)
+
+  #expect(AudioFingerprintCreate(4_000, 1, 10) == nil)
+  #expect(AudioFingerprintCreate(44_100, 0, 10) == nil)
+}
@@ -0,0 +1,104 @@
+//
+//  BaseTests.swift
+//  core-cloud-wasm
+//
+//  Created by Fang Ling on 2026/10/17.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import CoreCloudWasm
+import CoreCloudWasmTestSupport
+import Testing
+
+@Test
+func testBigEndianArray() {
+  /* Odd and even counts, around the two-at-a-time loop */
+  for count in 0 ..< 10 {
+    let values = (0 ..< count).map({
+      UInt64($0 + 1) &* 0x0123_4567_89AB_CDEF ^ 0xF0E1_D2C3_B4A5_9687
+    })
+    let bytes = values.flatMap({ value in
+      (0 ..< 8).map({ UInt8(truncatingIfNeeded: value >> (56 - 8 * $0)) })
+    })
+
+    /* Bytes at every offset within a vector, integers off 16-byte bounds */
+    for offset in 0 ..< 16 {
+      var source = [UInt8](repeating: 0xA5, count: offset + bytes.count)
+      source.replaceSubrange(offset..., with: bytes)
+      var loaded = [UInt64](repeating: 0, count: count + 2)
+      source.withUnsafeBufferPointer({ source in
+        loaded.withUnsafeMutableBufferPointer({ loaded in
+          UInt64_BigEndianLoadArray(
+            source.baseAddress! + offset,
+            loaded.baseAddress! + 1,
+            Int64(count)
+          )
+        })
+      })
+      #expect(loaded == [0] + values + [0])
+
+      var stored = [UInt8](repeating: 0xA5, count: offset + bytes.count + 8)
+      loaded.withUnsafeBufferPointer({ loaded in
+        stored.withUnsafeMutableBufferPointer({ stored in
+          UInt64_BigEndianStoreArray(
+            loaded.baseAddress! + 1,
+            stored.baseAddress! + offset,
+            Int64(count)
+          )
+        })
+      })
+      #expect(stored[..<offset].allSatisfy({ $0 == 0xA5 }))
+      #expect(Array(stored[offset ..< offset + bytes.count]) == bytes)
+      #expect(stored[(offset + bytes.count)...].allSatisfy({ $0 == 0xA5 }))
+    }
+  }
+}
+
+@Test
+func testVectorLanes() {
+  /* Exact in Float32, so fused and separate rounding agree */
+  let a: [Float32] = [1.5, -2, 0.25, 1_024]
+  let b: [Float32] = [4, 3, -8, 0.5]
+  let c: [Float32] = [0.5, 7, 1, -512]
+  var product = [Float32](repeating: 0, count: 4)
+  TestSupport_Float32x4_MultiplyAdd(a, b, c, &product)
+  #expect(product == (0 ..< 4).map({ a[$0] * b[$0] + c[$0] }))
+
+  let matrix = (0 ..< 16).map({ Float32($0) })
+  var transposed = matrix
+  TestSupport_Float32x4_Transpose4x4(&transposed)
+  #expect(transposed == (0 ..< 16).map({ matrix[$0 % 4 * 4 + $0 / 4] }))
+
+  let lanes = (0 ..< 16).map({ UInt8(0xF0 - $0 * 3) })
+  for indices in [
+    (0 ..< 16).map({ UInt8($0) }),
+    (0 ..< 16).map({ UInt8(15 - $0) }),
+    (0 ..< 16).map({ UInt8($0 * 7 % 16) }),
+    [UInt8](repeating: 9, count: 16)
+  ] {
+    var picked = [UInt8](repeating: 0, count: 16)
+    TestSupport_UInt8x16_Shuffle(lanes, indices, &picked)
+    #expect(picked == indices.map({ lanes[Int($0)] }))
+  }
+
+  let x: [UInt64] = [0x0102_0304_0506_0708, 0x8899_AABB_CCDD_EEFF]
+  let y: [UInt64] = [0xDEAD_BEEF_0BAD_F00D, 0x0000_0000_0000_00FF]
+  var swapped = [UInt64](repeating: 0, count: 2)
+  TestSupport_UInt64x2_ByteSwap(x, &swapped)
+  #expect(swapped == x.map({ $0.byteSwapped }))
+
+  var span = [UInt64](repeating: 0, count: 2)
+  TestSupport_UInt64x2_Span(x, y, &span)
+  #expect(span == [x[1], y[0]])
+}
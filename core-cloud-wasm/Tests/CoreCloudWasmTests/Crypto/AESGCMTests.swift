@@ -0,0 +1,94 @@
+//
+//  AESGCMTests.swift
+//  core-cloud-wasm
+//
+//  Created by Fang Ling on 2026/10/17.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import CoreCloudWasm
+import Crypto
+import Testing
+
+@Test
+func testAESGCM() throws {
+  var generator = SystemRandomNumberGenerator()
+  let overhead = Int(Crypto_AESGCM_NonceSize + Crypto_AESGCM_TagSize)
+
+  for count in [0, 1, 15, 16, 17, 63, 64, 65, 1000, 4 * 1024 * 1024] {
+    let key = (0 ..< 32).map { _ in UInt8.random(in: .min ... .max) }
+    let nonce = (0 ..< 12).map { _ in UInt8.random(in: .min ... .max) }
+    let message = (0 ..< count).map { _ in
+      UInt8(truncatingIfNeeded: generator.next())
+    }
+    let authenticatedData = count % 2 == 0 ? [] : Array(message.prefix(20))
+    let symmetricKey = SymmetricKey(data: key)
+
+    /* Seal with the library, compare with swift-crypto */
+    var combined = [UInt8](repeating: 0, count: count + overhead)
+    Crypto_AESGCM_Seal(
+      key,
+      nonce,
+      message,
+      Int64(count),
+      authenticatedData,
+      Int64(authenticatedData.count),
+      &combined
+    )
+    let expected = try AES.GCM.seal(
+      message,
+      using: symmetricKey,
+      nonce: AES.GCM.Nonce(data: nonce),
+      authenticating: authenticatedData
+    )
+    #expect(combined == Array(expected.combined!))
+
+    /* Open each other's sealed boxes */
+    let opened = try AES.GCM.open(
+      AES.GCM.SealedBox(combined: combined),
+      using: symmetricKey,
+      authenticating: authenticatedData
+    )
+    #expect(Array(opened) == message)
+
+    var plaintext = [UInt8](repeating: 0, count: count + 1)
+    #expect(
+      Crypto_AESGCM_Open(
+        key,
+        Array(expected.combined!),
+        Int64(combined.count),
+        authenticatedData,
+        Int64(authenticatedData.count),
+        &plaintext
+      )
+    )
+    #expect(Array(plaintext.prefix(count)) == message)
+
+    /* Any change to the sealed box must be rejected */
+    for index in [0, Int(Crypto_AESGCM_NonceSize), combined.count - 1] {
+      var tampered = combined
+      tampered[index] ^= 0x80
+      #expect(
+        !Crypto_AESGCM_Open(
+          key,
+          tampered,
+          Int64(tampered.count),
+          authenticatedData,
+          Int64(authenticatedData.count),
+          &plaintext
+        )
+      )
+    }
+  }
+}
@@ -0,0 +1,238 @@
+//
+//  HMACTests.swift
+//  core-cloud-wasm
+//
+//  Created by Fang Ling on 2026/10/17.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import CoreCloudWasm
+import Crypto
+import Foundation
+import Testing
+
+private func randomBytes(_ count: Int) -> [UInt8] {
+  (0 ..< count).map { _ in UInt8.random(in: .min ... .max) }
+}
+
+@Test
+func testHMACSHA512() {
+  /* RFC 4231, test case 2 */
+  var code = [UInt8](repeating: 0, count: 64)
+  let key = Array("Jefe".utf8)
+  let message = Array("what do ya want for nothing?".utf8)
+  Crypto_HMAC_SHA512(
+    key,
+    Int64(key.count),
+    message,
+    Int64(message.count),
+    &code
+  )
+  #expect(
+    code == [
+      0x16, 0x4B, 0x7A, 0x7B, 0xFC, 0xF8, 0x19, 0xE2,
+      0xE3, 0x95, 0xFB, 0xE7, 0x3B, 0x56, 0xE0, 0xA3,
+      0x87, 0xBD, 0x64, 0x22, 0x2E, 0x83, 0x1F, 0xD6,
+      0x10, 0x27, 0x0C, 0xD7, 0xEA, 0x25, 0x05, 0x54,
+      0x97, 0x58, 0xBF, 0x75, 0xC0, 0x5A, 0x99, 0x4A,
+      0x6D, 0x03, 0x4F, 0x65, 0xF8, 0xF0, 0xE6, 0xFD,
+      0xCA, 0xEA, 0xB1, 0xA3, 0x4D, 0x4A, 0x6B, 0x4B,
+      0x63, 0x6E, 0x07, 0x0A, 0x38, 0xBC, 0xE7, 0x37
+    ]
+  )
+
+  for keyCount in [0, 1, 64, 127, 128, 129, 300] {
+    let key = randomBytes(keyCount)
+    let hmacKey = Crypto_HMAC_SHA512_CreateKey(key, Int64(key.count))
+    defer { Crypto_HMAC_SHA512_DestroyKey(hmacKey) }
+
+    /* The same key authenticates many messages */
+    for count in [0, 1, 111, 112, 128, 1000] {
+      let message = randomBytes(count)
+      let expectedCode = Array(
+        HMAC<SHA512>.authenticationCode(
+          for: message,
+          using: SymmetricKey(data: key)
+        )
+      )
+
+      Crypto_HMAC_SHA512_Authenticate(
+        hmacKey,
+        message,
+        Int64(message.count),
+        &code
+      )
+      #expect(code == expectedCode)
+      #expect(
+        Crypto_HMAC_SHA512_Verify(hmacKey, message, Int64(count), code)
+      )
+
+      code[count % 64] ^= 0x01
+      #expect(
+        !Crypto_HMAC_SHA512_Verify(hmacKey, message, Int64(count), code)
+      )
+    }
+  }
+}
+
+@Test
+func testHKDFSHA512() {
+  for count in [0, 1, 32, 64, 65, 200, Int(Crypto_HKDF_SHA512_MaximumCount)] {
+    let inputKeyMaterial = randomBytes(22)
+    let salt = count % 2 == 0 ? [] : randomBytes(13)
+    let info = randomBytes(count % 10)
+
+    let expectedKey = HKDF<SHA512>.deriveKey(
+      inputKeyMaterial: SymmetricKey(data: inputKeyMaterial),
+      salt: salt,
+      info: info,
+      outputByteCount: count
+    )
+
+    var outputKeyMaterial = [UInt8](repeating: 0, count: count + 1)
+    #expect(
+      Crypto_HKDF_SHA512(
+        salt,
+        Int64(salt.count),
+        inputKeyMaterial,
+        Int64(inputKeyMaterial.count),
+        info,
+        Int64(info.count),
+        &outputKeyMaterial,
+        Int64(count)
+      )
+    )
+    #expect(
+      Array(outputKeyMaterial.prefix(count)) ==
+        expectedKey.withUnsafeBytes { Array($0) }
+    )
+
+    /* Extract once, expand per file */
+    var pseudoRandomKey = [UInt8](repeating: 0, count: 64)
+    Crypto_HKDF_SHA512_Extract(
+      salt,
+      Int64(salt.count),
+      inputKeyMaterial,
+      Int64(inputKeyMaterial.count),
+      &pseudoRandomKey
+    )
+    let hmacKey = Crypto_HMAC_SHA512_CreateKey(pseudoRandomKey, 64)
+    defer { Crypto_HMAC_SHA512_DestroyKey(hmacKey) }
+
+    for file in 0 ..< 3 {
+      let fileInfo = Array("file-\(file)".utf8)
+      #expect(
+        Crypto_HKDF_SHA512_Expand(
+          hmacKey,
+          fileInfo,
+          Int64(fileInfo.count),
+          &outputKeyMaterial,
+          Int64(count)
+        )
+      )
+      let expectedFileKey = HKDF<SHA512>.expand(
+        pseudoRandomKey: pseudoRandomKey,
+        info: fileInfo,
+        outputByteCount: count
+      )
+      #expect(
+        Array(outputKeyMaterial.prefix(count)) ==
+          expectedFileKey.withUnsafeBytes { Array($0) }
+      )
+    }
+  }
+
+  var outputKeyMaterial = [UInt8](repeating: 0, count: 1)
+  #expect(
+    !Crypto_HKDF_SHA512(
+      [], 0, [0], 1, [], 0,
+      &outputKeyMaterial,
+      Int64(Crypto_HKDF_SHA512_MaximumCount) + 1
+    )
+  )
+}
+
+@Test
+func testPBKDF2SHA512() {
+  let vectors: [(
+    password: String,
+    salt: String,
+    iterations: Int64,
+    derivedKey: String
+  )] = [
+    (
+      password: "password",
+      salt: "salt",
+      iterations: 1,
+      derivedKey:
+        "867f70cf1ade02cff3752599a3a53dc4af34c7a669815ae5d513554e1c8cf252" +
+        "c02d470a285a0501bad999bfe943c08f050235d7d68b1da55e63f73b60a57fce"
+    ),
+    (
+      password: "password",
+      salt: "salt",
+      iterations: 2,
+      derivedKey:
+        "e1d9c16aa681708a45f5c7c4e215ceb66e011a2e9f0040713f18aefdb866d53c" +
+        "f76cab2868a39b9f7840edce4fef5a82be67335c77a6068e04112754f27ccf4e"
+    ),
+    (
+      password: "password",
+      salt: "salt",
+      iterations: 4096,
+      derivedKey:
+        "d197b1b33db0143e018b12f3d1d1479e6cdebdcc97c5c0f87f6902e072f457b5" +
+        "143f30602641b3d55cd335988cb36b84376060ecd532e039b742a239434af2d5"
+    ),
+    (
+      password: "passwordPASSWORDpassword",
+      salt: "saltSALTsaltSALTsaltSALTsaltSALTsalt",
+      iterations: 4096,
+      derivedKey:
+        "8c0511f4c6e597c6ac6315d8f0362e225f3c501495ba23b868c005174dc4ee71" +
+        "115b59f9e60cd9532fa33e0f75aefe30225c583a186cd82bd4daea9724a3d3b8" +
+        "04f75bdd41494fa324cab24bcc680fb3b96a30cf5d21fac3c2875913919f3399" +
+        "b1d9ce7eb54c95ba49118596cf7465719bbe02c4ecab1b1541298c321d13c6f6" +
+        "d414c28163b051a1d313cec13a76ebdbba624eb2c742a984fcc2c6984f4afbbe" +
+        "4502a9bf78f6b556ba0060b6ce9499116ac91721febedf986f70be18344418e2" +
+        "8a694dcd786f52f1"
+    )
+  ]
+
+  for vector in vectors {
+    let password = Array(vector.password.utf8)
+    let salt = Array(vector.salt.utf8)
+    let count = vector.derivedKey.count / 2
+
+    var derivedKey = [UInt8](repeating: 0, count: count)
+    #expect(
+      Crypto_PBKDF2_SHA512(
+        password,
+        Int64(password.count),
+        salt,
+        Int64(salt.count),
+        vector.iterations,
+        &derivedKey,
+        Int64(count)
+      )
+    )
+    #expect(
+      derivedKey.map { String(format: "%02x", $0) }.joined() ==
+        vector.derivedKey
+    )
+  }
+
+  var derivedKey = [UInt8](repeating: 0, count: 64)
+  #expect(!Crypto_PBKDF2_SHA512([0], 1, [0], 1, 0, &derivedKey, 64))
+}
@@ -18,12 +18,13 @@
 //
 
 import CoreCloudWasm
+import Crypto
 import Foundation
 import Testing
 
 @Test
 func testSHA512() {
-  let contextBuffer = malloc(8 * 10 + 128)
+  let contextBuffer = malloc(Int(Crypto_SHA512_ContextSize()))
   defer { free(contextBuffer) }
 
   let context = OpaquePointer(contextBuffer)
@@ -61,3 +62,232 @@ func testSHA512() {
   )
   #expect(data2.base64EncodedString() == expectedResult2)
 }
+
+@Test
+func testSHA512xN() {
+  let counts = [0, 1, 111, 112, 127, 128, 129, 255, 1000, 4096, 10000]
+  let messages = counts.map { count in
+    (0 ..< count).map { _ in UInt8.random(in: .min ... .max) }
+  }
+
+  /* Single-stream digests */
+  let context = Crypto_SHA512_Create()
+  defer { Crypto_SHA512_Destroy(context) }
+
+  var expectedResults = [[UInt8]]()
+  for message in messages {
+    var digest = [UInt8](repeating: 0, count: 64)
+    Crypto_SHA512_Init(context)
+    Crypto_SHA512_Update(context, message, Int64(message.count))
+    Crypto_SHA512_Finalize(context, &digest)
+    expectedResults.append(digest)
+  }
+
+  /* Multi-buffer digests, fed in two uneven parts */
+  let contexts = messages.map { _ in Crypto_SHA512_Create() }
+  defer { contexts.forEach { Crypto_SHA512_Destroy($0) } }
+
+  let buffers = messages.map { message in
+    let buffer = UnsafeMutablePointer<UInt8>.allocate(
+      capacity: message.count + 1
+    )
+    buffer.initialize(from: message, count: message.count)
+    return buffer
+  }
+  defer { buffers.forEach { $0.deallocate() } }
+
+  let splits = messages.map { $0.count / 3 }
+
+  let heads = buffers.map { UnsafePointer<UInt8>?($0) }
+  let headCounts = splits.map { Int64($0) }
+  Crypto_SHA512xN_Update(contexts, heads, headCounts, Int32(contexts.count))
+
+  let tails = zip(buffers, splits).map { UnsafePointer<UInt8>?($0 + $1) }
+  let tailCounts = zip(messages, splits).map { Int64($0.count - $1) }
+  Crypto_SHA512xN_Update(contexts, tails, tailCounts, Int32(contexts.count))
+
+  for (context, expectedResult) in zip(contexts, expectedResults) {
+    var digest = [UInt8](repeating: 0, count: 64)
+    Crypto_SHA512_Finalize(context, &digest)
+    #expect(digest == expectedResult)
+  }
+}
+
+@Test
+func testSHA512RandomizedCorpus() {
+  let context = Crypto_SHA512_Create()
+  defer { Crypto_SHA512_Destroy(context) }
+
+  let counts = Array(0 ..< 300) + (0 ..< 100).map { _ in
+    Int.random(in: 0 ..< 20000)
+  }
+  for count in counts {
+    let message = (0 ..< count).map { _ in UInt8.random(in: .min ... .max) }
+
+    var digest = [UInt8](repeating: 0, count: 64)
+    Crypto_SHA512_Init(context)
+    Crypto_SHA512_Update(context, message, Int64(message.count))
+    Crypto_SHA512_Finalize(context, &digest)
+
+    #expect(digest == Array(SHA512.hash(data: message)))
+  }
+}
+
+@Test
+func testSHA512Stream() throws {
+  let stream = try #require(Crypto_SHA512_Stream_Create())
+  defer { Crypto_SHA512_Stream_Destroy(stream) }
+
+  let capacity = Int(Crypto_SHA512_Stream_Capacity(stream))
+  #expect(capacity == Int(Crypto_SHA512_StreamCapacity))
+
+  let staging = Crypto_SHA512_Stream_Buffer(stream)!
+  #expect(Int(bitPattern: staging) % 64 == 0)
+
+  let commits = [
+    [],
+    [0],
+    [1, 127, 128, 129],
+    [capacity, capacity, 5],
+    [capacity - 1, 3, capacity - 2],
+    (0 ..< 20).map { _ in Int.random(in: 0 ... 1000) }
+  ]
+  /* The same stream hashes every message in turn. */
+  for counts in commits {
+    var message = [UInt8]()
+    for count in counts {
+      let part = (0 ..< count).map { _ in UInt8.random(in: .min ... .max) }
+      staging.update(from: part, count: count)
+      #expect(Crypto_SHA512_Stream_Commit(stream, Int64(count)))
+      message += part
+    }
+
+    var digest = [UInt8](repeating: 0, count: 64)
+    Crypto_SHA512_Stream_Finalize(stream, &digest)
+    #expect(digest == Array(SHA512.hash(data: message)))
+  }
+}
+
+@Test
+func testSHA512StreamCommitOutOfRange() throws {
+  let stream = try #require(Crypto_SHA512_Stream_Create())
+  defer { Crypto_SHA512_Stream_Destroy(stream) }
+
+  let staging = Crypto_SHA512_Stream_Buffer(stream)!
+  let message = (0 ..< 200).map { _ in UInt8.random(in: .min ... .max) }
+  staging.update(from: message, count: message.count)
+  #expect(Crypto_SHA512_Stream_Commit(stream, Int64(message.count)))
+
+  /* Rejected counts leave the stream as it was. */
+  let capacity = Int64(Crypto_SHA512_StreamCapacity)
+  for count in [-1, -129, capacity + 1, .max, .min] {
+    #expect(!Crypto_SHA512_Stream_Commit(stream, count))
+  }
+
+  var digest = [UInt8](repeating: 0, count: 64)
+  Crypto_SHA512_Stream_Finalize(stream, &digest)
+  #expect(digest == Array(SHA512.hash(data: message)))
+}
+
+@Test
+func testSHA512ExportImport() {
+  let message = (0 ..< 1000).map { _ in UInt8.random(in: .min ... .max) }
+  let expectedResult = Array(SHA512.hash(data: message))
+
+  let context = Crypto_SHA512_Create()
+  let resumed = Crypto_SHA512_Create()
+  defer {
+    Crypto_SHA512_Destroy(context)
+    Crypto_SHA512_Destroy(resumed)
+  }
+
+  var state = [UInt8](repeating: 0, count: Int(Crypto_SHA512_StateSize))
+
+  /* Split and resume at every offset */
+  for split in 0 ... message.count {
+    Crypto_SHA512_Init(context)
+    Crypto_SHA512_Update(context, message, Int64(split))
+    Crypto_SHA512_Export(context, &state)
+
+    #expect(Crypto_SHA512_Import(resumed, state, Int64(state.count)))
+    message.withUnsafeBufferPointer { message in
+      Crypto_SHA512_Update(
+        resumed,
+        message.baseAddress! + split,
+        Int64(message.count - split)
+      )
+    }
+
+    var digest = [UInt8](repeating: 0, count: 64)
+    Crypto_SHA512_Finalize(resumed, &digest)
+    #expect(digest == expectedResult)
+  }
+
+  /* Unknown versions and truncated states are rejected */
+  var unknownVersion = state
+  unknownVersion[7] = 2
+  #expect(
+    !Crypto_SHA512_Import(resumed, unknownVersion, Int64(unknownVersion.count))
+  )
+  #expect(!Crypto_SHA512_Import(resumed, state, Int64(state.count - 1)))
+}
+
+@Test
+func testSHA512Create() {
+  #expect(
+    Crypto_SHA512_ContextSize() % Crypto_SHA512_ContextAlignment() == 0
+  )
+
+  /* More hash functions than a slab holds */
+  let contexts = (0 ..< 300).map { _ in Crypto_SHA512_Create()! }
+  #expect(Set(contexts.map { Int(bitPattern: $0) }).count == contexts.count)
+  for context in contexts {
+    #expect(Int(bitPattern: context) % 64 == 0)
+  }
+
+  for (index, context) in contexts.enumerated() {
+    let message = [UInt8](repeating: UInt8(truncatingIfNeeded: index), count: 5)
+    Crypto_SHA512_Update(context, message, Int64(message.count))
+
+    var digest = [UInt8](repeating: 0, count: 64)
+    Crypto_SHA512_Finalize(context, &digest)
+    #expect(digest == Array(SHA512.hash(data: message)))
+  }
+
+  contexts.forEach { Crypto_SHA512_Destroy($0) }
+}
+
+@Test
+func testSHA512Hash() {
+  let counts = Array(0 ... 130) + [200, 1000, 4096]
+  let messages = counts.map { count in
+    (0 ..< count).map { _ in UInt8.random(in: .min ... .max) }
+  }
+  let expectedResults = messages.map { Array(SHA512.hash(data: $0)) }
+
+  /* One message at a time */
+  for (message, expectedResult) in zip(messages, expectedResults) {
+    var digest = [UInt8](repeating: 0, count: 64)
+    Crypto_SHA512_Hash(message, Int64(message.count), &digest)
+    #expect(digest == expectedResult)
+  }
+
+  /* All messages in one batch */
+  let buffers = messages.map { message in
+    let buffer = UnsafeMutablePointer<UInt8>.allocate(
+      capacity: message.count + 1
+    )
+    buffer.initialize(from: message, count: message.count)
+    return UnsafePointer<UInt8>?(buffer)
+  }
+  defer { buffers.forEach { $0?.deallocate() } }
+
+  var digests = [UInt8](repeating: 0, count: messages.count * 64)
+  Crypto_SHA512xN_Hash(
+    buffers,
+    messages.map { Int64($0.count) },
+    Int32(messages.count),
+    &digests
+  )
+  #expect(digests == expectedResults.flatMap { $0 })
+}
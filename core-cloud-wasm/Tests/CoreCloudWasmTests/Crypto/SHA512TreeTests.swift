@@ -0,0 +1,88 @@
+//
+//  SHA512TreeTests.swift
+//  core-cloud-wasm
+//
+//  Created by Fang Ling on 2026/10/17.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import CoreCloudWasm
+import Crypto
+import Testing
+
+/* RFC 6962 style reference tree over SHA512. */
+private func referenceRoot(of leaves: ArraySlice<[UInt8]>) -> [UInt8] {
+  if leaves.count == 1 {
+    return leaves.first!
+  }
+
+  var split = 1
+  while split * 2 < leaves.count {
+    split *= 2
+  }
+
+  let left = referenceRoot(of: leaves.prefix(split))
+  let right = referenceRoot(of: leaves.dropFirst(split))
+  return Array(SHA512.hash(data: [0x01] + left + right))
+}
+
+@Test
+func testSHA512Tree() {
+  let leafSize = Int(Crypto_SHA512Tree_LeafSize)
+
+  for count in [0, 5, leafSize, leafSize + 1, 3 * leafSize, 5 * leafSize + 7] {
+    let message = (0 ..< count).map {
+      UInt8(truncatingIfNeeded: $0 &* 31 &+ $0 >> 13)
+    }
+
+    let chunks = stride(from: 0, to: count, by: leafSize).map {
+      message[$0 ..< min($0 + leafSize, count)]
+    }
+    let expectedLeaves = chunks.map {
+      Array(SHA512.hash(data: [0x00] + $0))
+    }
+
+    var leaves = [UInt8](repeating: 0, count: chunks.count * 64 + 1)
+    Crypto_SHA512Tree_HashLeaves(message, Int64(count), &leaves)
+    #expect(
+      Array(leaves.prefix(chunks.count * 64)) == expectedLeaves.flatMap { $0 }
+    )
+
+    var root = [UInt8](repeating: 0, count: 64)
+    Crypto_SHA512Tree_Combine(leaves, Int64(chunks.count), &root)
+    if expectedLeaves.isEmpty {
+      #expect(root == Array(SHA512.hash(data: [UInt8]())))
+    } else {
+      #expect(root == referenceRoot(of: expectedLeaves[...]))
+    }
+
+    for (chunk, expectedLeaf) in zip(chunks, expectedLeaves) {
+      let chunk = Array(chunk)
+
+      var leaf = [UInt8](repeating: 0, count: 64)
+      Crypto_SHA512Tree_HashLeaf(chunk, Int64(chunk.count), &leaf)
+      #expect(leaf == expectedLeaf)
+
+      #expect(
+        Crypto_SHA512Tree_VerifyLeaf(chunk, Int64(chunk.count), expectedLeaf)
+      )
+
+      var tamperedLeaf = expectedLeaf
+      tamperedLeaf[63] ^= 0x01
+      #expect(
+        !Crypto_SHA512Tree_VerifyLeaf(chunk, Int64(chunk.count), tamperedLeaf)
+      )
+    }
+  }
+}
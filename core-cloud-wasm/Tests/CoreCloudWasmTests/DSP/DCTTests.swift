@@ -17,34 +17,190 @@
 //  limitations under the License.
 //
 
-import Accelerate
 import CoreCloudWasm
+import Foundation
 import Numerics
 import Testing
 
+/* The definitions of DSPDCTSetup.h, in double precision */
+private func dct(
+  _ input: some Collection<Float32>,
+  type: DSPDCTType = DSPDCTTypeII
+) -> [Float32] {
+  let h = input.map({ Double($0) })
+  let n = h.count
+  /* cos(i * pi / 4n), for i modulo 8n */
+  let cosines = (0 ..< 8 * n).map({ cos(Double($0) * .pi / Double(4 * n)) })
+
+  return (0 ..< n).map({ k in
+    var sum = 0.0
+    for j in 0 ..< n {
+      if type == DSPDCTTypeII {
+        sum += h[j] * cosines[2 * k * (2 * j + 1) % (8 * n)]
+      } else if type == DSPDCTTypeIII {
+        sum += j == 0 ? h[0] / 2 : h[j] * cosines[2 * (2 * k + 1) * j % (8 * n)]
+      } else {
+        sum += h[j] * cosines[(2 * k + 1) * (2 * j + 1) % (8 * n)]
+      }
+    }
+    return Float32(sum)
+  })
+}
+
 @Test
 func testDCT32() {
-  let dct32 = vDSP.DCT(count: 32, transformType: .II)!
   var output = [Float32](repeating: 0, count: 32)
 
   var input = [Float32](repeating: 0, count: 32)
   DSPDCT32Execute(&input, &output)
-  var result = dct32.transform(input)
+  var result = dct(input)
   for i in 0 ..< 32 {
     #expect(output[i].isApproximatelyEqual(to: result[i]))
   }
 
   input = (0 ..< 32).map({ Float32($0) })
   DSPDCT32Execute(&input, &output)
-  result = dct32.transform(input)
+  result = dct(input)
   for i in 0 ..< 32 {
     #expect(output[i].isApproximatelyEqual(to: result[i]))
   }
 
   input = (0 ..< 32).reversed().map({ Float32($0) })
   DSPDCT32Execute(&input, &output)
-  result = dct32.transform(input)
+  result = dct(input)
   for i in 0 ..< 32 {
     #expect(output[i].isApproximatelyEqual(to: result[i]))
   }
 }
+
+@Test
+func testDCTSetup() {
+  let types = [DSPDCTTypeII, DSPDCTTypeIII, DSPDCTTypeIV]
+
+  #expect(DSPDCTCreateSetup(4, DSPDCTTypeII) == nil)
+  #expect(DSPDCTCreateSetup(48, DSPDCTTypeII) == nil)
+  #expect(DSPDCTCreateSetup(8192, DSPDCTTypeII) == nil)
+
+  for type in types {
+    for shift in 4 ... 12 {
+      let count = 1 << shift
+      let setup = DSPDCTCreateSetup(Int32(count), type)!
+      defer {
+        DSPDCTDestroySetup(setup)
+      }
+
+      let input = (0 ..< count).map({ _ in Float32.random(in: -1 ... 1) })
+      var output = [Float32](repeating: 0, count: count)
+      DSPDCTExecute(setup, input, &output)
+      let result = dct(input, type: type)
+
+      let tolerance = result.map({ abs($0) }).max()! * 1e-5
+      for i in 0 ..< count {
+        #expect(
+          output[i].isApproximatelyEqual(
+            to: result[i],
+            absoluteTolerance: tolerance
+          )
+        )
+      }
+    }
+  }
+}
+
+@Test
+func testDCTSetupInitialize() {
+  let types = [DSPDCTTypeII, DSPDCTTypeIII, DSPDCTTypeIV]
+  let input = (0 ..< 4096).map({ _ in Float32.random(in: -1 ... 1) })
+
+  /* Every size and type, each with a new setup */
+  let transform = {
+    types.flatMap { type in
+      (3 ... 12).map { shift in
+        let count = 1 << shift
+        let setup = DSPDCTCreateSetup(Int32(count), type)!
+        defer {
+          DSPDCTDestroySetup(setup)
+        }
+
+        var output = [Float32](repeating: 0, count: count)
+        DSPDCTExecute(setup, input, &output)
+        return output.map(\.bitPattern)
+      }
+    }
+  }
+
+  /* Setups copying the precomputed tables match the ones computing them. */
+  let expectedResults = transform()
+  CoreCloudWasm_Initialize()
+  CoreCloudWasm_Initialize()
+  #expect(transform() == expectedResults)
+}
+
+@Test
+func testDCT32Batch() {
+  /* Strides of a multiple of 256 go through the tiles */
+  let shapes = [0, 1, 4, 7, 8, 1000].map({ ($0, $0 + 3) }) +
+    [(64, 256), (201, 256), (1000, 1024)]
+  for (count, stride) in shapes {
+    let input = (0 ..< 32 * stride).map({ _ in Float32.random(in: -1 ... 1) })
+    var output = [Float32](repeating: 0, count: 32 * stride)
+    DSPDCT32ExecuteBatch(input, &output, Int32(count), Int32(stride))
+
+    var column = [Float32](repeating: 0, count: 32)
+    var result = [Float32](repeating: 0, count: 32)
+    for i in 0 ..< count {
+      for j in 0 ..< 32 {
+        column[j] = input[j * stride + i]
+      }
+      DSPDCT32Execute(&column, &result)
+      /* |H[k]| <= 32, so this is one ulp of the largest possible output */
+      for j in 0 ..< 32 {
+        #expect(
+          output[j * stride + i].isApproximatelyEqual(
+            to: result[j],
+            absoluteTolerance: 32 * .ulpOfOne
+          )
+        )
+      }
+    }
+    /* The padding between rows is left alone */
+    for j in 0 ..< 32 {
+      for i in count ..< stride {
+        #expect(output[j * stride + i] == 0)
+      }
+    }
+  }
+}
+
+@Test
+func testDCT2D32x32() {
+  let input = (0 ..< 32 * 32).map({ _ in Float32.random(in: 0 ... 255) })
+  var output = [Float32](repeating: 0, count: 32 * 32)
+  DSPDCT2D32x32(input, &output)
+
+  /* Rows, then columns */
+  var rows = [Float32](repeating: 0, count: 32 * 32)
+  for y in 0 ..< 32 {
+    rows.replaceSubrange(
+      y * 32 ..< y * 32 + 32,
+      with: dct(input[y * 32 ..< y * 32 + 32])
+    )
+  }
+  var result = [Float32](repeating: 0, count: 32 * 32)
+  for x in 0 ..< 32 {
+    let column = dct((0 ..< 32).map({ rows[$0 * 32 + x] }))
+    for u in 0 ..< 32 {
+      result[u * 32 + x] = column[u]
+    }
+  }
+
+  let tolerance = result.map({ abs($0) }).max()! * 1e-5
+  for i in 0 ..< 32 * 32 {
+    #expect(
+      output[i].isApproximatelyEqual(
+        to: result[i],
+        absoluteTolerance: tolerance
+      )
+    )
+  }
+}
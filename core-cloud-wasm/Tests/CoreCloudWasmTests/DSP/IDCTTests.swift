@@ -0,0 +1,115 @@
+//
+//  IDCTTests.swift
+//  core-cloud-wasm
+//
+//  Created by Fang Ling on 2026/10/17.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import CoreCloudWasm
+import Foundation
+import Testing
+
+/* The n x n lowest frequencies, sampled at the centers of n x n blocks */
+private func idct(
+  _ coefficients: [Int16],
+  _ quantization: [UInt16],
+  size n: Int
+) -> [UInt8] {
+  var samples = [UInt8]()
+  for y in 0 ..< n {
+    for x in 0 ..< n {
+      let ty = 4 * Double(2 * y + 1) / Double(n) - 0.5
+      let tx = 4 * Double(2 * x + 1) / Double(n) - 0.5
+      var sum = 0.0
+      for v in 0 ..< n {
+        for u in 0 ..< n {
+          let cv = v == 0 ? 1 / 2.0.squareRoot() : 1
+          let cu = u == 0 ? 1 / 2.0.squareRoot() : 1
+          sum += cv * cu / 4 *
+            Double(coefficients[v * 8 + u]) *
+            Double(quantization[v * 8 + u]) *
+            cos(Double(v) * (2 * ty + 1) * .pi / 16) *
+            cos(Double(u) * (2 * tx + 1) * .pi / 16)
+        }
+      }
+      samples.append(UInt8(min(max((sum + 128).rounded(), 0), 255)))
+    }
+  }
+  return samples
+}
+
+/* Sparse blocks whose dequantized coefficients stay in [-1024, 1023] */
+private func randomBlock() -> ([Int16], [UInt16]) {
+  let quantization = (0 ..< 64).map({ _ in UInt16.random(in: 1 ... 40) })
+  let limit = Bool.random() ? 300 : 40
+  let coefficients = (0 ..< 64).map({ i in
+    let q = Int(quantization[i])
+    var c = 0
+    if i == 0 {
+      c = Int.random(in: -1_024 / q ... 1_023 / q)
+    } else if Int.random(in: 0 ..< 4) == 0 {
+      c = Int.random(in: -limit ... limit) / (1 + i / 8)
+    }
+    return Int16(min(max(c, -1_024 / q), 1_023 / q))
+  })
+  return (coefficients, quantization)
+}
+
+private func expectClose(_ a: [UInt8], _ b: [UInt8]) {
+  #expect(a.count == b.count)
+  for (x, y) in zip(a, b) {
+    #expect(abs(Int(x) - Int(y)) <= 1)
+  }
+}
+
+@Test
+func testIDCT8x8() {
+  for _ in 0 ..< 500 {
+    let (coefficients, quantization) = randomBlock()
+    let expected = idct(coefficients, quantization, size: 8)
+
+    var output = [UInt8](repeating: 0, count: 64)
+    DSPIDCT8x8(coefficients, quantization, &output, 8)
+    expectClose(output, expected)
+
+    var multipliers = [Float32](repeating: 0, count: 64)
+    DSPIDCTPrepareFloat(quantization, &multipliers)
+    output = [UInt8](repeating: 0, count: 64)
+    DSPIDCT8x8Float(coefficients, multipliers, &output, 8)
+    expectClose(output, expected)
+  }
+}
+
+@Test
+func testIDCTScaled() {
+  for _ in 0 ..< 500 {
+    let (coefficients, quantization) = randomBlock()
+
+    /* With a stride wider than the block, which must be left untouched */
+    var output = [UInt8](repeating: 0xA5, count: 4 * 6)
+    DSPIDCT4x4(coefficients, quantization, &output, 6)
+    let samples4x4 = (0 ..< 4).flatMap({ y in output[y * 6 ..< y * 6 + 4] })
+    expectClose(samples4x4, idct(coefficients, quantization, size: 4))
+    #expect((0 ..< 4).allSatisfy({ y in output[y * 6 + 4] == 0xA5 }))
+
+    output = [UInt8](repeating: 0, count: 2 * 3)
+    DSPIDCT2x2(coefficients, quantization, &output, 3)
+    let samples2x2 = [output[0], output[1], output[3], output[4]]
+    expectClose(samples2x2, idct(coefficients, quantization, size: 2))
+
+    let sample = DSPIDCT1x1(coefficients, quantization)
+    expectClose([sample], idct(coefficients, quantization, size: 1))
+  }
+}
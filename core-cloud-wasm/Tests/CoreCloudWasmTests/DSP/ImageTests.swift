@@ -0,0 +1,94 @@
+//
+//  ImageTests.swift
+//  core-cloud-wasm
+//
+//  Created by Fang Ling on 2026/10/17.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import CoreCloudWasm
+import Testing
+
+@Test
+func testImageReduceLuma() {
+  let formats: [(DSPImagePixelFormat, Int)] = [
+    (DSPImagePixelFormatRGBA8, 4),
+    (DSPImagePixelFormatRGB8, 3),
+    (DSPImagePixelFormatYUV420, 1)
+  ]
+
+  for (format, bytesPerPixel) in formats {
+    for (width, height, padding) in [(32, 32, 0), (101, 67, 5), (640, 480, 0)] {
+      let bytesPerRow = width * bytesPerPixel + padding
+      let pixels = (0 ..< bytesPerRow * height).map({ _ in
+        UInt8.random(in: .min ... .max)
+      })
+
+      for (outputWidth, outputHeight) in [(32, 32), (7, 3), (width, height)] {
+        var output = [Float32](repeating: 0, count: outputWidth * outputHeight)
+        #expect(
+          DSPImageReduceLuma(
+            pixels,
+            Int32(width),
+            Int32(height),
+            Int32(bytesPerRow),
+            format,
+            &output,
+            Int32(outputWidth),
+            Int32(outputHeight)
+          )
+        )
+
+        /* The mean luma of the pixels each output sample covers */
+        for oy in 0 ..< outputHeight {
+          for ox in 0 ..< outputWidth {
+            let top = oy * height / outputHeight
+            let bottom = (oy + 1) * height / outputHeight
+            let left = ox * width / outputWidth
+            let right = (ox + 1) * width / outputWidth
+            var sum = 0
+            for y in top ..< bottom {
+              for x in left ..< right {
+                let p = y * bytesPerRow + x * bytesPerPixel
+                if bytesPerPixel == 1 {
+                  sum += Int(pixels[p]) * 256
+                } else {
+                  sum += 77 * Int(pixels[p]) + 150 * Int(pixels[p + 1]) +
+                    29 * Int(pixels[p + 2])
+                }
+              }
+            }
+            let area = (bottom - top) * (right - left)
+            let expected = Double(sum) / Double(area) / 256
+            #expect(output[oy * outputWidth + ox] == Float32(expected))
+          }
+        }
+      }
+    }
+  }
+
+  /* Only reductions are supported */
+  var output = [Float32](repeating: 0, count: 32 * 32)
+  let pixels = [UInt8](repeating: 0, count: 16 * 16 * 4)
+  #expect(
+    !DSPImageReduceLuma32x32(
+      pixels,
+      16,
+      16,
+      64,
+      DSPImagePixelFormatRGBA8,
+      &output
+    )
+  )
+}
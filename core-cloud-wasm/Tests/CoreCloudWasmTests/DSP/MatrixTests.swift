@@ -17,27 +17,81 @@
 //  limitations under the License.
 //
 
-import Accelerate
 import CoreCloudWasm
 import Testing
 
+/* Transposes a packed row-major matrix */
+private func transpose(
+  _ input: [Float32],
+  rows: Int,
+  columns: Int
+) -> [Float32] {
+  (0 ..< rows * columns).map({ i in input[(i % rows) * columns + i / rows] })
+}
+
 @Test
 func testTransposeMatrix32x32() {
   var output = [Float32](repeating: 0, count: 32 * 32)
-  var result = [Float32](repeating: 0, count: 32 * 32)
 
   var input = [Float32](repeating: 0, count: 32 * 32)
   DSPMatrixTranspose32x32(&input, &output)
-  vDSP_mtrans(&input, 1, &result, 1, 32, 32)
-  #expect(output == result)
+  #expect(output == transpose(input, rows: 32, columns: 32))
 
   input = (0 ..< 32 * 32).map({ Float32($0) })
   DSPMatrixTranspose32x32(&input, &output)
-  vDSP_mtrans(&input, 1, &result, 1, 32, 32)
-  #expect(output == result)
+  #expect(output == transpose(input, rows: 32, columns: 32))
 
   input = (0 ..< 32 * 32).reversed().map({ Float32($0) })
   DSPMatrixTranspose32x32(&input, &output)
-  vDSP_mtrans(&input, 1, &result, 1, 32, 32)
-  #expect(output == result)
+  #expect(output == transpose(input, rows: 32, columns: 32))
+}
+
+@Test
+func testTransposeMatrix() {
+  for rows in [1, 3, 4, 17, 32, 100, 257] {
+    for columns in [1, 5, 8, 16, 33, 64, 130] {
+      let inputStride = columns + rows % 3
+      let outputStride = rows + columns % 2
+      let input = (0 ..< rows * inputStride).map({ Float32($0) })
+      var output = [Float32](repeating: -1, count: columns * outputStride)
+      DSPMatrixTranspose(
+        input,
+        Int32(rows),
+        Int32(columns),
+        Int32(inputStride),
+        &output,
+        Int32(outputStride)
+      )
+
+      var result = [Float32](repeating: -1, count: columns * outputStride)
+      for r in 0 ..< rows {
+        for c in 0 ..< columns {
+          result[c * outputStride + r] = input[r * inputStride + c]
+        }
+      }
+      #expect(output == result)
+    }
+  }
+
+  /* Packed matrices */
+  let input = (0 ..< 48 * 80).map({ Float32($0) })
+  var output = [Float32](repeating: 0, count: 48 * 80)
+  DSPMatrixTranspose(input, 48, 80, 80, &output, 48)
+  #expect(output == transpose(input, rows: 48, columns: 80))
+}
+
+@Test
+func testTransposeMatrixInPlace() {
+  for count in [1, 2, 4, 7, 16, 31, 64, 129] {
+    let stride = count + count % 3
+    var matrix = (0 ..< count * stride).map({ Float32($0) })
+    var result = matrix
+    for r in 0 ..< count {
+      for c in 0 ..< count {
+        result[c * stride + r] = matrix[r * stride + c]
+      }
+    }
+    DSPMatrixTransposeInPlace(&matrix, Int32(count), Int32(stride))
+    #expect(matrix == result)
+  }
 }
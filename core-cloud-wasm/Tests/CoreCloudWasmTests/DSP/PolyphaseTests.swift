@@ -0,0 +1,167 @@
+//
+//  PolyphaseTests.swift
+//  core-cloud-wasm
+//
+//  Created by Fang Ling on 2026/10/17.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import CoreCloudWasm
+import Foundation
+import Numerics
+import Testing
+
+private func polyphaseWindow() -> [Double] {
+  var window = [Float32](repeating: 0, count: 512)
+  DSPPolyphaseGetWindow(&window)
+  return window.map({ Double($0) })
+}
+
+/* ISO/IEC 11172-3, figure A.2, as written */
+private func synthesize(_ subbands: [Float32]) -> [Float32] {
+  let d = polyphaseWindow()
+  var v = [Double](repeating: 0, count: 1024)
+  var samples = [Float32]()
+
+  for frame in stride(from: 0, to: subbands.count, by: 32) {
+    v.replaceSubrange(64 ..< 1024, with: v[0 ..< 960])
+    for i in 0 ..< 64 {
+      v[i] = 0
+      for k in 0 ..< 32 {
+        v[i] += cos(Double((16 + i) * (2 * k + 1)) * .pi / 64) *
+          Double(subbands[frame + k])
+      }
+    }
+    var u = [Double](repeating: 0, count: 512)
+    for i in 0 ..< 8 {
+      for j in 0 ..< 32 {
+        u[i * 64 + j] = v[i * 128 + j]
+        u[i * 64 + 32 + j] = v[i * 128 + 96 + j]
+      }
+    }
+    for j in 0 ..< 32 {
+      var sum = 0.0
+      for i in 0 ..< 16 {
+        sum += u[j + 32 * i] * d[j + 32 * i]
+      }
+      samples.append(Float32(sum))
+    }
+  }
+  return samples
+}
+
+/* ISO/IEC 11172-3, figure C.4, as written */
+private func analyze(_ samples: [Float32]) -> [Float32] {
+  let c = polyphaseWindow().map({ $0 / 32 })
+  var x = [Double](repeating: 0, count: 512)
+  var subbands = [Float32]()
+
+  for frame in stride(from: 0, to: samples.count, by: 32) {
+    x.replaceSubrange(32 ..< 512, with: x[0 ..< 480])
+    for i in 0 ..< 32 {
+      x[31 - i] = Double(samples[frame + i])
+    }
+    var y = [Double](repeating: 0, count: 64)
+    for i in 0 ..< 64 {
+      for j in 0 ..< 8 {
+        y[i] += c[i + 64 * j] * x[i + 64 * j]
+      }
+    }
+    for k in 0 ..< 32 {
+      var sum = 0.0
+      for i in 0 ..< 64 {
+        sum += cos(Double((2 * k + 1) * (i - 16)) * .pi / 64) * y[i]
+      }
+      subbands.append(Float32(sum))
+    }
+  }
+  return subbands
+}
+
+@Test
+func testPolyphaseSynthesis() {
+  let frameCount = 40
+  let subbands = (0 ..< frameCount * 32).map({ _ in
+    Float32.random(in: -1 ... 1)
+  })
+  let result = synthesize(subbands)
+
+  let synthesis = DSPPolyphaseCreateSynthesis()!
+  defer {
+    DSPPolyphaseDestroySynthesis(synthesis)
+  }
+
+  /* In two calls, so that the history carries over */
+  var output = [Float32](repeating: 0, count: subbands.count)
+  DSPPolyphaseSynthesize(synthesis, subbands, &output, 13)
+  subbands.withUnsafeBufferPointer({ input in
+    output.withUnsafeMutableBufferPointer({ samples in
+      DSPPolyphaseSynthesize(
+        synthesis,
+        input.baseAddress! + 13 * 32,
+        samples.baseAddress! + 13 * 32,
+        Int32(frameCount - 13)
+      )
+    })
+  })
+  for i in 0 ..< output.count {
+    #expect(
+      output[i].isApproximatelyEqual(to: result[i], absoluteTolerance: 1e-5)
+    )
+  }
+
+  /* In place, after a reset */
+  DSPPolyphaseResetSynthesis(synthesis)
+  var samples = subbands
+  samples.withUnsafeMutableBufferPointer({ samples in
+    DSPPolyphaseSynthesize(
+      synthesis,
+      samples.baseAddress!,
+      samples.baseAddress!,
+      Int32(frameCount)
+    )
+  })
+  #expect(samples == output)
+}
+
+@Test
+func testPolyphaseReconstruction() {
+  let frameCount = 200
+  let input = (0 ..< frameCount * 32).map({ n -> Float32 in
+    let t = Double(n)
+    let low = 0.5 * sin(t * 0.0123)
+    let middle = 0.3 * sin(t * 1.1 + 1)
+    let high = 0.1 * sin(t * 2.9)
+    return Float32(low + middle + high)
+  })
+  let subbands = analyze(input)
+
+  let synthesis = DSPPolyphaseCreateSynthesis()!
+  defer {
+    DSPPolyphaseDestroySynthesis(synthesis)
+  }
+  var output = [Float32](repeating: 0, count: input.count)
+  DSPPolyphaseSynthesize(synthesis, subbands, &output, Int32(frameCount))
+
+  /* The filterbank pair is near-perfect reconstruction with a delay of 481 */
+  let delay = 481
+  var signal = 0.0
+  var noise = 0.0
+  for n in 1024 ..< input.count {
+    let error = Double(output[n] - input[n - delay])
+    signal += Double(input[n - delay] * input[n - delay])
+    noise += error * error
+  }
+  #expect(10 * log10(signal / noise) > 80)
+}
@@ -0,0 +1,159 @@
+//
+//  ImageHashIndexTests.swift
+//  core-cloud-wasm
+//
+//  Created by Fang Ling on 2026/10/17.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import CoreCloudWasm
+import Testing
+
+/* Random hashes, a tenth of them near-duplicates of earlier ones */
+private func randomHashes(_ count: Int) -> [UInt64] {
+  var hashes = [UInt64]()
+  for i in 0 ..< count {
+    if i > 0 && Int.random(in: 0 ..< 10) == 0 {
+      var hash = hashes.randomElement()!
+      for _ in 0 ..< Int.random(in: 0 ..< 12) {
+        hash ^= 1 << UInt64.random(in: 0 ..< 64)
+      }
+      hashes.append(hash)
+    } else {
+      hashes.append(UInt64.random(in: .min ... .max))
+    }
+  }
+  return hashes
+}
+
+private func search(
+  _ index: OpaquePointer,
+  _ hash: UInt64,
+  _ distance: Int
+) -> [Int: Int] {
+  var matches = [ImageHashMatch](repeating: ImageHashMatch(), count: 16)
+  var count = Int(
+    ImageHashIndexSearch(index, hash, Int32(distance), &matches, 16)
+  )
+  if count > matches.count {
+    matches = [ImageHashMatch](repeating: ImageHashMatch(), count: count)
+    count = Int(ImageHashIndexSearch(
+      index,
+      hash,
+      Int32(distance),
+      &matches,
+      Int64(count)
+    ))
+  }
+
+  var result = [Int: Int]()
+  for match in matches[0 ..< count] {
+    /* Each match is reported once */
+    #expect(result[Int(match.entry)] == nil)
+    result[Int(match.entry)] = Int(match.distance)
+  }
+  return result
+}
+
+private func expectSearches(_ index: OpaquePointer, _ hashes: [UInt64]) {
+  #expect(ImageHashIndexGetCount(index) == hashes.count)
+  for distance in [0, 1, 3, 4, 7, 10, 16, 40] {
+    for _ in 0 ..< 20 {
+      var query = hashes.randomElement()!
+      query ^= 1 << UInt64.random(in: 0 ..< 64)
+      var expected = [Int: Int]()
+      for (entry, hash) in hashes.enumerated() {
+        let d = (hash ^ query).nonzeroBitCount
+        if d <= distance {
+          expected[entry] = d
+        }
+      }
+      #expect(search(index, query, distance) == expected)
+    }
+  }
+}
+
+@Test
+func testImageHashIndexSearch() {
+  for count in [0, 1, 100, 20_000] {
+    let hashes = randomHashes(count)
+    let index = ImageHashIndexCreate(hashes, Int64(count))!
+    defer {
+      ImageHashIndexDestroy(index)
+    }
+    if count > 0 {
+      expectSearches(index, hashes)
+    }
+    #expect(ImageHashIndexSearch(index, 0, -1, nil, 0) == 0)
+  }
+}
+
+@Test
+func testImageHashIndexInsert() {
+  let hashes = randomHashes(20_000)
+  let index = ImageHashIndexCreate(hashes, 5_000)!
+  defer {
+    ImageHashIndexDestroy(index)
+  }
+
+  /* Through several merges, and with some hashes still pending */
+  for entry in 5_000 ..< hashes.count {
+    #expect(ImageHashIndexInsert(index, hashes[entry]) == entry)
+  }
+  expectSearches(index, hashes)
+}
+
+@Test
+func testImageHashIndexBytes() {
+  var hashes = randomHashes(10_000)
+  let index = ImageHashIndexCreate(hashes, 9_000)!
+  defer {
+    ImageHashIndexDestroy(index)
+  }
+  for hash in hashes[9_000...] {
+    ImageHashIndexInsert(index, hash)
+  }
+
+  var count: Int64 = 0
+  let bytes = ImageHashIndexGetBytes(index, &count)!
+  /* 5 substrings, of 13, 13, 13, 13 and 12 bits */
+  #expect(count == 16 + 10_000 * 8 + 10_000 * 4 * 5 + 4 * (4 * 8_193 + 4_097))
+
+  /* A copy, as if it came from the network, searched in place */
+  let copy = UnsafeMutableRawPointer.allocate(
+    byteCount: Int(count),
+    alignment: 8
+  )
+  defer {
+    copy.deallocate()
+  }
+  copy.copyMemory(from: bytes, byteCount: Int(count))
+  let buffer = copy.assumingMemoryBound(to: UInt8.self)
+  let view = ImageHashIndexCreateWithBytes(buffer, count)!
+  expectSearches(view, hashes)
+
+  /* Inserting moves it to a buffer of its own */
+  hashes.append(hashes[0] ^ 1)
+  #expect(ImageHashIndexInsert(view, hashes.last!) == 10_000)
+  expectSearches(view, hashes)
+  ImageHashIndexDestroy(view)
+
+  /* Truncated, with another version, or with an entry out of range */
+  #expect(ImageHashIndexCreateWithBytes(buffer, count - 4) == nil)
+  buffer[7] = 2
+  #expect(ImageHashIndexCreateWithBytes(buffer, count) == nil)
+  buffer[7] = 1
+  (copy + 16 + 10_000 * 8).storeBytes(of: UInt32(10_000), as: UInt32.self)
+  #expect(ImageHashIndexCreateWithBytes(buffer, count) == nil)
+}
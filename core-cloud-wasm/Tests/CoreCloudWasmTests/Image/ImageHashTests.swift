@@ -0,0 +1,49 @@
+//
+//  ImageHashTests.swift
+//  core-cloud-wasm
+//
+//  Created by Fang Ling on 2026/10/17.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import CoreCloudWasm
+import Testing
+
+@Test
+func testImagePerceptualHash64() {
+  /* A smooth picture with some noise */
+  let luma = (0 ..< 32 * 32).map({ i in
+    Float32((i % 32) * 4 + (i / 32) * 3 + Int.random(in: 0 ..< 40))
+  })
+  let hash = ImagePerceptualHash64(luma)
+
+  /* The bits are H[u + 1][v + 1] > median of the 64 coefficients */
+  var block = [Float32](repeating: 0, count: 32 * 32)
+  DSPDCT2D32x32(luma, &block)
+  let coefficients = (0 ..< 64).map({ block[($0 / 8 + 1) * 32 + $0 % 8 + 1] })
+  let sorted = coefficients.sorted()
+  let median = (sorted[31] + sorted[32]) / 2
+  var expected: UInt64 = 0
+  for i in 0 ..< 64 where coefficients[i] > median {
+    expected |= 1 << i
+  }
+  #expect(hash == expected)
+  #expect(hash.nonzeroBitCount == 32)
+
+  /* Small changes move few bits, a different picture moves many */
+  let brighter = luma.map({ $0 / 2 + 64 })
+  #expect((ImagePerceptualHash64(brighter) ^ hash).nonzeroBitCount <= 8)
+  let mirrored = (0 ..< 32 * 32).map({ luma[($0 / 32) * 32 + 31 - $0 % 32] })
+  #expect((ImagePerceptualHash64(mirrored) ^ hash).nonzeroBitCount >= 16)
+}
@@ -0,0 +1,92 @@
+//
+//  MemoryTests.swift
+//  core-cloud-wasm
+//
+//  Created by Fang Ling on 2026/10/17.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import CoreCloudWasm
+import Testing
+
+@Test
+func testMemorySlab() {
+  #expect(Memory_SlabAllocate(0) == nil)
+  #expect(Memory_SlabAllocate(Int64(Memory_SlabMaximumSize) + 1) == nil)
+  Memory_SlabFree(nil)
+
+  /* Every size class, more objects than one slab holds */
+  let counts = (0 ..< 3_000).map { 1 + $0 * 7 % Int(Memory_SlabMaximumSize) }
+  let objects = counts.map { Memory_SlabAllocate(Int64($0))! }
+  #expect(Set(objects.map { Int(bitPattern: $0) }).count == objects.count)
+  for (object, count) in zip(objects, counts) {
+    #expect(Int(bitPattern: object) % 64 == 0)
+    object.initializeMemory(as: UInt8.self, repeating: 0xA5, count: count)
+  }
+  for (object, count) in zip(objects, counts) {
+    let bytes = object.assumingMemoryBound(to: UInt8.self)
+    #expect(bytes[0] == 0xA5 && bytes[count - 1] == 0xA5)
+    Memory_SlabFree(object)
+  }
+}
+
+@Test
+func testMemoryArena() {
+  var statistics = Memory_Statistics()
+  Memory_ArenaDestroy(nil)
+
+  /* The blocks of a finished session are reused by the next one. */
+  var arenaSizes = [Int64]()
+  for session in 0 ..< 8 {
+    let arena = Memory_ArenaCreate()!
+    #expect(Memory_ArenaAllocate(arena, 0) == nil)
+
+    let counts = [Int(Crypto_SHA512_Stream_Size()), 100, 3_000_000 * session]
+    for count in counts where count > 0 {
+      let buffer = Memory_ArenaAllocate(arena, Int64(count))!
+      #expect(Int(bitPattern: buffer) % 64 == 0)
+      buffer.initializeMemory(as: UInt8.self, repeating: 0, count: count)
+    }
+
+    Memory_GetStatistics(&statistics)
+    #expect(statistics.arenaUsedSize >= counts.reduce(0, +))
+    #expect(statistics.arenaSize >= statistics.arenaUsedSize)
+    #expect(statistics.highWaterMark >= statistics.arenaSize)
+
+    Memory_ArenaReset(arena)
+    #expect(Memory_ArenaAllocate(arena, Int64(counts.reduce(0, +))) != nil)
+    Memory_ArenaDestroy(arena)
+
+    if session == 7 {
+      for _ in 0 ..< 4 {
+        let arena = Memory_ArenaCreate()!
+        for count in counts {
+          _ = Memory_ArenaAllocate(arena, Int64(count))
+        }
+        Memory_ArenaDestroy(arena)
+        Memory_GetStatistics(&statistics)
+        arenaSizes.append(statistics.arenaSize)
+      }
+    }
+  }
+  #expect(Set(arenaSizes).count == 1)
+
+  /* A stream takes its staging area from an arena as well. */
+  for _ in 0 ..< 4 {
+    let stream = Crypto_SHA512_Stream_Create()!
+    Crypto_SHA512_Stream_Destroy(stream)
+  }
+  Memory_GetStatistics(&statistics)
+  #expect(statistics.arenaSize == arenaSizes.last)
+}
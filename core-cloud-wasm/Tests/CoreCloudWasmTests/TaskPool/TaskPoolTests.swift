@@ -0,0 +1,113 @@
+//
+//  TaskPoolTests.swift
+//  core-cloud-wasm
+//
+//  Created by Fang Ling on 2026/10/17.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import CoreCloudWasm
+import Testing
+
+/* Runs every entry point that fans out onto the task pool. */
+private func fanOut(
+  message: [UInt8],
+  messages: [[UInt8]],
+  transforms: [Float32]
+) -> [[UInt8]] {
+  let leafSize = Int(Crypto_SHA512Tree_LeafSize)
+  let leafCount = (message.count + leafSize - 1) / leafSize
+  var leaves = [UInt8](repeating: 0, count: leafCount * 64)
+  Crypto_SHA512Tree_HashLeaves(message, Int64(message.count), &leaves)
+
+  let buffers = messages.map { message in
+    let buffer = UnsafeMutablePointer<UInt8>.allocate(
+      capacity: message.count + 1
+    )
+    buffer.initialize(from: message, count: message.count)
+    return UnsafePointer<UInt8>?(buffer)
+  }
+  defer { buffers.forEach { $0?.deallocate() } }
+  var digests = [UInt8](repeating: 0, count: messages.count * 64)
+  Crypto_SHA512xN_Hash(
+    buffers,
+    messages.map { Int64($0.count) },
+    Int32(messages.count),
+    &digests
+  )
+
+  let password = Array("password".utf8)
+  let salt = Array("salt".utf8)
+  var derivedKey = [UInt8](repeating: 0, count: 1_100)
+  _ = Crypto_PBKDF2_SHA512(
+    password,
+    Int64(password.count),
+    salt,
+    Int64(salt.count),
+    10,
+    &derivedKey,
+    Int64(derivedKey.count)
+  )
+
+  /* 1037 transforms of 32 elements, in columns */
+  var output = [Float32](repeating: 0, count: transforms.count)
+  DSPDCT32ExecuteBatch(transforms, &output, 1_037, 1_037)
+  let coefficients = output.flatMap { value in
+    withUnsafeBytes(of: value.bitPattern, { Array($0) })
+  }
+
+  return [leaves, digests, derivedKey, coefficients]
+}
+
+@Test
+func testTaskPool() {
+  let leafSize = Int(Crypto_SHA512Tree_LeafSize)
+  let message = (0 ..< 9 * leafSize + 5).map {
+    UInt8(truncatingIfNeeded: $0 &* 31 &+ $0 >> 13)
+  }
+  let messages = (0 ..< 1_000).map { i in
+    (0 ..< i % 200).map { UInt8(truncatingIfNeeded: $0 &+ i) }
+  }
+  let transforms = (0 ..< 32 * 1_037).map { _ in
+    Float32.random(in: -1 ... 1)
+  }
+
+  /* The calling thread alone */
+  #expect(TaskPoolGetThreadCount() == 1)
+  let expectedResults = fanOut(
+    message: message,
+    messages: messages,
+    transforms: transforms
+  )
+
+  /* Bit-for-bit the same results on any number of threads */
+  for threadCount: Int32 in [2, 3, 8] {
+    #expect(TaskPoolStart(threadCount))
+    #expect(TaskPoolGetThreadCount() == threadCount)
+    #expect(!TaskPoolStart(2))
+
+    let results = fanOut(
+      message: message,
+      messages: messages,
+      transforms: transforms
+    )
+    #expect(results == expectedResults)
+
+    TaskPoolStop()
+    #expect(TaskPoolGetThreadCount() == 1)
+  }
+
+  #expect(!TaskPoolStart(0))
+  #expect(!TaskPoolStart(TaskPoolMaximumThreadCount + 1))
+}
@@ -20,6 +20,28 @@
 import File from "@/models/file"
 
 namespace FileService {
+  /* (module (func (result v128) i32.const 0 i8x16.splat i8x16.popcnt)) */
+  const simdProbe = new Uint8Array([
+    0, 97, 115, 109, 1, 0, 0, 0, 1, 5, 1, 96, 0, 1, 123, 3, 2, 1, 0, 10, 10, 1,
+    8, 0, 65, 0, 253, 15, 253, 98, 11
+  ])
+
+  /* One instance per page load, so that every upload reuses its memory. */
+  let wasmExports: Promise<WebAssembly.Exports> | undefined
+
+  async function instantiateWasm() {
+    const wasmURL = WebAssembly.validate(simdProbe)
+      ? "/CoreCloudWasm.wasm"
+      : "/CoreCloudWasm.nosimd.wasm"
+    /* Compiles while downloading, and lets the browser cache the code. */
+    const { instance: wasmInstance } = await WebAssembly.instantiateStreaming(
+      fetch(wasmURL)
+    )
+    const { CoreCloudWasm_Initialize } = wasmInstance.exports as any
+    CoreCloudWasm_Initialize()
+    return wasmInstance.exports
+  }
+
   export async function fetchFiles(
     request: File.Plural.Input.Retrieval
   ) {
@@ -52,48 +74,65 @@ namespace FileService {
     onSuccess: () => void
   }) {
     /* Load wasm */
-    const wasmResponse = await fetch("/Crypto_SHA512.wasm")
-    const wasmBytes = await wasmResponse.arrayBuffer()
-    const { instance: wasmInstance } = await WebAssembly.instantiate(wasmBytes)
-    const wasm = wasmInstance.exports
+    /* A failed load is not cached, so that the next upload tries again. */
+    wasmExports ??= instantiateWasm().catch((error) => {
+      wasmExports = undefined
+      throw error
+    })
+    const wasm = await wasmExports
 
     /* Compute hash */
     const {
-      Crypto_SHA512_Init,
-      Crypto_SHA512_Update,
-      Crypto_SHA512_Finalize,
-      malloc,
-      memory,
-      free
+      Crypto_SHA512_Stream_Create,
+      Crypto_SHA512_Stream_Destroy,
+      Crypto_SHA512_Stream_Buffer,
+      Crypto_SHA512_Stream_Capacity,
+      Crypto_SHA512_Stream_Commit,
+      Crypto_SHA512_Stream_Finalize,
+      Memory_SlabAllocate,
+      Memory_SlabFree,
+      memory
     } = wasm as any
-    const contextPointer = malloc(8 * 10 + 128)
-    Crypto_SHA512_Init(contextPointer)
 
-    const chunkSize = 4 * 1024 * 1024
-    let offset = 0
-    while (offset < file.size) {
-      const slice = file.slice(offset, offset + chunkSize)
-      const arrayBuffer = await slice.arrayBuffer()
-      const data = new Uint8Array(arrayBuffer)
+    /*
+     * Every upload owns its stream and digest, since another one may start
+     * while this one awaits the next slice.
+     */
+    const streamPointer = Crypto_SHA512_Stream_Create()
+    const digestPointer = Memory_SlabAllocate(BigInt(64))
+    try {
+      if (streamPointer === 0 || digestPointer === 0) {
+        throw new Error("Out of memory")
+      }
+      const stagingPointer = Crypto_SHA512_Stream_Buffer(streamPointer)
 
-      const dataPointer = malloc(data.length)
-      new Uint8Array(memory.buffer, dataPointer, data.length).set(data)
-      Crypto_SHA512_Update(contextPointer, dataPointer, BigInt(data.length))
-      free(dataPointer)
+      /* Slices are written straight into the stream's staging area. */
+      const capacity = Number(Crypto_SHA512_Stream_Capacity(streamPointer))
+      let offset = 0
+      while (offset < file.size) {
+        const slice = file.slice(offset, offset + capacity)
+        const arrayBuffer = await slice.arrayBuffer()
+        const data = new Uint8Array(arrayBuffer)
 
-      offset += chunkSize
-    }
+        new Uint8Array(memory.buffer, stagingPointer, data.length).set(data)
+        if (!Crypto_SHA512_Stream_Commit(streamPointer, BigInt(data.length))) {
+          throw new Error("Slice exceeds the staging area")
+        }
 
-    const digestPointer = malloc(64)
-    Crypto_SHA512_Finalize(contextPointer, digestPointer)
-    const digest = new Uint8Array(memory.buffer, digestPointer, 64)
-    request.checksum = btoa(String.fromCharCode(...digest))
+        offset += capacity
+      }
 
-    free(contextPointer)
-    free(digestPointer)
+      Crypto_SHA512_Stream_Finalize(streamPointer, digestPointer)
+      const digest = new Uint8Array(memory.buffer, digestPointer, 64)
+      request.checksum = btoa(String.fromCharCode(...digest))
+    } finally {
+      Memory_SlabFree(digestPointer)
+      Crypto_SHA512_Stream_Destroy(streamPointer)
+    }
 
     /* Upload */
-    offset = 0
+    const chunkSize = 4 * 1024 * 1024
+    let offset = 0
 
     const webSocket = new WebSocket(
       `${process.env.NEXT_PUBLIC_API_HOST}/ws/file`